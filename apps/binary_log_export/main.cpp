@@ -0,0 +1,169 @@
+/*      File: main.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/binary_log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace phri;
+using namespace std;
+
+void printUsage(const char* program) {
+	cout << "Usage: " << program << " log_file [options] [signal...]\n";
+	cout << "Export the signals of a binary log file to the text layout of the DataLogger (one log_<signal>.txt file per signal).\n";
+	cout << "All the signals are exported if none is given.\n";
+	cout << "Options:\n";
+	cout << "\t--list          List the signals and chunks and exit\n";
+	cout << "\t--recover       Remove the incomplete trailing data of the log file and exit\n";
+	cout << "\t--output dir    Output directory (default: current directory)\n";
+	cout << "\t--from time     Export from the given time\n";
+	cout << "\t--to time       Export up to the given time\n";
+	cout << "\t--gnuplot       Also create the gnuplot files\n";
+}
+
+void writeGnuplotFile(const string& filename, const string& name, size_t size) {
+	auto gnuplot_filename = filename.substr(0, filename.size()-4) + ".gnuplot";
+	ofstream gnuplot_file(gnuplot_filename);
+	gnuplot_file << "plot ";
+	for (size_t i = 0; i < size; ++i) {
+		gnuplot_file << "\"" << filename << "\" using 1:" << i+2 << " title '" << name << (size > 1 ? " " + to_string(i+1) : " ") << "' with lines";
+		gnuplot_file << (i == size-1 ? "\n" : ", ");
+	}
+}
+
+int main(int argc, char const *argv[]) {
+	if(argc < 2) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	const string log_file = argv[1];
+	string output_directory = ".";
+	double from = -numeric_limits<double>::infinity();
+	double to = numeric_limits<double>::infinity();
+	bool gnuplot = false;
+	bool list = false;
+	vector<string> signal_names;
+
+	for (int i = 2; i < argc; ++i) {
+		string arg = argv[i];
+		if(arg == "--list") {
+			list = true;
+		}
+		else if(arg == "--recover") {
+			bool truncated = BinaryLogReader::recover(log_file);
+			cout << (truncated ? "The file has been truncated to its valid part" : "The file is valid") << endl;
+			return 0;
+		}
+		else if(arg == "--gnuplot") {
+			gnuplot = true;
+		}
+		else if(arg == "--output" and i+1 < argc) {
+			output_directory = argv[++i];
+		}
+		else if(arg == "--from" and i+1 < argc) {
+			from = atof(argv[++i]);
+		}
+		else if(arg == "--to" and i+1 < argc) {
+			to = atof(argv[++i]);
+		}
+		else if(arg[0] == '-') {
+			printUsage(argv[0]);
+			return 1;
+		}
+		else {
+			signal_names.push_back(arg);
+		}
+	}
+	if(output_directory.back() != '/') {
+		output_directory.push_back('/');
+	}
+
+	BinaryLogReader reader(log_file);
+
+	if(list) {
+		cout << reader.rowCount() << " rows in " << reader.chunks().size() << " chunks";
+		if(reader.rowCount() > 0) {
+			cout << ", from " << reader.time(0) << "s to " << reader.time(reader.rowCount()-1) << "s";
+		}
+		cout << '\n';
+		if(reader.isTruncated()) {
+			cout << "The file has incomplete trailing data, use --recover to remove it\n";
+		}
+		for(const auto& signal: reader.signals()) {
+			cout << "\t" << signal.name << " (" << signal.size << ")\n";
+		}
+		return 0;
+	}
+
+	vector<size_t> signals;
+	if(signal_names.empty()) {
+		for (size_t i = 0; i < reader.signals().size(); ++i) {
+			signals.push_back(i);
+		}
+	}
+	else {
+		for(const auto& name: signal_names) {
+			int index = reader.signalIndex(name);
+			if(index < 0) {
+				cerr << "There is no signal named " << name << " in " << log_file << endl;
+				return 2;
+			}
+			signals.push_back(index);
+		}
+	}
+
+	const size_t first_row = reader.findRow(from);
+	const size_t last_row = reader.findRow(std::nextafter(to, numeric_limits<double>::infinity()));
+
+	for(auto signal: signals) {
+		const auto& info = reader.signals()[signal];
+		auto name = info.name;
+		std::replace(name.begin(), name.end(), ' ', '_');
+		auto filename = output_directory + "log_" + name + ".txt";
+		ofstream file(filename);
+		if(not file.is_open()) {
+			cerr << "Unable to open the file " << filename << " for writing" << endl;
+			return 3;
+		}
+		file.precision(6);
+		for (size_t row = first_row; row < last_row; ++row) {
+			file << reader.time(row);
+			auto values = reader.signal(row, signal);
+			for (Eigen::Index i = 0; i < values.size(); ++i) {
+				file << '\t' << values(i);
+			}
+			file << '\n';
+		}
+		if(gnuplot) {
+			writeGnuplotFile(filename, info.name, info.size);
+		}
+	}
+
+	cout << "Exported " << signals.size() << " signals (" << last_row - first_row << " rows) to " << output_directory << endl;
+
+	return 0;
+}
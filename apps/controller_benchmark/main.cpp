@@ -105,7 +105,7 @@ int main(int argc, char const *argv[]) {
 	inertia->setIdentity();
 	ManipulatorEquivalentMass mass_eq(inertia, robot->jacobian());
 	mass_eq.add("operator", std::make_shared<Vector6d>(Vector6d::Ones()));
-	safety_controller.add("ec cstr", KineticEnergyConstraint(emax, mass_eq.getEquivalentMass()));
+	safety_controller.add("ec cstr", KineticEnergyConstraint(mass_eq.getEquivalentMass(), emax));
 	runner = [&safety_controller, &mass_eq](){mass_eq.compute(); safety_controller.compute();};
 	run_benchmark();
 
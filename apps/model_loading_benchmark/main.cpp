@@ -0,0 +1,63 @@
+/*      File: main.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/OpenPHRI.h>
+#include <pid/rpath.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+	PID_EXE(argv[0]);
+
+	const string model_path = argc > 1 ? argv[1] : "robot_models/kuka_lwr4.yaml";
+	const string control_point = argc > 2 ? argv[2] : "end-effector";
+	const string cache_directory = "/tmp/open-phri_model_cache";
+	constexpr int Tries = 100;
+
+	auto robot = make_shared<Robot>(
+		"rob",  // Robot's name
+		7);     // Robot's joint count
+
+	// Returns the average construction time in microseconds
+	auto run_benchmark =
+		[&](const string& cache) {
+			auto t_start = chrono::steady_clock::now();
+			for (size_t i = 0; i < Tries; ++i) {
+				RobotModel model(robot, model_path, control_point, cache);
+			}
+			auto t_end = chrono::steady_clock::now();
+			return chrono::duration<double, micro>(t_end - t_start).count() / double(Tries);
+		};
+
+	// Populate the cache
+	RobotModel(robot, model_path, control_point, cache_directory);
+
+	cout << "Loading " << model_path << " " << Tries << " times" << endl;
+	auto parsing_time = run_benchmark("");
+	cout << "Average time without cache (us): " << parsing_time << endl;
+	auto cache_time = run_benchmark(cache_directory);
+	cout << "Average time with cache (us): " << cache_time << endl;
+	cout << "Speedup: " << parsing_time / cache_time << endl;
+
+	return 0;
+}
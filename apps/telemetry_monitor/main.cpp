@@ -0,0 +1,170 @@
+/*      File: main.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/telemetry.h>
+
+#include <signal.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace phri;
+using namespace std;
+
+bool _stop = false;
+
+void sigint_handler(int sig) {
+	_stop = true;
+}
+
+void printUsage(const char* program) {
+	cout << "Usage: " << program << " [options] [signal...]\n";
+	cout << "Print the data published by a TelemetryPublisher. All the signals are printed if none is given.\n";
+	cout << "Options:\n";
+	cout << "\t--name segment  Name of the shared memory segment (default: /openphri)\n";
+	cout << "\t--rate hz       Printing rate (default: 10)\n";
+	cout << "\t--list          List the published signals and exit\n";
+	cout << "\t--once          Print a single snapshot and exit\n";
+}
+
+int main(int argc, char const *argv[]) {
+	string segment = "/openphri";
+	double rate = 10.;
+	bool list = false;
+	bool once = false;
+	vector<string> signal_names;
+
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if(arg == "--list") {
+			list = true;
+		}
+		else if(arg == "--once") {
+			once = true;
+		}
+		else if(arg == "--name" and i+1 < argc) {
+			segment = argv[++i];
+		}
+		else if(arg == "--rate" and i+1 < argc) {
+			rate = atof(argv[++i]);
+		}
+		else if(arg[0] == '-' or rate <= 0.) {
+			printUsage(argv[0]);
+			return 1;
+		}
+		else {
+			signal_names.push_back(arg);
+		}
+	}
+
+	auto reader = make_unique<TelemetryReader>(segment);
+
+	if(list) {
+		for(const auto& signal: reader->signals()) {
+			cout << signal.name << " (" << signal.size << ")\n";
+		}
+		return 0;
+	}
+
+	// The indices change if the segment is replaced by the publisher after a controller reconfiguration
+	vector<size_t> signals;
+	auto find_signals =
+		[&]() {
+			signals.clear();
+			if(signal_names.empty()) {
+				for (size_t i = 0; i < reader->signals().size(); ++i) {
+					signals.push_back(i);
+				}
+				return true;
+			}
+			for(const auto& name: signal_names) {
+				int index = reader->signalIndex(name);
+				if(index < 0) {
+					cerr << "There is no signal named " << name << " in " << segment << endl;
+					return false;
+				}
+				signals.push_back(index);
+			}
+			return true;
+		};
+	if(not find_signals()) {
+		return 2;
+	}
+
+	signal(SIGINT, sigint_handler);
+
+	const auto period = chrono::duration<double>(1. / rate);
+	auto next_print = chrono::steady_clock::now();
+	vector<double> row;
+	uint64_t last_sequence = 0;
+	cout.precision(6);
+	while(not _stop) {
+		if(reader->isReplaced()) {
+			// The new segment might not be created yet, the old one is then read until the next period
+			try {
+				reader = make_unique<TelemetryReader>(segment);
+			}
+			catch(std::exception&) {
+			}
+			if(not reader->isReplaced()) {
+				cout << "[segment replaced]\n";
+				last_sequence = 0;
+				if(not find_signals()) {
+					return 2;
+				}
+			}
+		}
+
+		uint64_t sequence;
+		try {
+			sequence = reader->read(row);
+		}
+		catch(std::exception&) {
+			sequence = last_sequence;
+		}
+		if(sequence == last_sequence) {
+			cout << "[no new data]\n";
+		}
+		else {
+			cout << "t = " << row[0] << "s\n";
+			for(auto signal: signals) {
+				cout << "\t" << reader->signals()[signal].name << ":";
+				auto values = reader->signal(row, signal);
+				for (Eigen::Index i = 0; i < values.size(); ++i) {
+					cout << " " << values(i);
+				}
+				cout << "\n";
+			}
+		}
+		cout << flush;
+		last_sequence = sequence;
+
+		if(once) {
+			break;
+		}
+		next_print += chrono::duration_cast<chrono::steady_clock::duration>(period);
+		this_thread::sleep_until(next_print);
+	}
+
+	return 0;
+}
@@ -0,0 +1,62 @@
+/*      File: main.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/OpenPHRI.h>
+#include <OpenPHRI/drivers/udp_robot_server.h>
+#include <pid/rpath.h>
+
+#include <signal.h>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace phri;
+using namespace std;
+
+bool _stop = false;
+
+void sigint_handler(int sig) {
+	_stop = true;
+}
+
+int main(int argc, char const *argv[]) {
+	PID_EXE(argv[0]);
+
+	const int port = argc > 1 ? atoi(argv[1]) : 47890;
+	const size_t joint_count = argc > 2 ? atoi(argv[2]) : 7;
+	const double sample_time = argc > 3 ? atof(argv[3]) : 0.001;
+	const size_t drop_period = argc > 4 ? atoi(argv[4]) : 0;
+
+	UDPRobotServer server(joint_count, sample_time, port);
+	server.setStateDropPeriod(drop_period);
+
+	signal(SIGINT, sigint_handler);
+
+	cout << "Simulating a " << joint_count << " joints robot on port " << port << " at " << 1. / sample_time << "Hz" << endl;
+	server.start();
+
+	while(not _stop) {
+		this_thread::sleep_for(chrono::seconds(1));
+		cout << "Received commands: " << server.receivedCommands() << ", joint positions: " << server.getJointPosition().transpose() << endl;
+	}
+
+	server.stop();
+
+	return 0;
+}
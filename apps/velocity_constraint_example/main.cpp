@@ -67,8 +67,12 @@ int main(int argc, char const *argv[]) {
 
 	signal(SIGINT, sigint_handler);
 
-	while(init_ok and not _stop) {
-		_stop |= not app.run();
+	if(init_ok) {
+		// Paced by the driver, or on absolute deadlines if it doesn't pace itself. The loop is left as soon as the pre controller code returns false
+		app.runLoop([]{return not _stop;});
+
+		auto statistics = app.getLoopRunner()->getStatistics();
+		std::cout << "Cycles: " << statistics.cycles << ", overruns: " << statistics.overruns << ", max jitter: " << statistics.max_jitter * 1e6 << "us" << std::endl;
 	}
 
 	app.stop();
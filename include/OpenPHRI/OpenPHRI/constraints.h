@@ -36,5 +36,7 @@
 #include <OpenPHRI/constraints/emergency_stop_constraint.h>
 #include <OpenPHRI/constraints/separation_distance_constraint.h>
 #include <OpenPHRI/constraints/joint_velocity_constraint.h>
+#include <OpenPHRI/constraints/joint_position_constraint.h>
 #include <OpenPHRI/constraints/joint_acceleration_constraint.h>
 #include <OpenPHRI/constraints/kinetic_energy_constraint.h>
+#include <OpenPHRI/constraints/collaborative_mode_constraint.h>
@@ -0,0 +1,194 @@
+/*      File: collaborative_mode_constraint.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file collaborative_mode_constraint.h
+ * @author Benjamin Navarro
+ * @brief Definition of the CollaborativeModeConstraint class and related CollaborativeMode and BodyRegion enums
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/constraints/velocity_constraint.h>
+#include <OpenPHRI/utilities/lookup_table.h>
+
+#include <vector>
+
+namespace phri {
+
+/** @enum phri::CollaborativeMode
+ *  @brief The collaborative operation modes defined by ISO 10218 and ISO/TS 15066.
+ */
+enum class CollaborativeMode {
+	SafetyRatedMonitoredStop,       /**< The robot is kept still while the operator is in the collaborative workspace. */
+	HandGuiding,                    /**< The operator moves the robot, at a safety-rated reduced velocity. */
+	SpeedAndSeparationMonitoring,   /**< The velocity is limited so that the robot can stop before reaching the operator. */
+	PowerAndForceLimiting           /**< The velocity is limited so that a transient contact stays below the force limits of the exposed body regions. */
+};
+
+/** @enum phri::BodyRegion
+ *  @brief The body regions of ISO/TS 15066 Annex A.
+ */
+enum class BodyRegion {
+	Skull,
+	Face,
+	Neck,
+	Back,
+	Chest,
+	Abdomen,
+	Pelvis,
+	UpperArm,
+	LowerArm,
+	Hand,
+	Thigh,
+	LowerLeg
+};
+
+/** @brief Biomechanical limits of a body region.
+ */
+struct BodyRegionLimits {
+	double maximum_force;       /**< Maximum permissible quasi-static contact force (N). */
+	double spring_constant;     /**< Effective spring constant (N/m). */
+	double effective_mass;      /**< Effective mass (kg). */
+};
+
+/** @brief Parameters of a CollaborativeModeConstraint.
+ */
+struct CollaborativeModeParameters {
+	double hand_guiding_velocity = 0.25;        /**< Maximum velocity during hand guiding (m/s). */
+	double human_velocity = 1.6;                /**< Maximum velocity of the operator, from ISO 13855 (m/s). */
+	double reaction_time = 0.1;                 /**< Time for the robot to react to the operator's presence (s). */
+	double stopping_time = 0.3;                 /**< Upper bound of the robot stopping time (s). */
+	double maximum_deceleration = 2.5;          /**< Deceleration of the robot when stopping (m/s^2). */
+	double intrusion_distance = 0.1;            /**< Intrusion distance and position uncertainties of the operator and the robot (m). */
+	double maximum_separation_distance = 5.;    /**< Largest separation distance in the speed and separation monitoring table (m). Larger distances use the velocity at this distance. */
+	double transient_contact_factor = 2.;       /**< Ratio between the transient and quasi-static contact force limits. */
+	double minimum_robot_mass = 0.5;            /**< Smallest robot effective mass in the power and force limiting table (kg). Smaller masses use the velocity for this mass. */
+	std::vector<BodyRegion> body_regions;       /**< Body regions exposed to a contact. All the regions if empty. */
+	size_t table_size = 512;                    /**< Number of samples of the lookup tables. */
+};
+
+/** @brief A constraint implementing the four collaborative operation modes of ISO/TS 15066 by limiting the TCP velocity.
+ *  @details The velocity limits of the speed and separation monitoring and of the power and force limiting modes are precomputed into lookup tables,
+ *  so that each cycle only interpolates a table:
+ *  - speed and separation monitoring: the protective separation distance S = v_h*(T_r + T_s) + v_r*T_r + v_r^2/(2*a) + C is solved for the robot velocity v_r,
+ *  - power and force limiting: the permissible transient contact velocity v = k_t*F_max / sqrt(mu*k), with mu = (1/m_H + 1/m_R)^-1 the reduced mass
+ *  (ISO/TS 15066 Annex A), is tabulated as a function of 1/m_R and the minimum over the exposed body regions is taken.
+ *
+ *  Both functions are concave in the table inputs, so the interpolation always underestimates the velocity limit.
+ *  The separation distance can be given by a SeparationDistanceConstraint or a CollisionScene and the robot effective mass by ManipulatorEquivalentMass.
+ */
+class CollaborativeModeConstraint : public VelocityConstraint {
+public:
+	/***		Constructor & destructor		***/
+
+	/**
+	 * @brief Construct a collaborative mode constraint. Throws std::runtime_error if an input required by the mode is missing.
+	 * @param mode The initial operation mode.
+	 * @param separation_distance The distance between the robot and the operator. Required for the speed and separation monitoring mode.
+	 * @param robot_mass The effective mass of the robot. Required for the power and force limiting mode.
+	 * @param parameters The parameters used to build the velocity tables.
+	 */
+	CollaborativeModeConstraint(
+		CollaborativeMode mode,
+		doubleConstPtr separation_distance,
+		doubleConstPtr robot_mass,
+		const CollaborativeModeParameters& parameters = CollaborativeModeParameters());
+
+	virtual ~CollaborativeModeConstraint() = default;
+
+	/***		Algorithm		***/
+	virtual double compute() override;
+
+	/**
+	 * @brief Change the operation mode. Throws std::runtime_error if an input required by the mode is missing.
+	 * @param mode The new mode.
+	 */
+	void setMode(CollaborativeMode mode);
+
+	/**
+	 * @brief The current operation mode.
+	 * @return The mode.
+	 */
+	CollaborativeMode getMode() const;
+
+	/**
+	 * @brief Change the parameters and rebuild the velocity tables. Allocates memory, should not be called from the control loop.
+	 * @param parameters The new parameters.
+	 */
+	void setParameters(const CollaborativeModeParameters& parameters);
+
+	/**
+	 * @brief The parameters used to build the velocity tables.
+	 * @return The parameters.
+	 */
+	const CollaborativeModeParameters& getParameters() const;
+
+	/**
+	 * @brief Retrieve the maximum velocity computed for the current mode.
+	 * @return A shared pointer to the maximum velocity.
+	 */
+	doubleConstPtr getMaximumVelocity() const;
+
+	/**
+	 * @brief The limits given by ISO/TS 15066 Annex A for a body region.
+	 * @param region The body region.
+	 * @return The limits.
+	 */
+	static BodyRegionLimits bodyRegionLimits(BodyRegion region);
+
+	/**
+	 * @brief The maximum robot velocity for a given separation distance in speed and separation monitoring.
+	 * @param parameters The parameters.
+	 * @param separation_distance The separation distance.
+	 * @return The velocity.
+	 */
+	static double separationVelocity(const CollaborativeModeParameters& parameters, double separation_distance);
+
+	/**
+	 * @brief The maximum velocity for a transient contact with a body region in power and force limiting.
+	 * @param limits The body region limits.
+	 * @param robot_mass The effective mass of the robot.
+	 * @param transient_contact_factor Ratio between the transient and quasi-static contact force limits.
+	 * @return The velocity.
+	 */
+	static double contactVelocity(const BodyRegionLimits& limits, double robot_mass, double transient_contact_factor);
+
+private:
+	void checkInputs(CollaborativeMode mode) const;
+	void buildTables();
+
+	CollaborativeMode mode_;
+	doubleConstPtr separation_distance_;
+	doubleConstPtr robot_mass_;
+	CollaborativeModeParameters parameters_;
+
+	LookupTable separation_velocity_table_;
+	LookupTable contact_velocity_table_;
+	doublePtr mode_maximum_velocity_;
+};
+
+using CollaborativeModeConstraintPtr = std::shared_ptr<CollaborativeModeConstraint>;
+using CollaborativeModeConstraintConstPtr = std::shared_ptr<const CollaborativeModeConstraint>;
+
+} // namespace phri
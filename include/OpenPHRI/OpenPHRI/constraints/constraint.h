@@ -58,6 +58,18 @@ public:
 	 */
 	virtual double operator()() final;
 
+	/**
+	 * @brief Write the internal state of the constraint (e.g. filters, hysteresis) to a snapshot. Does nothing by default.
+	 * @param writer The writer to use.
+	 */
+	virtual void saveState(StateWriter& writer) const;
+
+	/**
+	 * @brief Restore a state written by saveState().
+	 * @param reader The reader to use.
+	 */
+	virtual void restoreState(StateReader& reader);
+
 	/**
 	 * @brief Set the robot to work with. Should not be set by the user.
 	 * @param robot The robot.
@@ -68,6 +68,9 @@ public:
 	/***		Algorithm		***/
 	virtual double compute() override;
 
+	virtual void saveState(StateWriter& writer) const override;
+	virtual void restoreState(StateReader& reader) override;
+
 private:
 	doubleConstPtr activation_force_threshold_;
 	doubleConstPtr deactivation_force_threshold_;
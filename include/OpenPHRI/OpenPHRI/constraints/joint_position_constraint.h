@@ -0,0 +1,69 @@
+/*      File: joint_position_constraint.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file joint_position_constraint.h
+ * @author Benjamin Navarro
+ * @brief Definition of the JointPositionConstraint class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/constraints/constraint.h>
+#include <OpenPHRI/utilities/joint_limits.h>
+
+namespace phri {
+
+/** @brief A constraint to keep the joints inside their position limits.
+ *  @details The joint velocities are scaled so that no joint goes past one of its limits during the next sample period.
+ */
+class JointPositionConstraint : public Constraint {
+public:
+	/***		Constructor & destructor		***/
+
+	/**
+	 * @brief Construct a joint position constraint with the given limits.
+	 * @param limits A shared pointer to the joint limits. Only the position limits are used.
+	 * @param sample_time The time step used to predict the next joint positions.
+	 */
+	JointPositionConstraint(
+		JointLimitsConstPtr limits,
+		double sample_time);
+
+	virtual ~JointPositionConstraint() = default;
+
+	/***		Algorithm		***/
+	virtual double compute() override;
+
+private:
+	JointLimitsConstPtr limits_;
+	double sample_time_;
+
+	VectorXd lower_distance_;
+	VectorXd upper_distance_;
+};
+
+using JointPositionConstraintPtr = std::shared_ptr<JointPositionConstraint>;
+using JointPositionConstraintConstPtr = std::shared_ptr<const JointPositionConstraint>;
+
+} // namespace phri
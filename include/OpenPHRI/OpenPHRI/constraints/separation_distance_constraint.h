@@ -32,6 +32,8 @@
 #include <OpenPHRI/constraints/constraint.h>
 #include <OpenPHRI/utilities/interpolator.h>
 #include <OpenPHRI/utilities/object_collection.hpp>
+#include <OpenPHRI/utilities/point_cloud.h>
+#include <OpenPHRI/utilities/robot_geometry.h>
 #include <map>
 
 namespace phri {
@@ -77,6 +79,19 @@ public:
 	 */
 	doubleConstPtr getSeparationDistance() const;
 
+	/**
+	 * @brief Set a point cloud whose points are considered as objects. The points must be expressed in the same frame as the objects.
+	 * @param point_cloud The point cloud. nullptr to remove the current one.
+	 */
+	void setPointCloud(PointCloudConstPtr point_cloud);
+
+	/**
+	 * @brief Use a capsule approximation of the robot links instead of the robot position to compute the separation distance.
+	 * The objects (and point cloud) positions must then be expressed in the same frame as the link positions, usually the base frame.
+	 * @param robot_geometry The robot geometry. nullptr to use the robot position again.
+	 */
+	void setRobotGeometry(RobotGeometryPtr robot_geometry);
+
 private:
 	double closestObjectDistance();
 
@@ -84,6 +99,9 @@ private:
 	InterpolatorPtr interpolator_;
 	Vector6dConstPtr robot_position_;
 	doublePtr separation_distance_;
+	PointCloudConstPtr point_cloud_;
+	RobotGeometryPtr robot_geometry_;
+	Matrix3Xd object_positions_;
 };
 
 using SeparationDistanceConstraintPtr = std::shared_ptr<SeparationDistanceConstraint>;
@@ -0,0 +1,207 @@
+/*      File: async_driver.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file async_driver.h
+ * @author Benjamin Navarro
+ * @brief Definition of the AsyncDriver class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/robot.h>
+#include <OpenPHRI/fwd_decl.h>
+#include <OpenPHRI/drivers/driver.h>
+#include <OpenPHRI/utilities/spsc_queue.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace phri {
+
+/** @brief Run any driver on a dedicated I/O thread.
+ *  @details The wrapped driver operates on its own robot. Each I/O cycle it syncs (unless the driver is self paced), reads the robot state,
+ *  pushes it to the control loop, applies the latest command received from the control loop and sends it.
+ *  Measurements and commands are exchanged through lock-free SPSC queues so that the communication latency
+ *  is hidden behind the control loop computations.
+ *  read() waits for a fresh measurement, making the control loop run at the driver rate.
+ */
+class AsyncDriver : public Driver {
+public:
+	/**
+	 * @brief Construct an asynchronous driver.
+	 * @param robot The robot used by the control loop.
+	 * @param driver The driver to run on the I/O thread. Must have been constructed with driver_robot.
+	 * @param driver_robot The robot used by the wrapped driver. Must have the same joint count as robot.
+	 * @param queue_size The number of measurements and commands that can be buffered.
+	 */
+	AsyncDriver(
+		RobotPtr robot,
+		DriverPtr driver,
+		RobotPtr driver_robot,
+		size_t queue_size = 4);
+
+	virtual ~AsyncDriver();
+
+	/**
+	 * @brief Initialize the wrapped driver and launch the I/O thread. A running I/O thread is stopped first.
+	 * @param timeout The maximum time to wait to establish the connection.
+	 * @return true on success, false otherwise
+	 */
+	virtual bool init(double timeout = 30.) override;
+
+	virtual bool start(double timeout = 30.) override;
+
+	/**
+	 * @brief Stop the I/O thread and the wrapped driver.
+	 * @return true on success, false otherwise
+	 */
+	virtual bool stop() override;
+
+	/**
+	 * @brief Wait for a fresh measurement and update the robot with it. Older measurements are discarded.
+	 * @return true if a valid measurement has been received within ten sample periods, false otherwise
+	 */
+	virtual bool read() override;
+
+	/**
+	 * @brief Push the robot commands to the I/O thread.
+	 * @return false if the wrapped driver failed during the last I/O cycle, true otherwise
+	 */
+	virtual bool send() override;
+
+	/**
+	 * @brief The capabilities of the wrapped driver.
+	 * @return The driver capabilities.
+	 */
+	virtual DriverCapabilities capabilities() const override;
+
+	/**
+	 * @brief Number of measurements dropped because the queue was full (control loop too slow).
+	 * @return The count.
+	 */
+	uint64_t measurementOverruns() const;
+
+	/**
+	 * @brief Number of commands dropped because the queue was full (I/O thread too slow).
+	 * @return The count.
+	 */
+	uint64_t commandOverruns() const;
+
+	/**
+	 * @brief Number of I/O cycles during which no new command was available, the previous one being sent again.
+	 * @return The count.
+	 */
+	uint64_t lateCommands() const;
+
+	/**
+	 * @brief Number of I/O cycles during which the wrapped driver failed to sync, read or send.
+	 * @return The count.
+	 */
+	uint64_t driverErrors() const;
+
+	/**
+	 * @brief Time elapsed between the call to send() and the transmission by the I/O thread of the last command.
+	 * @return The age in seconds.
+	 */
+	double commandAge() const;
+
+	/**
+	 * @brief Time elapsed between the acquisition of the last measurement and its use by read().
+	 * @return The age in seconds.
+	 */
+	double measurementAge() const;
+
+	/**
+	 * @brief The wrapped driver.
+	 * @return A shared pointer to the driver.
+	 */
+	DriverPtr getDriver() const;
+
+private:
+	using time_point = std::chrono::steady_clock::time_point;
+
+	struct Measurement {
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+		time_point timestamp;
+		bool valid;
+		VectorXd joint_current_position;
+		// Drivers such as VREPDriver integrate the commands into the target position
+		VectorXd joint_target_position;
+		VectorXd joint_external_torque;
+		Pose control_point_current_pose;
+		Twist control_point_current_velocity;
+		Acceleration control_point_current_acceleration;
+		Vector6d control_point_external_force;
+		// Only transferred if the wrapped driver provides the kinematics
+		MatrixXd jacobian;
+		Matrix4d transformation_matrix;
+		Matrix6d spatial_transformation_matrix;
+	};
+
+	struct Command {
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+		time_point timestamp;
+		VectorXd joint_velocity;
+		Twist control_point_velocity;
+	};
+
+	void ioLoop();
+
+	Measurement initialMeasurement(const Robot& robot) const;
+	static Command initialCommand(const Robot& robot);
+	void copyMeasurement(const Robot& from, Measurement& to) const;
+	void copyMeasurement(const Measurement& from, Robot& to) const;
+	static void copyCommand(const Robot& from, Command& to);
+	static void copyCommand(const Command& from, Robot& to);
+
+	DriverPtr driver_;
+	RobotPtr driver_robot_;
+	bool transfer_kinematics_;
+
+	SPSCQueue<Measurement> measurements_;
+	SPSCQueue<Command> commands_;
+	// Owned by the control loop
+	Measurement measurement_;
+	Command command_;
+	// Owned by the I/O thread
+	Measurement io_measurement_;
+	Command io_command_;
+
+	std::thread io_thread_;
+	std::atomic<bool> running_;
+	std::atomic<bool> last_send_ok_;
+	std::atomic<uint64_t> measurement_overruns_;
+	std::atomic<uint64_t> command_overruns_;
+	std::atomic<uint64_t> late_commands_;
+	std::atomic<uint64_t> driver_errors_;
+	std::atomic<double> command_age_;
+};
+
+using AsyncDriverPtr = std::shared_ptr<AsyncDriver>;
+using AsyncDriverConstPtr = std::shared_ptr<const AsyncDriver>;
+
+}
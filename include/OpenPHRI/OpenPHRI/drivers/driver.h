@@ -7,6 +7,23 @@
 
 namespace phri {
 
+/** @brief Describe what a driver provides, so that redundant computations can be avoided.
+ */
+struct DriverCapabilities {
+	/** The joint positions are read from the robot */
+	bool joint_position = true;
+	/** The control point external force is read from the robot */
+	bool external_force = false;
+	/** The control point velocity is read from the robot */
+	bool control_point_velocity = false;
+	/** The control point pose, the Jacobian and the transformation matrices are updated on read, making the model forward kinematics unnecessary */
+	bool kinematics = false;
+	/** The robot is stepped in lock with the control loop */
+	bool synchronous = false;
+	/** read() waits for the next sample (stepping the simulation or waiting for the robot state), so the driver paces the loop itself and sync() must not be called */
+	bool self_paced = false;
+};
+
 class Driver {
 public:
 	Driver(
@@ -51,6 +68,12 @@ public:
 
 	virtual double getSampleTime() const final;
 
+	/**
+	 * @brief Describe what the driver provides. The default implementation only reports the joint positions.
+	 * @return The driver capabilities.
+	 */
+	virtual DriverCapabilities capabilities() const;
+
 protected:
 	RobotPtr robot_;
 	double sample_time_;
@@ -85,8 +108,18 @@ public:
 		return false;
 	}
 
+	/**
+	 * @brief Create a driver by name. If no driver is registered with this name, a plugin is loaded using loadPlugin.
+	 * @param name The name of the driver.
+	 * @param robot The robot to pass to the driver.
+	 * @param configuration The configuration to pass to the driver.
+	 * @return The driver on success, nullptr otherwise.
+	 */
 	static std::shared_ptr<Driver> create(std::string name, const RobotPtr& robot, const YAML::Node& configuration) {
 		auto it = createMethods().find(name);
+		if (it == createMethods().end() and loadPlugin(name, configuration)) {
+			it = createMethods().find(name);
+		}
 		if (it != createMethods().end()) {
 			return it->second(robot, configuration);
 		}
@@ -94,6 +127,16 @@ public:
 		return nullptr;
 	}
 
+	/**
+	 * @brief Load a driver plugin, the drivers it contains registering themselves in the factory.
+	 * @details The library given by the 'plugin' field of the driver configuration is used if present.
+	 * Otherwise libopen-phri-<name>-driver.so, then libopen-phri-<name>-driver-dbg.so, are searched in the library path.
+	 * @param name The name of the driver.
+	 * @param configuration The configuration, possibly containing a 'driver: plugin' field.
+	 * @return True if a library has been loaded, false otherwise.
+	 */
+	static bool loadPlugin(const std::string& name, const YAML::Node& configuration);
+
 private:
 	static std::map<std::string, create_method_t>& createMethods() {
 		static std::map<std::string, create_method_t> create_methods;
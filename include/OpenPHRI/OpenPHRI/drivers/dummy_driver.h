@@ -34,6 +34,8 @@
 #include <OpenPHRI/fwd_decl.h>
 #include <OpenPHRI/drivers/driver.h>
 
+#include <chrono>
+
 namespace phri {
 
 /** @brief A dummy driver that set its current joint state with the last command received
@@ -63,11 +65,19 @@ public:
 	virtual bool start(double timeout = 0.) override;
 	virtual bool stop() override;
 
+	/**
+	 * @brief Wait for the next period.
+	 * @details The periods are computed from absolute deadlines so that the time spent between two calls doesn't make the loop drift.
+	 * @return True.
+	 */
 	virtual bool sync() override;
 	virtual bool read() override;
 	virtual bool send() override;
 
 private:
+	std::chrono::steady_clock::time_point next_sync_time_;
+	bool first_sync_;
+
 	static bool registered_in_factory;
 };
 
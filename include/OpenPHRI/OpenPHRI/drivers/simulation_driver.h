@@ -0,0 +1,157 @@
+/*      File: simulation_driver.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file simulation_driver.h
+ * @author Benjamin Navarro
+ * @brief Definition of the SimulationDriver class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/robot.h>
+#include <OpenPHRI/fwd_decl.h>
+#include <OpenPHRI/drivers/driver.h>
+#include <OpenPHRI/utilities/robot_model.h>
+
+#include <chrono>
+#include <vector>
+
+namespace phri {
+
+/** @brief A deterministic kinematic simulation of the robot.
+ *  @details The joint velocity commands are integrated into the joint positions and, if a model is given, the forward kinematics is
+ *  computed on each read. External forces are synthesized from scripted contacts (constant wrenches applied during a time window) and from
+ *  spring walls pushing the control point back when it goes through them.
+ *  In free run mode read() does not wait for the next period so that long simulations can be run as fast as possible.
+ */
+class SimulationDriver : virtual public phri::Driver {
+public:
+	/**
+	 * @brief Construct a simulation driver.
+	 * @param robot The robot to read/write data from/to.
+	 * @param sample_time The sample time to use.
+	 * @param model The model used to compute the forward kinematics and to enforce the joint limits. Can be null, in which case the control point pose used by the walls is not updated.
+	 * @param free_run If true, read() does not wait for the next period.
+	 */
+	SimulationDriver(
+		phri::RobotPtr robot,
+		double sample_time,
+		RobotModelPtr model = nullptr,
+		bool free_run = false);
+
+	/**
+	* @brief Construct a driver using a specific robot and a YAML configuration node.
+	* @details The 'driver' section must provide a 'sample_time' field and can provide 'init_joint_positions' (degrees), 'free_run', 'contacts'
+	* (list of 'start', 'end' and 'wrench') and 'walls' (list of 'point', 'normal' and 'stiffness') fields. A model is created if the configuration has a 'model' section.
+	* @param robot The robot to read/write data from/to.
+	* @param configuration The YAML configuration node.
+	*/
+	SimulationDriver(
+		const phri::RobotPtr& robot,
+		const YAML::Node& configuration);
+
+	virtual ~SimulationDriver();
+
+	virtual bool start(double timeout = 0.) override;
+	virtual bool stop() override;
+
+	/**
+	 * @brief Wait for the next period (except in free run mode), compute the forward kinematics and the external force.
+	 * @return true
+	 */
+	virtual bool read() override;
+
+	/**
+	 * @brief Integrate the joint velocity and advance the simulated time.
+	 * @return true
+	 */
+	virtual bool send() override;
+
+	/**
+	 * @brief The kinematics is provided only if a model is given.
+	 * @return The driver capabilities.
+	 */
+	virtual DriverCapabilities capabilities() const override;
+
+	/**
+	 * @brief Apply a constant wrench on the control point during a time window.
+	 * @param start_time The simulated time at which the contact begins.
+	 * @param end_time The simulated time at which the contact ends.
+	 * @param wrench The wrench, expressed in the base frame.
+	 */
+	void addContact(double start_time, double end_time, const Vector6d& wrench);
+
+	/**
+	 * @brief Add a wall pushing the control point back when it goes through it.
+	 * @param point A point on the wall, in the base frame.
+	 * @param normal The wall normal, pointing to the free side.
+	 * @param stiffness The wall stiffness (N/m).
+	 */
+	void addWall(const Vector3d& point, const Vector3d& normal, double stiffness);
+
+	/**
+	 * @brief Enable or disable the free run mode.
+	 * @param state True to run as fast as possible, false to run in real time.
+	 */
+	void setFreeRun(bool state);
+
+	/**
+	 * @brief The simulated time, incremented by the sample time at each send().
+	 * @return A shared pointer to the time, usable with the DataLogger.
+	 */
+	doubleConstPtr getTime() const;
+
+private:
+	struct Contact {
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+		double start_time;
+		double end_time;
+		Vector6d wrench;
+	};
+
+	struct Wall {
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+		Vector3d point;
+		Vector3d normal;
+		double stiffness;
+	};
+
+	void computeExternalForce();
+
+	RobotModelPtr model_;
+	bool free_run_;
+	doublePtr time_;
+	std::chrono::steady_clock::time_point next_cycle_;
+	std::vector<Contact, Eigen::aligned_allocator<Contact>> contacts_;
+	std::vector<Wall, Eigen::aligned_allocator<Wall>> walls_;
+
+	static bool registered_in_factory;
+};
+
+using SimulationDriverPtr = std::shared_ptr<SimulationDriver>;
+using SimulationDriverConstPtr = std::shared_ptr<const SimulationDriver>;
+
+}
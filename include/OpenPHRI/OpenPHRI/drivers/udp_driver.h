@@ -0,0 +1,140 @@
+/*      File: udp_driver.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file udp_driver.h
+ * @author Benjamin Navarro
+ * @brief Definition of the UDPDriver class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/robot.h>
+#include <OpenPHRI/fwd_decl.h>
+#include <OpenPHRI/drivers/driver.h>
+#include <OpenPHRI/drivers/udp_protocol.h>
+
+#include <array>
+#include <chrono>
+#include <string>
+
+namespace phri {
+
+/** @brief A driver communicating with a robot server over UDP.
+ *  @details The server periodically sends the robot state (joint positions and control point wrench) and receives the joint velocity commands.
+ *  The packets layout is defined in udp_protocol.h. Lost, out of order and invalid packets are detected using the sequence numbers and headers.
+ *  UDPRobotServer can be used as a loopback stand-in for a real robot.
+ */
+class UDPDriver : virtual public phri::Driver {
+public:
+	/** @brief Communication statistics.
+	 */
+	struct Statistics {
+		uint64_t sent_packets = 0;
+		uint64_t received_packets = 0;
+		/** State packets never received, based on the sequence numbers */
+		uint64_t lost_packets = 0;
+		/** State packets older than the last one received, discarded */
+		uint64_t out_of_order_packets = 0;
+		/** Packets with a wrong size or header, discarded */
+		uint64_t invalid_packets = 0;
+		/** Calls to read() without any new state received */
+		uint64_t timeouts = 0;
+		/** Time between the emission of a command and the reception of the state acknowledging it, in seconds */
+		double round_trip_time = 0.;
+	};
+
+	/**
+	 * @brief Construct a UDP driver.
+	 * @param robot The robot to read/write data from/to.
+	 * @param sample_time The sample time to use.
+	 * @param server_ip The IP address of the robot server.
+	 * @param server_port The port of the robot server.
+	 * @param local_port The local port to use. 0 to let the system choose one.
+	 * @param read_timeout The maximum time to wait for a state in read(). Negative values mean ten sample times.
+	 */
+	UDPDriver(
+		phri::RobotPtr robot,
+		double sample_time,
+		const std::string& server_ip,
+		int server_port,
+		int local_port = 0,
+		double read_timeout = -1.);
+
+	/**
+	* @brief Construct a driver using a specific robot and a YAML configuration node.
+	* @details The 'driver' section must provide the 'sample_time', 'ip' and 'port' fields and can provide 'local_port' and 'read_timeout' fields.
+	* @param robot The robot to read/write data from/to.
+	* @param configuration The YAML configuration node.
+	*/
+	UDPDriver(
+		const phri::RobotPtr& robot,
+		const YAML::Node& configuration);
+
+	virtual ~UDPDriver();
+
+	virtual bool start(double timeout = 30.) override;
+	virtual bool stop() override;
+
+	/**
+	 * @brief Wait for the next state and update the robot with it. If several states are available, only the most recent one is used.
+	 * @return True if a new state has been received before the read timeout, false otherwise.
+	 */
+	virtual bool read() override;
+
+	/**
+	 * @brief Send the joint velocity command.
+	 * @return True on success, false otherwise.
+	 */
+	virtual bool send() override;
+
+	virtual DriverCapabilities capabilities() const override;
+
+	/**
+	 * @brief The communication statistics.
+	 * @return A const reference to the statistics.
+	 */
+	const Statistics& statistics() const;
+
+private:
+	void open(const std::string& server_ip, int server_port, int local_port);
+	bool receiveState(int timeout_ms);
+
+	int socket_;
+	double read_timeout_;
+	Statistics statistics_;
+	uint32_t command_sequence_;
+	uint32_t state_sequence_;
+	bool state_received_;
+	UDPStatePacket state_packet_;
+	UDPCommandPacket command_packet_;
+	// Emission time of the last commands, indexed by sequence number, to compute the round trip time
+	std::array<std::chrono::steady_clock::time_point, 64> command_times_;
+
+	static bool registered_in_factory;
+};
+
+using UDPDriverPtr = std::shared_ptr<UDPDriver>;
+using UDPDriverConstPtr = std::shared_ptr<const UDPDriver>;
+
+}
@@ -0,0 +1,100 @@
+/*      File: udp_protocol.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file udp_protocol.h
+ * @author Benjamin Navarro
+ * @brief Definition of the packets exchanged by the UDPDriver and the robot servers
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace phri {
+
+/** The packets start with this value ('PHRI' in ASCII) */
+constexpr uint32_t udp_protocol_magic = 0x49524850;
+constexpr uint16_t udp_protocol_version = 1;
+/** All the packets have room for this many joints, only the first joint_count values are meaningful */
+constexpr size_t udp_max_joint_count = 16;
+
+enum class UDPPacketType : uint16_t {
+	State = 1,
+	Command = 2
+};
+
+/** @brief Common header of all the packets.
+ *  @details All the fields are in the host byte order (little endian on all supported platforms).
+ */
+struct UDPPacketHeader {
+	uint32_t magic;
+	uint16_t version;
+	UDPPacketType type;
+	/** Incremented by the sender for each packet */
+	uint32_t sequence;
+	/** Sequence number of the last packet received from the other side */
+	uint32_t acknowledge;
+	/** Sender time, in nanoseconds */
+	uint64_t timestamp;
+	uint32_t joint_count;
+	uint32_t reserved;
+};
+
+/** @brief Robot state, sent by the robot server.
+ */
+struct UDPStatePacket {
+	UDPPacketHeader header;
+	double joint_position[udp_max_joint_count];
+	/** Control point wrench in the control point frame */
+	double external_force[6];
+};
+
+/** @brief Robot command, sent by the driver.
+ */
+struct UDPCommandPacket {
+	UDPPacketHeader header;
+	double joint_velocity[udp_max_joint_count];
+};
+
+static_assert(sizeof(UDPPacketHeader) == 32, "Unexpected padding in UDPPacketHeader");
+static_assert(sizeof(UDPStatePacket) == sizeof(UDPPacketHeader) + (udp_max_joint_count + 6) * sizeof(double), "Unexpected padding in UDPStatePacket");
+static_assert(sizeof(UDPCommandPacket) == sizeof(UDPPacketHeader) + udp_max_joint_count * sizeof(double), "Unexpected padding in UDPCommandPacket");
+
+/**
+ * @brief Check that a received packet has the expected size and header.
+ * @param header The packet header.
+ * @param size The number of bytes received.
+ * @param expected_size The size of the expected packet.
+ * @param type The expected packet type.
+ * @return True if the packet is valid, false otherwise.
+ */
+inline bool isValidUDPPacket(const UDPPacketHeader& header, size_t size, size_t expected_size, UDPPacketType type) {
+	return size == expected_size and
+	       header.magic == udp_protocol_magic and
+	       header.version == udp_protocol_version and
+	       header.type == type and
+	       header.joint_count <= udp_max_joint_count;
+}
+
+} // namespace phri
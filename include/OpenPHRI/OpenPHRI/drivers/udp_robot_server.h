@@ -0,0 +1,127 @@
+/*      File: udp_robot_server.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file udp_robot_server.h
+ * @author Benjamin Navarro
+ * @brief Definition of the UDPRobotServer class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/drivers/udp_protocol.h>
+
+#include <netinet/in.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace phri {
+
+/** @brief A stand-in for a real robot controller speaking the UDPDriver protocol.
+ *  @details A background thread integrates the last received joint velocity command each sample period and sends the resulting state
+ *  back to the last client that sent a command. It can be used on the loopback interface to test the UDPDriver and the network
+ *  handling (packet losses can be simulated) without the real robot.
+ */
+class UDPRobotServer {
+public:
+	/**
+	 * @brief Construct a server for a robot with the given number of joints.
+	 * @param joint_count The number of joints of the simulated robot.
+	 * @param sample_time The period at which the states are sent.
+	 * @param port The UDP port to listen on.
+	 */
+	UDPRobotServer(size_t joint_count, double sample_time, int port);
+	~UDPRobotServer();
+
+	/**
+	 * @brief Start the server thread.
+	 */
+	void start();
+
+	/**
+	 * @brief Stop the server thread.
+	 */
+	void stop();
+
+	/**
+	 * @brief Set the current joint positions.
+	 * @param position The joint positions.
+	 */
+	void setJointPosition(const VectorXd& position);
+
+	/**
+	 * @brief Get the current joint positions.
+	 * @return The joint positions.
+	 */
+	VectorXd getJointPosition() const;
+
+	/**
+	 * @brief Set the external force sent along with the joint positions.
+	 * @param force The force applied to the control point.
+	 */
+	void setExternalForce(const Vector6d& force);
+
+	/**
+	 * @brief Simulate packet losses by not sending one state every period states.
+	 * @param period The drop period. Zero disables the losses.
+	 */
+	void setStateDropPeriod(size_t period);
+
+	/**
+	 * @brief The number of valid commands received so far.
+	 * @return The number of commands.
+	 */
+	uint64_t receivedCommands() const;
+
+private:
+	void run();
+	void receiveCommands();
+	void sendState();
+
+	int socket_;
+	double sample_time_;
+	size_t joint_count_;
+
+	std::thread thread_;
+	std::atomic<bool> running_;
+	std::atomic<size_t> drop_period_;
+	std::atomic<uint64_t> received_commands_;
+
+	// Protects the robot state, shared with the user thread
+	mutable std::mutex state_mutex_;
+	VectorXd joint_position_;
+	VectorXd joint_velocity_;
+	Vector6d external_force_;
+
+	uint32_t state_sequence_;
+	uint32_t command_sequence_;
+	bool client_known_;
+	UDPStatePacket state_packet_;
+	sockaddr_in client_address_;
+};
+
+using UDPRobotServerPtr = std::shared_ptr<UDPRobotServer>;
+using UDPRobotServerConstPtr = std::shared_ptr<const UDPRobotServer>;
+
+}
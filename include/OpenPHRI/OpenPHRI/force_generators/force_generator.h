@@ -53,6 +53,18 @@ public:
 	 */
 	virtual Vector6d operator()() final;
 
+	/**
+	 * @brief Write the internal state of the force generator (e.g. filters, hysteresis) to a snapshot. Does nothing by default.
+	 * @param writer The writer to use.
+	 */
+	virtual void saveState(StateWriter& writer) const;
+
+	/**
+	 * @brief Restore a state written by saveState().
+	 * @param reader The reader to use.
+	 */
+	virtual void restoreState(StateReader& reader);
+
 protected:
 	/**
 	 * @brief Construct a force generator
@@ -30,8 +30,11 @@
 
 #include <OpenPHRI/force_generators/force_generator.h>
 #include <OpenPHRI/utilities/object_collection.hpp>
+#include <OpenPHRI/utilities/point_cloud.h>
+#include <OpenPHRI/utilities/uniform_grid.h>
 #include <OpenPHRI/definitions.h>
 #include <map>
+#include <vector>
 
 namespace phri {
 
@@ -70,6 +73,8 @@ using PotentialFieldObjectConstPtr = std::shared_ptr<const PotentialFieldObject>
 
 /** @brief A potential field generator for basic collision avoidance.
  *  @details Use a set of PotentialFieldObject to determine which force has to be applied to the TCP. "Based on Real-time obstacle avoidance for manipulators and mobile robots" by O. Khatib.
+ *  With many repulsive objects, only the ones in the neighborhood of the robot are visited, using a UniformGrid built once their positions and threshold distances stop changing.
+ *  Moving objects are processed by a linear pass, which is faster than rebuilding the grid on each cycle. Use setPointCloud() for large sets of moving obstacles.
  */
 class PotentialFieldGenerator : public ForceGenerator, public ObjectCollection<PotentialFieldObjectPtr> {
 public:
@@ -88,11 +93,49 @@ public:
 	PotentialFieldGenerator(Vector3dConstPtr offset, ReferenceFrame objects_frame = ReferenceFrame::TCP);
 	virtual ~PotentialFieldGenerator() = default;
 
+	virtual bool add(const std::string& name, PotentialFieldObjectPtr item, bool force = false) override;
+	virtual bool remove(const std::string& name) override;
+
+	/**
+	 * @brief Set a point cloud whose points are repulsive objects sharing the same gain and threshold distance.
+	 * The points must be expressed in the same frame as the objects.
+	 * @param point_cloud The point cloud. nullptr to remove the current one.
+	 * @param gain Gain applied to get the resulting force.
+	 * @param threshold_distance Distance at which the points' repulsive effect will start.
+	 */
+	void setPointCloud(PointCloudConstPtr point_cloud, doubleConstPtr gain, doubleConstPtr threshold_distance);
+
 protected:
 	virtual void update(Vector6d& force) override;
 
 	ReferenceFrame objects_frame_;
 	Vector3dConstPtr offset_;
+
+private:
+	void updateObjects();
+	Vector3d attractiveForce(const Vector3d& rob_pos) const;
+	Vector3d repulsiveForce(const Vector3d& rob_pos);
+	void addRepulsiveForce(size_t index, const Vector3d& rob_pos, Vector3d& force) const;
+
+	// Objects of the collection, split by type, refreshed only when the collection changes
+	std::vector<const PotentialFieldObject*> attractive_objects_;
+	std::vector<const PotentialFieldObject*> repulsive_objects_;
+	bool objects_changed_;
+
+	// Positions, gains and threshold distances of the repulsive objects, stored as separate arrays
+	std::vector<double> repulsive_x_;
+	std::vector<double> repulsive_y_;
+	std::vector<double> repulsive_z_;
+	std::vector<double> repulsive_gain_;
+	std::vector<double> repulsive_threshold_;
+	UniformGrid grid_;
+	bool grid_valid_;
+	// Number of consecutive cycles without any position or threshold change, saturated at the grid building delay
+	size_t static_cycles_;
+
+	PointCloudConstPtr point_cloud_;
+	doubleConstPtr point_cloud_gain_;
+	doubleConstPtr point_cloud_threshold_distance_;
 };
 
 using PotentialFieldGeneratorPtr = std::shared_ptr<PotentialFieldGenerator>;
@@ -36,6 +36,8 @@ class VelocityGenerator;
 class JointVelocityGenerator;
 class ForceGenerator;
 class TorqueGenerator;
+class StateWriter;
+class StateReader;
 class LinearInterpolator;
 class PolynomialInterpolator;
 
@@ -221,8 +221,21 @@ public:
 	 */
 	Matrix6dPtr spatialTransformationMatrix() const;
 
+	/**
+	 * @brief Write all the robot data (state, commands, intermediate computations) to a snapshot.
+	 * @param writer The writer to use.
+	 */
+	void saveState(StateWriter& writer) const;
+
+	/**
+	 * @brief Restore the data written by saveState(). The shared pointers given by the accessors remain valid.
+	 * @param reader The reader to use. Throws std::length_error if the robot has a different number of joints.
+	 */
+	void restoreState(StateReader& reader);
+
 private:
 	friend class SafetyController;
+	friend class AsyncDriver;
 
 	void create();
 
@@ -341,6 +341,32 @@ public:
 	 */
 	void print() const;
 
+	/**
+	 * @brief Write the state of the robot and the last values and internal states of all the constraints and generators to a snapshot.
+	 * @param writer The writer to use.
+	 */
+	void saveState(StateWriter& writer) const;
+
+	/**
+	 * @brief Restore a state written by saveState(). The controller must hold the same constraints and generators, with the same names.
+	 * @param reader The reader to use. Throws std::runtime_error if the constraints or generators don't match the stored ones.
+	 */
+	void restoreState(StateReader& reader);
+
+	/**
+	 * @brief Exchange the constraints, generators and damped least squares parameters with the ones of another controller working on the same robot.
+	 * @details Only pointers are exchanged, so this can be done on the control thread, see ControllerReconfigurator. The pointers to the stored values
+	 * obtained through the iterators are invalidated.
+	 * @param other The other controller.
+	 */
+	void swapConfiguration(SafetyController& other);
+
+	/**
+	 * @brief Incremented each time items are added or removed and on each call to swapConfiguration(), to detect that the stored items have changed.
+	 * @return The configuration version.
+	 */
+	size_t configurationVersion() const;
+
 	template<typename T>
 	struct StorageWrapper {
 		using value_type = decltype(std::declval<T>().compute());
@@ -375,6 +401,8 @@ protected:
 	const Vector6d& computeVelocitySum();
 	const VectorXd& computeJointVelocitySum();
 	const MatrixXd& computeJacobianInverse() const;
+	// Increment the configuration version if an item has been added or removed
+	bool itemsChanged(bool changed);
 
 	ObjectCollection<StorageWrapper<Constraint>>               constraints_;
 	ObjectCollection<StorageWrapper<ForceGenerator>>           force_generators_;
@@ -388,6 +416,7 @@ protected:
 	bool dynamic_dls_;
 	double lambda2_;
 	double sigma_min_threshold_;
+	size_t configuration_version_;
 };
 
 using SafetyControllerPtr = std::shared_ptr<SafetyController>;
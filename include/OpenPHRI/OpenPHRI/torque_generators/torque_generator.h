@@ -54,6 +54,18 @@ public:
 	 */
 	virtual VectorXd operator()() final;
 
+	/**
+	 * @brief Write the internal state of the torque generator (e.g. filters, hysteresis) to a snapshot. Does nothing by default.
+	 * @param writer The writer to use.
+	 */
+	virtual void saveState(StateWriter& writer) const;
+
+	/**
+	 * @brief Restore a state written by saveState().
+	 * @param reader The reader to use.
+	 */
+	virtual void restoreState(StateReader& reader);
+
 protected:
 	virtual void update(VectorXd& torque) = 0;
 	friend class SafetyController;
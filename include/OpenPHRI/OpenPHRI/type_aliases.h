@@ -34,6 +34,7 @@ namespace phri {
 using Eigen::MatrixXd;
 using Eigen::Matrix3d;
 using Eigen::Matrix4d;
+using Eigen::Matrix3Xd;
 using Matrix6d = Eigen::Matrix<double, 6, 6>;
 using Eigen::VectorXd;
 using Eigen::Vector2d;
@@ -44,6 +45,7 @@ using AffineTransform = Eigen::Transform<double, 3, Eigen::Affine>;
 
 using Matrix3dPtr = std::shared_ptr<Eigen::Matrix3d>;
 using Matrix4dPtr = std::shared_ptr<Eigen::Matrix4d>;
+using Matrix3XdPtr = std::shared_ptr<Eigen::Matrix3Xd>;
 using Matrix6dPtr = std::shared_ptr<Matrix6d>;
 using MatrixXdPtr = std::shared_ptr<Eigen::MatrixXd>;
 using Vector2dPtr = std::shared_ptr<Vector2d>;
@@ -56,6 +58,7 @@ using AffineTransformPtr = std::shared_ptr<AffineTransform>;
 
 using Matrix3dConstPtr = std::shared_ptr<const Eigen::Matrix3d>;
 using Matrix4dConstPtr = std::shared_ptr<const Eigen::Matrix4d>;
+using Matrix3XdConstPtr = std::shared_ptr<const Eigen::Matrix3Xd>;
 using Matrix6dConstPtr = std::shared_ptr<const Matrix6d>;
 using MatrixXdConstPtr = std::shared_ptr<const Eigen::MatrixXd>;
 using Vector2dConstPtr = std::shared_ptr<const Vector2d>;
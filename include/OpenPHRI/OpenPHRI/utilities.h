@@ -29,19 +29,34 @@
  #pragma once
 
 #include <OpenPHRI/utilities/benchmark.hpp>
+#include <OpenPHRI/utilities/binary_data_replayer.h>
+#include <OpenPHRI/utilities/binary_log.h>
 #include <OpenPHRI/utilities/clock.h>
+#include <OpenPHRI/utilities/collision_scene.h>
+#include <OpenPHRI/utilities/collision_shapes.h>
+#include <OpenPHRI/utilities/controller_factory.h>
+#include <OpenPHRI/utilities/controller_reconfigurator.h>
 #include <OpenPHRI/utilities/data_logger.h>
 #include <OpenPHRI/utilities/data_replayer.hpp>
 #include <OpenPHRI/utilities/deadband.hpp>
 #include <OpenPHRI/utilities/derivator.hpp>
 #include <OpenPHRI/utilities/integrator.hpp>
 #include <OpenPHRI/utilities/interpolators.h>
+#include <OpenPHRI/utilities/joint_limits.h>
 #include <OpenPHRI/utilities/laser_scanner_detector.h>
+#include <OpenPHRI/utilities/loop_runner.h>
+#include <OpenPHRI/utilities/lookup_table.h>
 #include <OpenPHRI/utilities/manipulator_equivalent_mass.h>
 #include <OpenPHRI/utilities/object_collection.hpp>
+#include <OpenPHRI/utilities/parameter_block.h>
+#include <OpenPHRI/utilities/point_cloud.h>
+#include <OpenPHRI/utilities/robot_geometry.h>
 #include <OpenPHRI/utilities/robot_model.h>
+#include <OpenPHRI/utilities/state_snapshot.h>
 #include <OpenPHRI/utilities/task_space_trajectory_generator.h>
+#include <OpenPHRI/utilities/telemetry.h>
 #include <OpenPHRI/utilities/trajectory_generator.h>
+#include <OpenPHRI/utilities/uniform_grid.h>
 #include <OpenPHRI/utilities/low_pass_filter.hpp>
 
 #include <OpenPHRI/utilities/app_maker.h>
@@ -4,6 +4,10 @@
 #include <OpenPHRI/safety_controller.h>
 #include <OpenPHRI/utilities/robot_model.h>
 #include <OpenPHRI/utilities/data_logger.h>
+#include <OpenPHRI/utilities/loop_runner.h>
+#include <OpenPHRI/utilities/telemetry.h>
+#include <OpenPHRI/utilities/controller_reconfigurator.h>
+#include <OpenPHRI/utilities/controller_factory.h>
 #include <OpenPHRI/utilities/exceptions.h>
 #include <OpenPHRI/drivers/driver.h>
 
@@ -22,10 +26,29 @@ public:
 
 	bool init(std::function<bool(void)> init_code = std::function<bool(void)>());
 
+	/**
+	 * @brief Run one control cycle: read the driver, update the model, compute the controller, send the commands and update the clock.
+	 * @details The clock is reset at the beginning of the first cycle following the construction or init(), so that the time spent before is not measured as a cycle.
+	 * @param pre_controller_code Code executed before the controller.
+	 * @param post_controller_code Code executed after the controller.
+	 * @return False if the driver or the user code failed, true otherwise.
+	 */
 	bool run(
 		std::function<bool(void)> pre_controller_code = std::function<bool(void)>(),
 		std::function<bool(void)> post_controller_code = std::function<bool(void)>());
 
+	/**
+	 * @brief Periodically call run() at the driver sample time until getLoopRunner()->stop() is called or a cycle fails.
+	 * @details The loop is run by a LoopRunner configured with the optional 'loop' section of the configuration file ('priority', 'cpu', 'lock_memory' and 'pace' fields).
+	 * It is paced by the LoopRunner unless the driver is self paced (see DriverCapabilities), e.g. VREPDriver, which can be overridden with the 'pace' field.
+	 * @param pre_controller_code Code executed before the controller, see run().
+	 * @param post_controller_code Code executed after the controller, see run().
+	 * @return False if a cycle failed, true otherwise.
+	 */
+	bool runLoop(
+		std::function<bool(void)> pre_controller_code = std::function<bool(void)>(),
+		std::function<bool(void)> post_controller_code = std::function<bool(void)>());
+
 	bool stop();
 
 	RobotPtr getRobot() const;
@@ -33,6 +56,24 @@ public:
 	RobotModelPtr getModel() const;
 	DriverPtr getDriver() const;
 	DataLoggerPtr getDataLogger() const;
+	ClockPtr getClock() const;
+	LoopRunnerPtr getLoopRunner() const;
+	/**
+	 * @brief The telemetry publisher, configured with the optional 'telemetry' section of the configuration file ('name', 'publish_control_data' and 'publish_robot_data' fields).
+	 * @return The publisher, or a null pointer if there is no 'telemetry' section.
+	 */
+	TelemetryPublisherPtr getTelemetry() const;
+	/**
+	 * @brief The scalar parameters of the constraints and generators declared in the 'controller' section of the current configuration, see ControllerFactory.
+	 * @details After a reconfiguration, the block of the new configuration is returned. Not to be called from the control thread.
+	 * @return The parameter block. Shared parameters can be modified through ParameterBlock::get().
+	 */
+	ParameterBlockPtr getControllerParameters() const;
+	/**
+	 * @brief The controller reconfigurator. The new configurations are swapped in at the beginning of run() and their constraints and generators are built by the ControllerFactory.
+	 * @return The reconfigurator.
+	 */
+	ControllerReconfiguratorPtr getReconfigurator() const;
 
 	template<typename T>
 	T getParameter(const std::string& name) const {
@@ -0,0 +1,160 @@
+/*      File: binary_data_replayer.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file binary_data_replayer.h
+ * @author Benjamin Navarro
+ * @brief Definition of the BinaryDataReplayer class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/utilities/binary_log.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace phri {
+
+/** @brief Replay the signals recorded in a binary log file, row by row.
+ *  @details The file is memory mapped and the values of the current row can be accessed in place with get(), or copied to
+ *  registered outputs on each call to process(). All the signals are replayed in lockstep since they share the same rows.
+ *  process() never waits, so the replay runs as fast as the caller calls it. Use processUntil() to follow a clock at any speed.
+ */
+class BinaryDataReplayer {
+public:
+	/**
+	 * @brief Open a binary log file for replaying.
+	 * @param log_file The path of the file written by a DataLogger in binary mode or by convertTextLogs().
+	 */
+	explicit BinaryDataReplayer(const std::string& log_file);
+	~BinaryDataReplayer() = default;
+
+	/**
+	 * @brief Copy the values of a signal to the given output on each process().
+	 * @param signal The name of the signal.
+	 * @param output A pointer to the memory to update. Must be able to hold all the signal values.
+	 * @param size The number of values of the output. Must match the signal size.
+	 */
+	void replay(const std::string& signal, double* output, size_t size);
+
+	/**
+	 * @brief Copy the values of a signal to the given vector on each process().
+	 * @param signal The name of the signal.
+	 * @param output A shared pointer to the vector to update.
+	 */
+	template<typename T>
+	void replay(const std::string& signal, const std::shared_ptr<T>& output) {
+		replay(signal, output->data(), output->size());
+	}
+
+	/**
+	 * @brief Load the next row and update the outputs.
+	 * @return False if the end of the log has been reached, true otherwise.
+	 */
+	bool process();
+
+	/**
+	 * @brief Shortcut for process().
+	 * @return See process().
+	 */
+	bool operator()();
+
+	/**
+	 * @brief Load the last row with a timestamp lower than or equal to the given time and update the outputs.
+	 * @param time The time to reach.
+	 * @return False if the end of the log has been reached, true otherwise.
+	 */
+	bool processUntil(double time);
+
+	/**
+	 * @brief Set the position so that the next process() loads the first row with a timestamp greater than or equal to the given time.
+	 * @param time The time to seek to.
+	 * @return False if all the rows are before the given time, true otherwise.
+	 */
+	bool seek(double time);
+
+	/**
+	 * @brief Go back to the first row.
+	 */
+	void rewind();
+
+	/**
+	 * @brief The values of a signal at the current row, mapped in place.
+	 * @param signal The name of the signal.
+	 * @return A strided map on the values.
+	 */
+	BinaryLogReader::SignalMap get(const std::string& signal) const;
+
+	/**
+	 * @brief The timestamp of the current row.
+	 * @return The timestamp.
+	 */
+	double time() const;
+
+	/**
+	 * @brief The index of the current row.
+	 * @return The row index.
+	 */
+	size_t row() const;
+
+	/**
+	 * @brief The underlying log reader.
+	 * @return The reader.
+	 */
+	const BinaryLogReader& reader() const;
+
+	/**
+	 * @brief Convert text logs, as produced by DataLogger, to a binary log file so that they can be replayed efficiently.
+	 * @details The files are read line by line and must have the same number of lines. The timestamps are taken from the first one.
+	 * @param text_files The text files to convert, indexed by the name to give to the signal.
+	 * @param log_file The path of the binary log file to create.
+	 * @return The number of converted rows.
+	 */
+	static size_t convertTextLogs(const std::map<std::string, std::string>& text_files, const std::string& log_file);
+
+private:
+	struct Output {
+		size_t signal;
+		double* data;
+		size_t size;
+	};
+
+	void load(size_t row);
+	size_t signalIndex(const std::string& signal) const;
+	BinaryLogReader::SignalMap signal(size_t signal) const;
+
+	BinaryLogReader reader_;
+	std::vector<Output> outputs_;
+	size_t next_row_;
+	size_t current_row_;
+	size_t current_chunk_;
+	size_t chunk_row_;
+};
+
+using BinaryDataReplayerPtr = std::shared_ptr<BinaryDataReplayer>;
+using BinaryDataReplayerConstPtr = std::shared_ptr<const BinaryDataReplayer>;
+
+} // namespace phri
@@ -0,0 +1,297 @@
+/*      File: binary_log.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file binary_log.h
+ * @author Benjamin Navarro
+ * @brief Definition of the binary log format and of the BinaryLogWriter and BinaryLogReader classes
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/utilities/spsc_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace phri {
+
+/*
+ * Binary log file layout (native endianness, all sizes in bytes):
+ *   header:  magic "OPHRILOG" (8), version (uint32), header size (uint32), signal count (uint32), reserved (uint32),
+ *            then for each signal: name size (uint32), value count (uint32), name (name size),
+ *            padded with zeros up to header size (a multiple of 8)
+ *   chunks:  BinaryLogChunkHeader, then the columns of the chunk one after the other: the time column followed by the
+ *            value columns of each signal in the header order, each holding row count doubles
+ */
+constexpr char binary_log_magic[8] = {'O', 'P', 'H', 'R', 'I', 'L', 'O', 'G'};
+constexpr uint32_t binary_log_version = 1;
+constexpr uint32_t binary_log_chunk_magic = 0x4B4E4843; // "CHNK"
+
+struct BinaryLogChunkHeader {
+	uint32_t magic;
+	uint32_t row_count;
+	double first_time;
+	double last_time;
+};
+
+static_assert(sizeof(BinaryLogChunkHeader) == 24, "The chunk header must keep the columns 8 bytes aligned");
+
+/** @brief Description of a logged signal.
+ */
+struct BinaryLogSignal {
+	std::string name;
+	size_t size;
+
+	bool operator==(const BinaryLogSignal& other) const {
+		return name == other.name and size == other.size;
+	}
+};
+
+/** @brief Writes rows of values to a binary log file from a background thread.
+ *  @details Each row holds a timestamp followed by the values of all the signals. The control thread only copies the rows into
+ *  a preallocated lock-free ring buffer, the writer thread transposes them into columnar chunks and writes them to the disk.
+ *  Rows are dropped, and counted, if the ring buffer is full.
+ */
+class BinaryLogWriter {
+public:
+	/**
+	 * @brief Create the log file, write its header and start the writer thread.
+	 * @param file The path of the log file.
+	 * @param signals The signals that compose a row, after the timestamp.
+	 * @param buffer_rows The number of rows the ring buffer can hold.
+	 * @param chunk_rows The maximum number of rows in a chunk. Partial chunks are written every half second and on closing.
+	 * @param append If true and the file already exists with the same signals, the new chunks are appended to it after removing
+	 * any incomplete trailing chunk. Otherwise the file is overwritten.
+	 */
+	BinaryLogWriter(
+		const std::string& file,
+		const std::vector<BinaryLogSignal>& signals,
+		size_t buffer_rows = 4096,
+		size_t chunk_rows = 1024,
+		bool append = false);
+
+	/**
+	 * @brief Write the pending rows and close the file.
+	 */
+	~BinaryLogWriter();
+
+	/**
+	 * @brief The memory where the next row must be written: the timestamp followed by the signals values. Control thread only.
+	 * @return A pointer to the row, or nullptr if the buffer is full (the row is counted as dropped).
+	 */
+	double* beginRow();
+
+	/**
+	 * @brief Same as beginRow() but wait for a free row instead of dropping it. For offline uses only (e.g. conversions).
+	 * @return A pointer to the row.
+	 */
+	double* waitRow();
+
+	/**
+	 * @brief Publish the row obtained with beginRow() or waitRow(). Control thread only.
+	 */
+	void commitRow();
+
+	/**
+	 * @brief The number of doubles in a row, including the timestamp.
+	 * @return The row size.
+	 */
+	size_t rowSize() const;
+
+	/**
+	 * @brief The number of rows written to the disk so far.
+	 * @return The number of rows.
+	 */
+	uint64_t writtenRows() const;
+
+	/**
+	 * @brief The number of rows dropped because the ring buffer was full.
+	 * @return The number of rows.
+	 */
+	uint64_t droppedRows() const;
+
+	/**
+	 * @brief Stop the writer thread, write the pending rows and close the file. Called on destruction.
+	 */
+	void close();
+
+private:
+	void writeHeader(const std::vector<BinaryLogSignal>& signals);
+	void writerLoop();
+	void writeChunk();
+
+	std::ofstream file_;
+	SPSCRecordBuffer buffer_;
+	size_t chunk_rows_;
+	std::vector<double> chunk_;
+	size_t chunk_row_count_;
+
+	std::thread writer_thread_;
+	std::atomic<bool> running_;
+	std::atomic<uint64_t> written_rows_;
+	std::atomic<uint64_t> dropped_rows_;
+};
+
+using BinaryLogWriterPtr = std::shared_ptr<BinaryLogWriter>;
+using BinaryLogWriterConstPtr = std::shared_ptr<const BinaryLogWriter>;
+
+/** @brief Read only access to a binary log file through a memory mapping.
+ *  @details The chunks are indexed on opening, which allows random access by row or by time without reading the values.
+ *  Reading stops at the first incomplete or corrupted chunk, e.g. the one being written when the logging process crashed.
+ *  Since the values are stored by column, the values of a signal at a given row are accessed through strided Eigen maps, without copies.
+ */
+class BinaryLogReader {
+public:
+	/** @brief Location of a chunk in the file.
+	 */
+	struct Chunk {
+		size_t offset;
+		size_t first_row;
+		size_t row_count;
+		double first_time;
+		double last_time;
+	};
+
+	using SignalMap = Eigen::Map<const VectorXd, 0, Eigen::InnerStride<>>;
+
+	/**
+	 * @brief Map the file in memory and index its chunks.
+	 * @param file The path of the log file.
+	 */
+	explicit BinaryLogReader(const std::string& file);
+	~BinaryLogReader();
+
+	BinaryLogReader(const BinaryLogReader&) = delete;
+	BinaryLogReader& operator=(const BinaryLogReader&) = delete;
+
+	/**
+	 * @brief The logged signals.
+	 * @return The signals, in the file order.
+	 */
+	const std::vector<BinaryLogSignal>& signals() const;
+
+	/**
+	 * @brief The index of a signal.
+	 * @param name The name of the signal.
+	 * @return The index, or -1 if there is no such signal.
+	 */
+	int signalIndex(const std::string& name) const;
+
+	/**
+	 * @brief The index of the first column of a signal in the chunks.
+	 * @param signal The signal index.
+	 * @return The column index, 0 being the timestamps.
+	 */
+	size_t signalColumn(size_t signal) const;
+
+	/**
+	 * @brief The total number of rows in the valid chunks.
+	 * @return The number of rows.
+	 */
+	size_t rowCount() const;
+
+	/**
+	 * @brief The number of doubles in a row, including the timestamp.
+	 * @return The row size.
+	 */
+	size_t rowSize() const;
+
+	/**
+	 * @brief The valid chunks.
+	 * @return The chunks.
+	 */
+	const std::vector<Chunk>& chunks() const;
+
+	/**
+	 * @brief The size of the valid part of the file.
+	 * @return The size, in bytes.
+	 */
+	size_t validSize() const;
+
+	/**
+	 * @brief Tell if the file has invalid trailing data.
+	 * @return True if the file is larger than validSize().
+	 */
+	bool isTruncated() const;
+
+	/**
+	 * @brief Find the first row with a timestamp greater than or equal to a given time.
+	 * @param time The time to look for.
+	 * @return The row index, or rowCount() if all the rows are before the given time.
+	 */
+	size_t findRow(double time) const;
+
+	/**
+	 * @brief The timestamp of a row.
+	 * @param row The row index.
+	 * @return The timestamp.
+	 */
+	double time(size_t row) const;
+
+	/**
+	 * @brief The values of a signal at a given row, mapped in place.
+	 * @param row The row index.
+	 * @param signal The signal index.
+	 * @return A strided map on the values.
+	 */
+	SignalMap signal(size_t row, size_t signal) const;
+
+	/**
+	 * @brief Direct access to a column of a chunk.
+	 * @param chunk The chunk index.
+	 * @param column The column index, 0 being the timestamps.
+	 * @return A pointer to the chunk(chunk).row_count values of the column.
+	 */
+	const double* column(size_t chunk, size_t column) const;
+
+	/**
+	 * @brief Truncate a log file to its valid part, removing any incomplete trailing chunk.
+	 * @param file The path of the log file.
+	 * @return True if the file has been truncated, false if it was already valid.
+	 */
+	static bool recover(const std::string& file);
+
+private:
+	size_t chunkIndex(size_t row) const;
+
+	int fd_;
+	const char* data_;
+	size_t size_;
+	size_t valid_size_;
+	size_t row_count_;
+	size_t row_size_;
+	std::vector<BinaryLogSignal> signals_;
+	std::vector<size_t> signal_columns_;
+	std::vector<Chunk> chunks_;
+};
+
+using BinaryLogReaderPtr = std::shared_ptr<BinaryLogReader>;
+using BinaryLogReaderConstPtr = std::shared_ptr<const BinaryLogReader>;
+
+} // namespace phri
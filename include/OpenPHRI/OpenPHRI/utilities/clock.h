@@ -28,27 +28,136 @@
 
 #pragma once
 
-#include <memory>
 #include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
 
 namespace phri {
 
+/** @brief A monotonic clock giving both the nominal and the measured time of a periodic loop.
+ *  @details The measured time is read from std::chrono::steady_clock. In fixed sample time mode, the nominal time is advanced by the sample
+ *  time on each update() and the cycles lasting more than one and a half sample time are counted as missed. Otherwise the nominal time is the measured one.
+ *  Subscribers are notified at the end of each update().
+ */
 class Clock {
 public:
+	using Subscriber = std::function<void(const Clock&)>;
+	using SubscriptionID = size_t;
+
+	/** @brief Timing statistics of the updates.
+	 */
+	struct Statistics {
+		uint64_t cycles = 0;
+		uint64_t missed_cycles = 0;
+		double last_cycle_time = 0.;
+		double min_cycle_time = 0.;
+		double max_cycle_time = 0.;
+		double mean_cycle_time = 0.;
+	};
+
+	/**
+	 * @brief Construct a clock giving the elapsed time since its creation or last reset.
+	 */
 	Clock();
+
+	/**
+	 * @brief Construct a clock with a fixed sample time.
+	 * @param sample_time The time added to the nominal time on each update.
+	 */
 	explicit Clock(double sample_time);
 	~Clock() = default;
 
+	/**
+	 * @brief Set the nominal and measured times back to zero and reset the statistics. The subscribers are kept.
+	 */
 	void reset();
+
+	/**
+	 * @brief The time used by default, i.e. the nominal time.
+	 * @return A shared pointer to the time.
+	 */
 	std::shared_ptr<double> getTime() const;
 
+	/**
+	 * @brief The nominal time, computed from the sample time in fixed sample time mode.
+	 * @return A shared pointer to the nominal time.
+	 */
+	std::shared_ptr<double> getNominalTime() const;
+
+	/**
+	 * @brief The time actually elapsed since the creation or last reset of the clock.
+	 * @return A shared pointer to the measured time.
+	 */
+	std::shared_ptr<double> getMeasuredTime() const;
+
+	/**
+	 * @brief The measured duration of the last cycle (between the last two updates).
+	 * @return A shared pointer to the cycle time.
+	 */
+	std::shared_ptr<double> getCycleTime() const;
+
+	/**
+	 * @brief The difference between the measured and the nominal times.
+	 * @return The drift, in seconds.
+	 */
+	double getDrift() const;
+
+	/**
+	 * @brief The fixed sample time, or a negative value if not in fixed sample time mode.
+	 * @return The sample time.
+	 */
+	double getSampleTime() const;
+
+	/**
+	 * @brief The cycle time statistics.
+	 * @return The statistics.
+	 */
+	const Statistics& getStatistics() const;
+
+	/**
+	 * @brief Make the nominal time also advance by the missed cycles so that it stays aligned with the measured time grid.
+	 * @param reconcile True to enable, false to disable (default).
+	 */
+	void setReconciliation(bool reconcile);
+
+	/**
+	 * @brief Update the times and statistics and notify the subscribers.
+	 * @return The nominal time.
+	 */
 	double update();
+
+	/**
+	 * @brief Shortcut for update().
+	 * @return The nominal time.
+	 */
 	double operator()();
 
+	/**
+	 * @brief Register a function to call at the end of each update.
+	 * @param subscriber The function to call.
+	 * @return The identifier to use to unsubscribe.
+	 */
+	SubscriptionID subscribe(const Subscriber& subscriber);
+
+	/**
+	 * @brief Remove a previously registered subscriber.
+	 * @param id The identifier returned by subscribe().
+	 */
+	void unsubscribe(SubscriptionID id);
+
 private:
-	std::chrono::high_resolution_clock::time_point init_time_;
+	std::chrono::steady_clock::time_point init_time_;
+	std::chrono::steady_clock::time_point last_update_time_;
 	double sample_time_;
-	std::shared_ptr<double> time_;
+	bool reconcile_;
+	std::shared_ptr<double> nominal_time_;
+	std::shared_ptr<double> measured_time_;
+	std::shared_ptr<double> cycle_time_;
+	Statistics statistics_;
+	std::map<SubscriptionID, Subscriber> subscribers_;
+	SubscriptionID next_subscription_id_;
 };
 
 using ClockPtr = std::shared_ptr<Clock>;
@@ -0,0 +1,152 @@
+/*      File: collision_scene.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file collision_scene.h
+ * @author Benjamin Navarro
+ * @brief Definition of the CollisionScene class and CollisionDistance struct
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/utilities/collision_shapes.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace phri {
+
+/** @brief Minimum distance between a robot body and an obstacle body, with the closest point (witness point) on each of them.
+ */
+struct CollisionDistance {
+	double distance = std::numeric_limits<double>::infinity();  /**< Distance between the bodies, zero if they intersect, infinity if farther than the maximum distance. */
+	size_t robot_body = 0;                                      /**< Index of the robot body. */
+	size_t obstacle_body = 0;                                   /**< Index of the closest obstacle body. */
+	Vector3d robot_point = Vector3d::Zero();                    /**< Closest point on the robot body, in the base frame. */
+	Vector3d obstacle_point = Vector3d::Zero();                 /**< Closest point on the obstacle body, in the base frame. */
+};
+
+/** @brief Computes the minimum distances between the bodies of the robot and the obstacle bodies (humans, environment).
+ *  @details Each body is a convex CollisionShape attached to a frame given by a transformation matrix, such as RobotModel::getLinkTransform() for the robot links:
+ *  @code
+ *  CollisionScene scene(1.); // distances above 1m are not computed
+ *  scene.addRobotBody("forearm", make_shared<CapsuleShape>(0.07, 0.4), model->getLinkTransform(model->linkIndex("link_4")));
+ *  scene.addObstacleBody("operator_head", make_shared<SphereShape>(0.15), head_transform);
+ *  ...
+ *  model->forwardKinematics();
+ *  scene.update();
+ *  double distance = scene.closest().distance;
+ *  @endcode
+ *  The broad phase keeps the obstacles sorted along the x axis (insertion sort, almost linear since the order changes little from cycle to cycle)
+ *  and prunes the pairs whose bounding boxes are farther than the closest distance found so far. The remaining pairs go through a GJK distance computation,
+ *  initialized with the separating direction of the previous cycle. The pair that was the closest during the previous cycle is evaluated first.
+ *  Apart from the body additions, no memory is allocated.
+ */
+class CollisionScene {
+public:
+	/**
+	 * @brief Construct an empty scene.
+	 * @param maximum_distance The distance above which the pairs of bodies are ignored.
+	 */
+	explicit CollisionScene(double maximum_distance = std::numeric_limits<double>::infinity());
+	~CollisionScene() = default;
+
+	/**
+	 * @brief Add a body to the robot.
+	 * @param name The name of the body.
+	 * @param shape The shape of the body.
+	 * @param frame The transformation from the frame the body is attached to the base frame.
+	 * @param offset The transformation from the shape frame to the attachment frame.
+	 * @return The index of the body.
+	 */
+	size_t addRobotBody(const std::string& name, CollisionShapeConstPtr shape, AffineTransformConstPtr frame, const AffineTransform& offset = AffineTransform::Identity());
+
+	/**
+	 * @brief Add an obstacle body.
+	 * @param name The name of the body.
+	 * @param shape The shape of the body.
+	 * @param frame The transformation from the frame the body is attached to the base frame.
+	 * @param offset The transformation from the shape frame to the attachment frame.
+	 * @return The index of the body.
+	 */
+	size_t addObstacleBody(const std::string& name, CollisionShapeConstPtr shape, AffineTransformConstPtr frame, const AffineTransform& offset = AffineTransform::Identity());
+
+	/**
+	 * @brief Compute the distances using the current transformations of the frames.
+	 */
+	void update();
+
+	/**
+	 * @brief The minimum distance between the robot and the obstacles, computed by the last call to update().
+	 * @return The distance and witness points.
+	 */
+	const CollisionDistance& closest() const;
+
+	/**
+	 * @brief The distance to the closest obstacle for each robot body, computed by the last call to update().
+	 * @return The distances and witness points, indexed by robot body.
+	 */
+	const std::vector<CollisionDistance>& robotBodyDistances() const;
+
+	const std::string& robotBodyName(size_t index) const;
+	const std::string& obstacleBodyName(size_t index) const;
+
+	/**
+	 * @brief The number of pairs that went through the narrow phase (GJK) during the last call to update(). Useful to tune the maximum distance.
+	 * @return The number of pairs.
+	 */
+	size_t narrowPhaseCount() const;
+
+private:
+	struct Body {
+		std::string name;
+		CollisionShapeConstPtr shape;
+		AffineTransformConstPtr frame;
+		AffineTransform offset;
+		AffineTransform pose;
+		Vector3d aabb_min;
+		Vector3d aabb_max;
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	void updateBody(Body& body);
+	bool computeDistance(size_t robot_body, size_t obstacle_body, double bound, CollisionDistance& result);
+	void resetCache();
+
+	double maximum_distance_;
+	std::vector<Body, Eigen::aligned_allocator<Body>> robot_bodies_;
+	std::vector<Body, Eigen::aligned_allocator<Body>> obstacle_bodies_;
+	std::vector<size_t> obstacle_order_;
+	std::vector<CollisionDistance> robot_body_distances_;
+	CollisionDistance closest_;
+	size_t narrow_phase_count_;
+
+	// Separating direction of each pair at the previous cycle, to warm start GJK
+	std::vector<Vector3d> pair_directions_;
+};
+
+using CollisionScenePtr = std::shared_ptr<CollisionScene>;
+using CollisionSceneConstPtr = std::shared_ptr<const CollisionScene>;
+
+} // namespace phri
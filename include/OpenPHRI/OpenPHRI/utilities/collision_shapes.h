@@ -0,0 +1,133 @@
+/*      File: collision_shapes.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file collision_shapes.h
+ * @author Benjamin Navarro
+ * @brief Definition of the CollisionShape class and its subclasses
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+
+namespace phri {
+
+/** @brief Base class for the convex shapes used by a CollisionScene.
+ *  @details A shape is described by the support function of a convex core (the farthest point in a given direction) and a margin inflating the core,
+ *  e.g. a sphere is a point with a margin and a capsule a segment with a margin. This keeps the distance computations exact for rounded shapes.
+ */
+class CollisionShape {
+public:
+	virtual ~CollisionShape() = default;
+
+	/**
+	 * @brief The point of the core farthest in the given direction.
+	 * @param direction The direction, in the shape frame. Doesn't need to be normalized.
+	 * @return The support point, in the shape frame.
+	 */
+	virtual Vector3d support(const Vector3d& direction) const = 0;
+
+	/**
+	 * @brief The distance by which the core is inflated.
+	 * @return The margin.
+	 */
+	double margin() const;
+
+protected:
+	explicit CollisionShape(double margin);
+
+private:
+	double margin_;
+};
+
+using CollisionShapePtr = std::shared_ptr<CollisionShape>;
+using CollisionShapeConstPtr = std::shared_ptr<const CollisionShape>;
+
+/** @brief A sphere centered on the shape frame origin.
+ */
+class SphereShape : public CollisionShape {
+public:
+	/**
+	 * @brief Construct a sphere.
+	 * @param radius The radius of the sphere.
+	 */
+	explicit SphereShape(double radius);
+	virtual ~SphereShape() = default;
+
+	virtual Vector3d support(const Vector3d& direction) const override;
+};
+
+/** @brief A capsule centered on the shape frame origin and aligned with its z axis.
+ */
+class CapsuleShape : public CollisionShape {
+public:
+	/**
+	 * @brief Construct a capsule.
+	 * @param radius The radius of the capsule.
+	 * @param length The distance between the centers of the two end spheres.
+	 */
+	CapsuleShape(double radius, double length);
+	virtual ~CapsuleShape() = default;
+
+	virtual Vector3d support(const Vector3d& direction) const override;
+
+private:
+	double half_length_;
+};
+
+/** @brief A box centered on the shape frame origin and aligned with its axes.
+ */
+class BoxShape : public CollisionShape {
+public:
+	/**
+	 * @brief Construct a box.
+	 * @param size The length of the box along each axis.
+	 */
+	explicit BoxShape(const Vector3d& size);
+	virtual ~BoxShape() = default;
+
+	virtual Vector3d support(const Vector3d& direction) const override;
+
+private:
+	Vector3d half_size_;
+};
+
+/** @brief The convex hull of a set of points, e.g. the vertices of a mesh.
+ */
+class ConvexHullShape : public CollisionShape {
+public:
+	/**
+	 * @brief Construct a convex hull. Throws std::runtime_error if there is no vertex.
+	 * @param vertices The points, in the shape frame, one per column. The points inside the hull are ignored.
+	 * @param margin An optional margin to round the hull.
+	 */
+	explicit ConvexHullShape(const Matrix3Xd& vertices, double margin = 0.);
+	virtual ~ConvexHullShape() = default;
+
+	virtual Vector3d support(const Vector3d& direction) const override;
+
+private:
+	Matrix3Xd vertices_;
+};
+
+} // namespace phri
@@ -0,0 +1,293 @@
+/*      File: controller_factory.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file controller_factory.h
+ * @author Benjamin Navarro
+ * @brief Definition of the ObjectFactory, FactoryContext and ControllerFactory classes
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/robot.h>
+#include <OpenPHRI/fwd_decl.h>
+#include <OpenPHRI/utilities/parameter_block.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace phri {
+
+class SafetyController;
+class Interpolator;
+
+/** @brief Gives the create methods of an ObjectFactory access to the robot, the sample time and the parameters of the controller being built.
+ *  @details Scalar parameters are stored in a ParameterBlock. In the configuration, a scalar parameter is either a number or the name of a
+ *  shared parameter (declared in the 'shared_parameters' section of the controller). Read-only inputs can also be the name of an interpolator output.
+ */
+class FactoryContext {
+public:
+	/**
+	 * @brief Construct a context.
+	 * @param robot The robot controlled by the controller being built.
+	 * @param sample_time The controller sample time.
+	 * @param parameters The block storing the scalar parameters.
+	 */
+	FactoryContext(RobotPtr robot, double sample_time, ParameterBlockPtr parameters);
+
+	RobotPtr robot() const;
+	double sampleTime() const;
+	ParameterBlockPtr parameters() const;
+
+	/**
+	 * @brief Resolve a scalar parameter: a number, stored in a new slot of the parameter block, or the name of a shared parameter. Throws std::runtime_error if invalid.
+	 * @param value The YAML value.
+	 * @return A pointer to the parameter, in the parameter block.
+	 */
+	doublePtr parameter(const YAML::Node& value);
+
+	/**
+	 * @brief Get a scalar parameter. Throws std::runtime_error if the field is missing or invalid.
+	 * @param configuration The object configuration.
+	 * @param field The name of the field.
+	 * @return A pointer to the parameter, in the parameter block.
+	 */
+	doublePtr parameter(const YAML::Node& configuration, const std::string& field);
+
+	/**
+	 * @brief Get an optional scalar parameter.
+	 * @param configuration The object configuration.
+	 * @param field The name of the field.
+	 * @param default_value The value used if the field is missing.
+	 * @return A pointer to the parameter, in the parameter block.
+	 */
+	doublePtr parameter(const YAML::Node& configuration, const std::string& field, double default_value);
+
+	/**
+	 * @brief Get a scalar input: a parameter or the output of an interpolator. Throws std::runtime_error if the field is missing or invalid.
+	 * @param configuration The object configuration.
+	 * @param field The name of the field.
+	 * @return A pointer to the input.
+	 */
+	doubleConstPtr input(const YAML::Node& configuration, const std::string& field);
+
+	/**
+	 * @brief Make a read-only input available to the following objects under the given name.
+	 * @param name The name of the input.
+	 * @param input A pointer to the input.
+	 */
+	void addInput(const std::string& name, doubleConstPtr input);
+
+	/**
+	 * @brief Get a fixed size vector. Throws std::runtime_error if the field is missing or doesn't have the right size.
+	 * @param configuration The object configuration.
+	 * @param field The name of the field.
+	 * @return The vector.
+	 */
+	Vector6d vector6d(const YAML::Node& configuration, const std::string& field);
+
+	/**
+	 * @brief Get a vector with one value per joint. A scalar is repeated for all joints. Throws std::runtime_error if the field is missing or doesn't have the right size.
+	 * @param configuration The object configuration.
+	 * @param field The name of the field.
+	 * @return The vector.
+	 */
+	VectorXd jointVector(const YAML::Node& configuration, const std::string& field);
+
+	/**
+	 * @brief Get a 6x6 matrix, given by its 6 diagonal or 36 (row major) coefficients. Throws std::runtime_error if the field is missing or doesn't have the right size.
+	 * @param configuration The object configuration.
+	 * @param field The name of the field.
+	 * @return The matrix.
+	 */
+	Matrix6d matrix6d(const YAML::Node& configuration, const std::string& field);
+
+	/**
+	 * @brief Get a pose given by a position ([x, y, z]) or a position and Euler angles ([x, y, z, rx, ry, rz]).
+	 * @param configuration The object configuration.
+	 * @param field The name of the field.
+	 * @return The pose.
+	 */
+	Pose pose(const YAML::Node& configuration, const std::string& field);
+
+	/**
+	 * @brief Get a reference frame ('tcp', 'base' or 'world').
+	 * @param configuration The object configuration.
+	 * @param field The name of the field.
+	 * @param default_value The frame used if the field is missing.
+	 * @return The frame.
+	 */
+	ReferenceFrame frame(const YAML::Node& configuration, const std::string& field, ReferenceFrame default_value = ReferenceFrame::TCP);
+
+	/**
+	 * @brief Create a nested object, using the 'type' field of its configuration. Throws std::runtime_error if the type is unknown.
+	 * @param configuration The object configuration.
+	 * @return The object.
+	 */
+	template<typename T>
+	std::shared_ptr<T> create(const YAML::Node& configuration);
+
+private:
+	RobotPtr robot_;
+	double sample_time_;
+	ParameterBlockPtr parameters_;
+	std::map<std::string, doubleConstPtr> inputs_;
+};
+
+/** @brief A registry of named create methods for the constraints, the generators and the interpolators.
+ *  @details All the built-in types are registered (see ControllerFactory for their names and fields). Other types can be added with add(), e.g.:
+ *  @code
+ *  const bool registered = ConstraintFactory::add("my_constraint",
+ *      [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+ *          return std::make_shared<MyConstraint>(context.input(conf, "threshold"));
+ *      });
+ *  @endcode
+ */
+template<typename T>
+class ObjectFactory {
+public:
+	using create_method_t = std::function<std::shared_ptr<T>(const YAML::Node&, FactoryContext&)>;
+
+	ObjectFactory() = default;
+	~ObjectFactory() = default;
+
+	static bool add(const std::string& name, create_method_t create_method) {
+		auto it = createMethods().find(name);
+		if (it == createMethods().end()) {
+			createMethods()[name] = create_method;
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Create an object by name.
+	 * @param name The name of the object type.
+	 * @param configuration The configuration to pass to the create method.
+	 * @param context The context to pass to the create method.
+	 * @return The object on success, nullptr if no type is registered with this name.
+	 */
+	static std::shared_ptr<T> create(const std::string& name, const YAML::Node& configuration, FactoryContext& context) {
+		auto it = createMethods().find(name);
+		if (it != createMethods().end()) {
+			return it->second(configuration, context);
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief The names of the registered types.
+	 * @return The names.
+	 */
+	static std::vector<std::string> names() {
+		std::vector<std::string> names;
+		for(const auto& method: createMethods()) {
+			names.push_back(method.first);
+		}
+		return names;
+	}
+
+private:
+	// Defined and instantiated in controller_factory.cpp, where the built-in types are registered
+	static std::map<std::string, create_method_t>& createMethods();
+};
+
+using ConstraintFactory = ObjectFactory<Constraint>;
+using ForceGeneratorFactory = ObjectFactory<ForceGenerator>;
+using TorqueGeneratorFactory = ObjectFactory<TorqueGenerator>;
+using VelocityGeneratorFactory = ObjectFactory<VelocityGenerator>;
+using JointVelocityGeneratorFactory = ObjectFactory<JointVelocityGenerator>;
+using InterpolatorFactory = ObjectFactory<Interpolator>;
+
+template<typename T>
+std::shared_ptr<T> FactoryContext::create(const YAML::Node& configuration) {
+	if(not configuration) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Missing object configuration"));
+	}
+	auto type = configuration["type"].as<std::string>("");
+	auto object = ObjectFactory<T>::create(type, configuration, *this);
+	if(not object) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Unknown type '" + type + "'"));
+	}
+	return object;
+}
+
+/** @brief Builds the constraints and generators of a SafetyController from its YAML configuration.
+ *  @details The 'controller' section can contain:
+ *  - 'shared_parameters': a map of named scalar parameters that can be used by several objects and modified at runtime through the returned ParameterBlock,
+ *  - 'constraints', 'force_generators', 'torque_generators', 'velocity_generators' and 'joint_velocity_generators': lists of objects,
+ *  each one with a 'name', a 'type' and the fields specific to its type.
+ *
+ *  The built-in types and their fields (optional ones in brackets) are:
+ *  - constraints: velocity (maximum_velocity), acceleration (maximum_acceleration), power (maximum_power), kinetic_energy (mass, maximum_kinetic_energy),
+ *  force (maximum_force, constraint: a velocity constraint), emergency_stop (activation_force_threshold, deactivation_force_threshold, [activation_torque_threshold,
+ *  deactivation_torque_threshold, check: force, torque or both]), joint_velocity (maximum_velocities), joint_acceleration (maximum_accelerations),
+ *  joint_position (lower_positions, upper_positions), separation_distance (constraint, interpolator, [robot_position, objects: list of name and position]),
+ *  collaborative_mode (mode: monitored_stop, hand_guiding, speed_and_separation or power_and_force, [separation_distance, robot_mass, body_regions: list of names,
+ *  hand_guiding_velocity, human_velocity, reaction_time, stopping_time, maximum_deceleration, intrusion_distance, maximum_separation_distance,
+ *  transient_contact_factor, minimum_robot_mass]),
+ *  - force generators: force_proxy ([force, frame]), external_force, mass (mass, target_acceleration, [mass_frame, target_acceleration_frame]),
+ *  stiffness (stiffness, target_position, [frame]), potential_field ([frame, offset, objects: list of name, type (attractive or repulsive), gain, threshold_distance and position]),
+ *  - torque generators: torque_proxy ([torque]),
+ *  - velocity generators: velocity_proxy ([velocity, frame]), force_control (target, p_gain, d_gain, selection, [frame, target_type: environment or robot, filter_time_constant]),
+ *  - joint velocity generators: joint_velocity_proxy ([velocity]), null_space_motion ([velocity]),
+ *  - interpolators: linear (from: [x, y], to: [x, y], [input, saturation]), polynomial (from: [x, y, dy, d2y], to: [x, y, dy, d2y], [input]).
+ *
+ *  The output of an interpolator can be used as an input by the following objects, under the interpolator 'name'. The interpolator of a
+ *  separation_distance constraint is named after the constraint by default, so that its nested constraint can use it, e.g.:
+ *  @code
+ *  controller:
+ *    shared_parameters:
+ *      max_force: 30
+ *    constraints:
+ *      - name: separation
+ *        type: separation_distance
+ *        interpolator: {type: linear, from: [0.1, 0.], to: [0.5, 0.2], saturation: true}
+ *        constraint: {type: velocity, maximum_velocity: separation}
+ *      - name: stop
+ *        type: emergency_stop
+ *        activation_force_threshold: max_force
+ *        deactivation_force_threshold: 5
+ *  @endcode
+ */
+class ControllerFactory {
+public:
+	/**
+	 * @brief Create the objects described in the configuration and add them to the controller. Throws std::runtime_error on invalid configurations.
+	 * @param controller The controller to fill.
+	 * @param robot The robot used by the controller.
+	 * @param configuration The configuration, with a 'controller' section.
+	 * @param sample_time The controller sample time.
+	 * @return The block holding the scalar parameters of all the created objects.
+	 */
+	static ParameterBlockPtr build(SafetyController& controller, RobotPtr robot, const YAML::Node& configuration, double sample_time);
+};
+
+} // namespace phri
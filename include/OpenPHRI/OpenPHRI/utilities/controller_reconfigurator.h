@@ -0,0 +1,166 @@
+/*      File: controller_reconfigurator.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file controller_reconfigurator.h
+ * @author Benjamin Navarro
+ * @brief Definition of the ControllerReconfigurator class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/robot.h>
+#include <OpenPHRI/safety_controller.h>
+#include <OpenPHRI/utilities/parameter_block.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace phri {
+
+/** @brief Reconfigures a SafetyController online, without blocking its control loop.
+ *  @details A new configuration is parsed and built by a background thread in a staging controller: its damped least squares parameters are read
+ *  from the 'controller' section, as in SafetyController(RobotPtr, YAML::Node&), and its constraints and generators are created by a user provided builder.
+ *  The staging controller is then published and swapped in by the control thread on the next call to update(), which only exchanges pointers
+ *  (read-copy-update): no parsing, allocation or deallocation happens on the control thread. The previous configuration is destroyed by the background thread.
+ *  update() must be called at a cycle boundary, i.e. before SafetyController::compute(), from the thread calling it.
+ *  The parameter block returned by the builder is published with the configuration, see parameters().
+ */
+class ControllerReconfigurator {
+public:
+	/**
+	 * @brief Function creating the constraints and generators of a new configuration and adding them to the given (staging) controller.
+	 * @details Called from the background thread. Can throw to reject the configuration. Returns the block holding the parameters of the
+	 * created objects (e.g. the one returned by ControllerFactory::build()), or a null pointer.
+	 */
+	using Builder = std::function<ParameterBlockPtr(SafetyController& controller, const YAML::Node& configuration)>;
+
+	/**
+	 * @brief Construct a reconfigurator for the given controller and start its background thread.
+	 * @param controller The controller to reconfigure.
+	 * @param robot The robot used by the controller.
+	 * @param parameters The parameter block of the current configuration of the controller, if any.
+	 */
+	ControllerReconfigurator(SafetyControllerPtr controller, RobotPtr robot, ParameterBlockPtr parameters = nullptr);
+
+	/**
+	 * @brief Stop the background thread and destroy the configurations not swapped in.
+	 */
+	~ControllerReconfigurator();
+
+	ControllerReconfigurator(const ControllerReconfigurator&) = delete;
+	ControllerReconfigurator& operator=(const ControllerReconfigurator&) = delete;
+
+	/**
+	 * @brief Set the function creating the constraints and generators of the new configurations.
+	 * @param builder The builder. If not set, the new configurations only hold the default constraint.
+	 */
+	void setBuilder(Builder builder);
+
+	/**
+	 * @brief Request a reconfiguration. The configuration is built asynchronously and replaces any configuration requested but not swapped in yet.
+	 * @param configuration The new configuration. It is cloned so it can be modified afterwards.
+	 */
+	void reconfigure(const YAML::Node& configuration);
+
+	/**
+	 * @brief Request a reconfiguration from a file, parsed by the background thread.
+	 * @param configuration_file The path to the YAML configuration file.
+	 */
+	void reconfigureFromFile(const std::string& configuration_file);
+
+	/**
+	 * @brief Swap in the last built configuration, if any. Lock-free and allocation-free, to be called by the control thread before SafetyController::compute().
+	 * @return True if the controller has been reconfigured, false otherwise.
+	 */
+	bool update();
+
+	/**
+	 * @brief Block until all the requested configurations have been built (or rejected). Not to be called from the control thread.
+	 */
+	void waitUntilBuilt();
+
+	/**
+	 * @brief The number of configurations swapped in by update().
+	 * @return The reconfiguration count.
+	 */
+	size_t reconfigurationCount() const;
+
+	/**
+	 * @brief The parameter block of the configuration currently used by the controller, i.e. the one returned by the builder of the last
+	 * configuration swapped in by update(). Not to be called from the control thread.
+	 * @return The parameter block, or a null pointer if the builder didn't return one.
+	 */
+	ParameterBlockPtr parameters() const;
+
+	/**
+	 * @brief The error message of the last rejected configuration.
+	 * @return The message, or an empty string if no configuration has been rejected.
+	 */
+	std::string lastError() const;
+
+private:
+	struct Request {
+		YAML::Node configuration;
+		std::string file;
+	};
+
+	// After the swap, the controller holds the previous items but the parameters are still the new ones, until the background thread publishes them
+	struct Configuration {
+		std::unique_ptr<SafetyController> controller;
+		ParameterBlockPtr parameters;
+	};
+
+	void process();
+	void build(const Request& request);
+
+	SafetyControllerPtr controller_;
+	RobotPtr robot_;
+
+	// Configuration built and waiting to be swapped in, and previous configuration waiting to be destroyed
+	std::atomic<Configuration*> pending_;
+	std::atomic<Configuration*> retired_;
+	std::atomic<size_t> reconfiguration_count_;
+	ParameterBlockPtr parameters_;
+
+	mutable std::mutex mutex_;
+	std::condition_variable cv_;
+	std::unique_ptr<Request> request_;
+	Builder builder_;
+	std::string last_error_;
+	bool building_;
+	bool stop_;
+	std::thread thread_;
+};
+
+using ControllerReconfiguratorPtr = std::shared_ptr<ControllerReconfigurator>;
+using ControllerReconfiguratorConstPtr = std::shared_ptr<const ControllerReconfigurator>;
+
+} // namespace phri
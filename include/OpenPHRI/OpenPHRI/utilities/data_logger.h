@@ -30,9 +30,14 @@
 
 #include <OpenPHRI/type_aliases.h>
 #include <OpenPHRI/robot.h>
+#include <OpenPHRI/utilities/clock.h>
+#include <OpenPHRI/utilities/binary_log.h>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <fstream>
 #include <sstream>
+#include <thread>
 
 namespace phri {
 
@@ -58,6 +63,79 @@ public:
 		bool delay_disk_write = false);
 	~DataLogger();
 
+	/**
+	 * Log all the data in a single binary file (log_data.bin) instead of one text file per data.
+	 * process() then only copies the values to a ring buffer, the file being written by a background thread.
+	 * The data to log is fixed on the first call to process(). If it changes afterwards because the logged SafetyController
+	 * is reconfigured, the logging continues in a new file (log_data_<n>.bin).
+	 * Must be called before adding data to log.
+	 * @param buffer_cycles Number of cycles the ring buffer can hold. Cycles are dropped if the disk can't keep up (default = 4096)
+	 * @param chunk_rows    Number of cycles stored in each chunk of the file (default = 1024)
+	 * @param append        Append to an existing file logging the same data instead of overwriting it (default = false)
+	 */
+	void enableBinaryMode(size_t buffer_cycles = 4096, size_t chunk_rows = 1024, bool append = false);
+
+	/**
+	 * Number of cycles that couldn't be logged in binary mode because the ring buffer was full
+	 * @return The number of dropped cycles
+	 */
+	uint64_t droppedCycles() const;
+
+	/**
+	 * Log a given data only once every factor cycles. Cycles are not decimated while a trigger is active.
+	 * In binary mode, only the default decimation is used since all the data share the same rows.
+	 * @param data_name The name of the data
+	 * @param factor    The decimation factor. 1 logs every cycle, 0 only logs while a trigger is active.
+	 */
+	void setDecimation(const std::string& data_name, size_t factor);
+
+	/**
+	 * Set the decimation factor of the data without a specific one, see setDecimation (default = 1)
+	 * @param factor The decimation factor
+	 */
+	void setDefaultDecimation(size_t factor);
+
+	/**
+	 * Add a condition evaluated on each cycle. While a trigger is active all the data is logged at full rate and,
+	 * when one becomes active, the black box is written to the disk.
+	 * @param name      The name of the trigger
+	 * @param condition The function telling if the trigger is active
+	 */
+	void addTrigger(const std::string& name, const std::function<bool(void)>& condition);
+
+	/**
+	 * Add a trigger active while a constraint of the logged SafetyController is below a threshold (e.g. an emergency stop)
+	 * @param constraint The name of the constraint. An empty name means any constraint.
+	 * @param threshold  The threshold (default = 1)
+	 */
+	void addConstraintTrigger(const std::string& constraint = "", double threshold = 1.);
+
+	/**
+	 * Remove a previously added trigger
+	 * @param name The name of the trigger
+	 */
+	void removeTrigger(const std::string& name);
+
+	/**
+	 * Tell if a trigger was active during the last cycle
+	 * @return True if triggered
+	 */
+	bool isTriggered() const;
+
+	/**
+	 * Keep the last cycles of all the data in memory, at full rate, and write them to a binary file (log_blackbox_<n>.bin)
+	 * each time a trigger becomes active. The file is written by a background thread. The history is restarted if the logged data changes.
+	 * @param duration    The duration of the recorded history
+	 * @param sample_time The time between two calls to process
+	 */
+	void enableBlackBox(double duration, double sample_time);
+
+	/**
+	 * Number of black box files written so far
+	 * @return The number of files
+	 */
+	size_t blackBoxFlushes() const;
+
 	/**
 	 * Log all the data related to a SafetyController (inputs, constraints, intermediate computation)
 	 * @param controller Pointer to a SafetyController object
@@ -68,6 +146,11 @@ public:
 	 * @param robot A shared pointer to a Robot object
 	 */
 	void logRobotData(RobotConstPtr robot);
+	/**
+	 * Log the nominal time, measured time and cycle time of a Clock, to spot the slipped cycles
+	 * @param clock A shared pointer to a Clock object
+	 */
+	void logClockData(ClockConstPtr clock);
 
 	/**
 	 * Log any array of data
@@ -77,7 +160,7 @@ public:
 	 */
 	template<typename T>
 	void logExternalData(const std::string& data_name, const T* data, size_t data_count) {
-		external_data_[&createLog(data_name, data_count)] = std::make_unique<external_data_t<T>>(data, data_count);
+		external_data_[&createLog(data_name, data_count)] = std::make_unique<external_data_t<T>>(data_name, data, data_count);
 	}
 
 	/**
@@ -110,6 +193,17 @@ private:
 	std::ostream& getStream(std::ofstream& file);
 	void logData(std::ofstream& file, const double* data, size_t data_count);
 	void logData(std::ofstream& file, const external_data& data);
+	bool isLogged(const std::string& data_name) const;
+	void collectChannels();
+	void updateChannels();
+	void fillRow(double* row) const;
+	void startBinaryLog();
+	void waitBinaryWriterClosing();
+	void processBinary();
+	void recordBlackBox();
+	void flushBlackBox();
+	void waitBlackBoxWriter();
+	size_t controllerItemCount() const;
 
 	SafetyController* controller_;
 	std::string directory_;
@@ -118,19 +212,23 @@ private:
 	bool delay_disk_write_;
 
 	RobotConstPtr robot_;
+	ClockConstPtr clock_;
 
 	struct external_data {
 		external_data() = default;
 		virtual ~external_data() = default;
+		std::string name;
 		const void* data;
 		size_t size;
 
 		virtual void write(std::ostream& stream) const = 0;
+		virtual void copyTo(double* values) const = 0;
 	};
 
 	template<typename T>
 	struct external_data_t : virtual public external_data {
-		external_data_t(const T* data, size_t size) {
+		external_data_t(const std::string& name, const T* data, size_t size) {
+			this->name = name;
 			this->data = static_cast<const void*>(data);
 			this->size = size;
 		}
@@ -142,11 +240,56 @@ private:
 			}
 			stream << ptr[size-1] << '\n';
 		}
+
+		virtual void copyTo(double* values) const override {
+			auto ptr = static_cast<const T*>(data);
+			for (size_t i = 0; i < size; ++i) {
+				values[i] = static_cast<double>(ptr[i]);
+			}
+		}
+	};
+
+	struct binary_channel {
+		const double* data;
+		const external_data* external;
+		size_t size;
 	};
 
 	std::map<std::string, std::ofstream> log_files_;
 	std::map<std::ofstream*, std::stringstream> stored_data_;
 	std::map<std::ofstream*, std::unique_ptr<external_data>> external_data_;
+
+	bool binary_mode_;
+	size_t binary_buffer_cycles_;
+	size_t binary_chunk_rows_;
+	bool binary_append_;
+	std::unique_ptr<BinaryLogWriter> binary_writer_;
+	std::thread binary_writer_closing_;
+	std::vector<BinaryLogSignal> binary_signals_;
+	std::vector<binary_channel> binary_channels_;
+	size_t binary_row_size_;
+	size_t binary_controller_items_;
+	size_t binary_controller_version_;
+	size_t binary_file_index_;
+	bool channels_collected_;
+
+	uint64_t cycle_;
+	size_t default_decimation_;
+	std::map<std::string, size_t> decimations_;
+	std::map<std::string, std::function<bool(void)>> triggers_;
+	bool triggered_;
+
+	struct black_box {
+		std::vector<double> rows;
+		size_t count;
+		size_t next;
+	};
+	size_t black_box_capacity_;
+	black_box black_box_;
+	black_box black_box_spare_;
+	std::thread black_box_writer_;
+	std::atomic<bool> black_box_writing_;
+	size_t black_box_flushes_;
 };
 
 using DataLoggerPtr = std::shared_ptr<DataLogger>;
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <OpenPHRI/definitions.h>
+#include <OpenPHRI/utilities/state_snapshot.h>
 
 namespace phri {
 
@@ -118,6 +119,24 @@ public:
 		return compute();
 	}
 
+	/**
+	 * @brief Write the derivator state to a snapshot.
+	 * @param writer The writer to use.
+	 */
+	void saveState(StateWriter& writer) const {
+		writer.writeValue(previous_input_);
+		writer.writeValue(*output_);
+	}
+
+	/**
+	 * @brief Restore a state written by saveState().
+	 * @param reader The reader to use.
+	 */
+	void restoreState(StateReader& reader) {
+		reader.readValue(previous_input_);
+		reader.readValue(*output_);
+	}
+
 private:
 	std::shared_ptr<const T> input_;
 	std::shared_ptr<T> output_;
@@ -0,0 +1,140 @@
+/*      File: joint_limits.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file joint_limits.h
+ * @author Benjamin Navarro
+ * @brief Definition of the JointLimits class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+
+namespace phri {
+
+/** @brief Hold the position, velocity and force limits of all the joints and provide vectorized queries on them.
+ *  @details The limits are stored in a single contiguous block with one column per type of limit so that each query only touches contiguous memory.
+ */
+class JointLimits {
+public:
+	using Limits = Eigen::Matrix<double, Eigen::Dynamic, 4>;
+	using ConstLimit = Limits::ConstColXpr;
+	using Limit = Limits::ColXpr;
+
+	JointLimits() = default;
+
+	/**
+	 * @brief Construct unbounded limits for the given number of joints.
+	 * @param joint_count The number of joints.
+	 */
+	explicit JointLimits(size_t joint_count);
+
+	/**
+	 * @brief Construct the limits from the given vectors. All vectors must have the same size.
+	 * @param lower_positions The joints' minimum positions.
+	 * @param upper_positions The joints' maximum positions.
+	 * @param velocities The joints' maximum velocities.
+	 * @param forces The joints' maximum forces/torques.
+	 */
+	JointLimits(
+		const VectorXd& lower_positions,
+		const VectorXd& upper_positions,
+		const VectorXd& velocities,
+		const VectorXd& forces);
+
+	~JointLimits() = default;
+
+	size_t jointCount() const;
+
+	ConstLimit lowerPositions() const;
+	ConstLimit upperPositions() const;
+	ConstLimit velocities() const;
+	ConstLimit forces() const;
+
+	Limit lowerPositions();
+	Limit upperPositions();
+	Limit velocities();
+	Limit forces();
+
+	/**
+	 * @brief Saturate the given positions to the [lower, upper] interval.
+	 * @param position [in,out] The positions to saturate.
+	 */
+	void clampPosition(VectorXd& position) const;
+
+	/**
+	 * @brief Saturate the given velocities to the [-max, max] interval.
+	 * @param velocity [in,out] The velocities to saturate.
+	 */
+	void clampVelocity(VectorXd& velocity) const;
+
+	/**
+	 * @brief Compute the distance between the given positions and the lower limits (positive inside the limits).
+	 * @param position [in] The current positions.
+	 * @param distance [out] The distance to the lower limits.
+	 */
+	void distanceToLowerLimits(const VectorXd& position, VectorXd& distance) const;
+
+	/**
+	 * @brief Compute the distance between the given positions and the upper limits (positive inside the limits).
+	 * @param position [in] The current positions.
+	 * @param distance [out] The distance to the upper limits.
+	 */
+	void distanceToUpperLimits(const VectorXd& position, VectorXd& distance) const;
+
+	/**
+	 * @brief Compute the distance between the given positions and the closest limits (positive inside the limits).
+	 * @param position [in] The current positions.
+	 * @param distance [out] The distance to the closest limits.
+	 */
+	void distanceToLimits(const VectorXd& position, VectorXd& distance) const;
+
+	/**
+	 * @brief Tell if all the given positions are within the limits.
+	 * @param position The positions to check.
+	 * @return True if all positions are inside the limits, false otherwise.
+	 */
+	bool isInsidePositionLimits(const VectorXd& position) const;
+
+	/**
+	 * @brief Tell if all the given velocities are within the limits.
+	 * @param velocity The velocities to check.
+	 * @return True if all velocities are inside the limits, false otherwise.
+	 */
+	bool isInsideVelocityLimits(const VectorXd& velocity) const;
+
+private:
+	enum LimitIndex {
+		LowerPosition = 0,
+		UpperPosition,
+		Velocity,
+		Force
+	};
+
+	Limits limits_;
+};
+
+using JointLimitsPtr = std::shared_ptr<JointLimits>;
+using JointLimitsConstPtr = std::shared_ptr<const JointLimits>;
+
+} // namespace phri
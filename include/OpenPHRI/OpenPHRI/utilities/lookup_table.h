@@ -0,0 +1,78 @@
+/*      File: lookup_table.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file lookup_table.h
+ * @author Benjamin Navarro
+ * @brief Definition of the LookupTable class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+
+#include <functional>
+#include <vector>
+
+namespace phri {
+
+/** @brief A function sampled on a regular grid and evaluated by linear interpolation, to replace costly computations in the control loop.
+ *  @details The inputs outside of the sampled range are clamped to it. The interpolation underestimates concave functions,
+ *  which can be used to get conservative limits by choosing the table input accordingly.
+ */
+class LookupTable {
+public:
+	/**
+	 * @brief Construct an empty table, always returning zero.
+	 */
+	LookupTable();
+
+	/**
+	 * @brief Construct a table by sampling a function.
+	 * @param function The function to sample.
+	 * @param min_input The first sampled input.
+	 * @param max_input The last sampled input. Must be greater than min_input.
+	 * @param size The number of samples. At least 2.
+	 */
+	LookupTable(const std::function<double(double)>& function, double min_input, double max_input, size_t size);
+
+	~LookupTable() = default;
+
+	/**
+	 * @brief Evaluate the table.
+	 * @param input The input value.
+	 * @return The interpolated value.
+	 */
+	double operator()(double input) const;
+
+	double minInput() const;
+	double maxInput() const;
+	size_t size() const;
+
+private:
+	double min_input_;
+	double max_input_;
+	double inverse_step_;
+	std::vector<double> values_;
+};
+
+} // namespace phri
@@ -0,0 +1,156 @@
+/*      File: loop_runner.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file loop_runner.h
+ * @author Benjamin Navarro
+ * @brief Definition of the LoopRunner class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace phri {
+
+/** @brief Periodic execution of a control loop with deadline tracking.
+ *  @details The loop is paced with absolute deadlines (clock_nanosleep on CLOCK_MONOTONIC) so that the computation time doesn't make the
+ *  period drift. The calling thread can optionally be given a SCHED_FIFO priority and a CPU affinity and the process memory can be locked.
+ *  The cycle overruns, the missed periods and the wake up jitter are tracked and can be queried from another thread while the loop runs.
+ *  The statistics are published under a sequence lock, so reading them never blocks the loop thread.
+ */
+class LoopRunner {
+public:
+	/** @brief Real time configuration of the loop.
+	 */
+	struct Options {
+		/** SCHED_FIFO priority (1-99) given to the thread running the loop. Zero keeps the current scheduling policy. */
+		int priority = 0;
+		/** CPU on which the loop runs. A negative value keeps the current affinity. */
+		int cpu = -1;
+		/** Lock the current and future memory pages of the process to avoid page faults during the loop. */
+		bool lock_memory = false;
+		/** Sleep until the next deadline after each cycle. Disable it if the cycle is already paced, e.g. by a driver waiting for the next sample in read().
+		 * The overruns, the missed periods and the jitter are then not tracked. */
+		bool pace = true;
+		/** Number of bins of the jitter histogram. The last one gathers all the greater values. */
+		size_t histogram_bins = 100;
+		/** Width, in seconds, of the jitter histogram bins. */
+		double histogram_resolution = 10e-6;
+	};
+
+	/** @brief Timing statistics of the loop.
+	 */
+	struct Statistics {
+		/** Number of executed cycles. */
+		uint64_t cycles = 0;
+		/** Number of cycles whose computation took longer than the period. */
+		uint64_t overruns = 0;
+		/** Number of periods skipped to catch up after overruns. */
+		uint64_t missed_periods = 0;
+		/** Duration of the last cycle computation, in seconds. */
+		double last_cycle_duration = 0.;
+		/** Longest cycle computation, in seconds. */
+		double max_cycle_duration = 0.;
+		/** Mean delay between the deadlines and the actual wake ups, in seconds. */
+		double mean_jitter = 0.;
+		/** Largest delay between a deadline and the actual wake up, in seconds. */
+		double max_jitter = 0.;
+		/** Histogram of the wake up delays, see Options::histogram_resolution. */
+		std::vector<uint64_t> jitter_histogram;
+	};
+
+	/**
+	 * @brief Construct a loop runner with the default options (no real time configuration).
+	 * @param period The loop period, in seconds.
+	 */
+	explicit LoopRunner(double period);
+
+	/**
+	 * @brief Construct a loop runner.
+	 * @param period The loop period, in seconds.
+	 * @param options The real time configuration.
+	 */
+	LoopRunner(double period, const Options& options);
+	~LoopRunner() = default;
+
+	/**
+	 * @brief Run the loop in the calling thread until stop() is called, a cycle returns false or max_cycles cycles have been executed.
+	 * If stop() has been called before, the loop returns immediately, see reset().
+	 * @details The real time configuration is applied to the calling thread at the start and the previous scheduling policy and affinity
+	 * are restored at the end. A configuration that cannot be applied (e.g. insufficient privileges) only prints a warning.
+	 * @param cycle The code executed at each period. Must return true to continue the loop.
+	 * @param max_cycles The maximum number of cycles to execute. Zero means no limit.
+	 * @return False if a cycle returned false, true otherwise.
+	 */
+	bool run(const std::function<bool(void)>& cycle, uint64_t max_cycles = 0);
+
+	/**
+	 * @brief Request the loop to stop after the current cycle. Can be called from another thread or a signal handler, before or during run().
+	 */
+	void stop();
+
+	/**
+	 * @brief Clear a stop request so that the loop can be run again. Not to be called while the loop runs.
+	 */
+	void reset();
+
+	/**
+	 * @brief Get a copy of the current statistics. Can be called from another thread.
+	 * @return The statistics.
+	 */
+	Statistics getStatistics() const;
+
+	/**
+	 * @brief Reset all the statistics. Can be called from another thread, the statistics are then reset at the end of the current cycle.
+	 */
+	void resetStatistics();
+
+	/**
+	 * @brief The loop period.
+	 * @return The period, in seconds.
+	 */
+	double getPeriod() const;
+
+private:
+	void updateStatistics(double jitter, double cycle_duration, bool overrun, uint64_t missed_periods);
+	void clearStatistics();
+
+	double period_;
+	Options options_;
+	std::atomic<bool> stop_requested_;
+
+	// Only written by the thread running the loop, odd while the statistics are being modified
+	std::atomic<uint64_t> statistics_sequence_;
+	std::atomic<bool> reset_requested_;
+	Statistics statistics_;
+	double jitter_sum_;
+};
+
+using LoopRunnerPtr = std::shared_ptr<LoopRunner>;
+using LoopRunnerConstPtr = std::shared_ptr<const LoopRunner>;
+
+} // namespace phri
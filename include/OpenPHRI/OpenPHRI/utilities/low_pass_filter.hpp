@@ -9,6 +9,7 @@
 #pragma once
 
 #include <OpenPHRI/type_aliases.h>
+#include <OpenPHRI/utilities/state_snapshot.h>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -85,6 +86,24 @@ public:
         compute();
     }
 
+    /**
+     * @brief Write the filter state to a snapshot.
+     * @param writer The writer to use.
+     */
+    void saveState(StateWriter& writer) const {
+        writer.writeValue(previous_input_);
+        writer.writeValue(*output_);
+    }
+
+    /**
+     * @brief Restore a state written by saveState().
+     * @param reader The reader to use.
+     */
+    void restoreState(StateReader& reader) {
+        reader.readValue(previous_input_);
+        reader.readValue(*output_);
+    }
+
 private:
     input_type input_;
     T previous_input_;
@@ -31,11 +31,16 @@
 #include <OpenPHRI/definitions.h>
 #include <OpenPHRI/utilities/object_collection.hpp>
 
+#include <Eigen/Cholesky>
+
 namespace phri {
 
 /** @brief A utility to compute a manipulator's equivalent mass.
  *  @details Based on the manipulator's inertia matrix and Jacobian and a set of items that can collide with the its TCP.
- *  @tparam joint_count Number of joints of the manipulator.
+ *  The equivalent mass along the direction u of the closest item is m = 1 / (u^T J M^-1 J^T u), with J the translational part of the Jacobian
+ *  and M the inertia matrix. M^-1 J^T u is obtained by a Cholesky (LLT) solve, the decomposition being reused as long as the inertia matrix doesn't change,
+ *  and all the buffers are reused between the calls. If there is no item, the largest equivalent mass over all the directions is used.
+ *  If the inertia matrix is not positive definite, the equivalent mass is set to infinity.
  */
 class ManipulatorEquivalentMass : public ObjectCollection<Vector6dConstPtr> {
 public:
@@ -82,12 +87,20 @@ public:
 	virtual double operator()() final;
 
 private:
-	Vector3d closestObjectDirection();
+	bool closestObjectDirection(Vector3d& direction) const;
+	bool updateDecomposition();
 
 	MatrixXdConstPtr inertia_matrix_;
 	MatrixXdConstPtr jacobian_matrix_;
 	Vector6dConstPtr robot_position_;
 	doublePtr mass_;
+
+	Eigen::LLT<MatrixXd> inertia_decomposition_;
+	MatrixXd decomposed_inertia_;   // Inertia matrix used for the current decomposition
+	bool decomposition_valid_;
+	VectorXd projected_jacobian_;
+	VectorXd solution_;
+	MatrixXd jacobian_solution_;
 };
 
 } // namespace phri
@@ -112,8 +112,9 @@ public:
 	 */
 	virtual void removeAll() {
 		// items_.clear(); Don't do that, the erase method can be overrided, and for a good reason!
-		for(const auto& item: items_) {
-			remove(item.first);
+		// remove() invalidates the iterators, so always remove the first item. The name is copied since the key is destroyed by remove()
+		while(not items_.empty()) {
+			remove(std::string(items_.begin()->first));
 		}
 	}
 
@@ -134,6 +135,14 @@ public:
 		return item;
 	}
 
+	/**
+	 * @brief Exchange the items with the ones of another collection, without copying or allocating memory.
+	 * @param other The other collection.
+	 */
+	void swap(ObjectCollection& other) {
+		items_.swap(other.items_);
+	}
+
 	using iterator = typename std::map<std::string,T>::iterator;
 	using const_iterator = typename std::map<std::string,T>::const_iterator;
 
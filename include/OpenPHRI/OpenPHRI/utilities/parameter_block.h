@@ -0,0 +1,111 @@
+/*      File: parameter_block.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file parameter_block.h
+ * @author Benjamin Navarro
+ * @brief Definition of the ParameterBlock class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace phri {
+
+/** @brief Contiguous storage for scalar parameters (thresholds, gains, limits, etc).
+ *  @details The parameters are handed out as shared pointers aliasing a single fixed-size allocation so that all the parameters of a controller
+ *  are close in memory. The pointers stay valid as long as one of them, or the block, is alive. Named parameters can be shared by several objects
+ *  and modified at runtime through get().
+ */
+class ParameterBlock {
+public:
+	/**
+	 * @brief Construct a block that can hold up to capacity parameters.
+	 * @param capacity The maximum number of parameters.
+	 */
+	explicit ParameterBlock(size_t capacity);
+
+	~ParameterBlock() = default;
+
+	/**
+	 * @brief Add an anonymous parameter. Throws std::length_error if the block is full.
+	 * @param value The initial value.
+	 * @return A pointer to the parameter.
+	 */
+	doublePtr add(double value);
+
+	/**
+	 * @brief Add a named parameter. Throws std::length_error if the block is full and std::runtime_error if the name is already used.
+	 * @param name The name of the parameter.
+	 * @param value The initial value.
+	 * @return A pointer to the parameter.
+	 */
+	doublePtr add(const std::string& name, double value);
+
+	/**
+	 * @brief Retrieve a named parameter. Throws std::domain_error if there is no such parameter.
+	 * @param name The name of the parameter.
+	 * @return A pointer to the parameter.
+	 */
+	doublePtr get(const std::string& name) const;
+
+	/**
+	 * @brief Tell if a named parameter exists.
+	 * @param name The name of the parameter.
+	 * @return True if it exists, false otherwise.
+	 */
+	bool has(const std::string& name) const;
+
+	/**
+	 * @brief The number of parameters in the block.
+	 * @return The parameter count.
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief The maximum number of parameters in the block.
+	 * @return The capacity.
+	 */
+	size_t capacity() const;
+
+	/**
+	 * @brief The parameter values, in the order they were added.
+	 * @return A pointer to the first value.
+	 */
+	const double* data() const;
+
+private:
+	std::shared_ptr<std::vector<double>> storage_;
+	size_t size_;
+	std::map<std::string, size_t> names_;
+};
+
+using ParameterBlockPtr = std::shared_ptr<ParameterBlock>;
+using ParameterBlockConstPtr = std::shared_ptr<const ParameterBlock>;
+
+} // namespace phri
@@ -0,0 +1,119 @@
+/*      File: point_cloud.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file point_cloud.h
+ * @author Benjamin Navarro
+ * @brief Definition of the PointCloud class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace phri {
+
+/** @brief A set of obstacle points (e.g. from a depth sensor) stored as a contiguous 3xN matrix, with optional voxel downsampling.
+ *  @details The points are replaced all at once with update(), which swaps the buffers to avoid copies and allocations:
+ *  @code
+ *  Matrix3Xd points(3, point_count);
+ *  // fill points
+ *  cloud->update(points); // points now holds the previous cloud and can be refilled
+ *  @endcode
+ *  As for the other inputs (poses, gains, etc), update() must not be called while the objects using the cloud are computed.
+ *  With a voxel size, each occupied voxel is replaced by the centroid of its points, bounding the number of points and so the cost of the distance computations.
+ *  The resulting distance error is at most the voxel diagonal.
+ */
+class PointCloud {
+public:
+	/**
+	 * @brief Construct an empty point cloud.
+	 * @param voxel_size The size of the voxels used for the downsampling. Zero to keep all the points.
+	 */
+	explicit PointCloud(double voxel_size = 0.);
+	~PointCloud() = default;
+
+	/**
+	 * @brief Replace the points of the cloud. The points are downsampled if a voxel size is set.
+	 * @param points The new points, swapped with the previous ones.
+	 */
+	void update(Matrix3Xd& points);
+
+	/**
+	 * @brief Set the size of the voxels used for the downsampling. Applies to the next update.
+	 * @param voxel_size The voxel size. Zero to keep all the points.
+	 */
+	void setVoxelSize(double voxel_size);
+
+	/**
+	 * @brief The size of the voxels used for the downsampling.
+	 * @return The voxel size.
+	 */
+	double voxelSize() const;
+
+	/**
+	 * @brief The points of the cloud, after downsampling.
+	 * @return The points, one per column.
+	 */
+	const Matrix3Xd& points() const;
+
+	/**
+	 * @brief The number of points in the cloud, after downsampling.
+	 * @return The point count.
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Compute the distance from a given point to the closest point of the cloud.
+	 * @param point The point, in the same frame as the cloud.
+	 * @return The distance, or infinity if the cloud is empty.
+	 */
+	double closestDistance(const Vector3d& point) const;
+
+	/**
+	 * @brief Compute the repulsive force applied by the points of the cloud closer than a threshold distance, as for a repulsive PotentialFieldObject.
+	 * @param point The point the force applies to, in the same frame as the cloud.
+	 * @param gain The gain of the repulsive force.
+	 * @param threshold_distance The distance under which the points are repulsive.
+	 * @return The total repulsive force.
+	 */
+	Vector3d repulsiveForce(const Vector3d& point, double gain, double threshold_distance) const;
+
+private:
+	void downsample();
+
+	double voxel_size_;
+	Matrix3Xd points_;
+
+	// Buffers reused across the updates and computations
+	Matrix3Xd downsampled_points_;
+	std::vector<std::pair<uint64_t, Eigen::Index>> voxels_;
+	mutable Eigen::RowVectorXd distances_;
+};
+
+using PointCloudPtr = std::shared_ptr<PointCloud>;
+using PointCloudConstPtr = std::shared_ptr<const PointCloud>;
+
+} // namespace phri
@@ -0,0 +1,113 @@
+/*      File: robot_geometry.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file robot_geometry.h
+ * @author Benjamin Navarro
+ * @brief Definition of the RobotGeometry class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+
+#include <limits>
+#include <vector>
+
+namespace phri {
+
+/** @brief An approximation of the robot links by capsules (segments with a radius) and spheres, to compute the distance between the robot and a set of points.
+ *  @details The capsules are defined between the origins of two links, given by a matrix of link positions such as RobotModel::getLinkPositions():
+ *  @code
+ *  auto geometry = make_shared<RobotGeometry>(model->getLinkPositions());
+ *  geometry->addCapsule(model->linkIndex("link_2"), model->linkIndex("link_4"), 0.08);
+ *  geometry->addSphere(model->linkIndex("link_7"), 0.1);
+ *  @endcode
+ *  The distances from a capsule to all the points are computed at once, as Eigen array expressions. Capsules whose bounding box is farther from the
+ *  points' bounding box than the closest distance found so far are skipped, starting from the capsule that was the closest one during the previous computation.
+ */
+class RobotGeometry {
+public:
+	/**
+	 * @brief Construct a robot geometry without any capsule.
+	 * @param link_positions The positions of the links, one per column.
+	 */
+	explicit RobotGeometry(Matrix3XdConstPtr link_positions);
+	~RobotGeometry() = default;
+
+	/**
+	 * @brief Add a capsule between the origins of two links.
+	 * @param start_link The index of the first link.
+	 * @param end_link The index of the second link.
+	 * @param radius The radius of the capsule.
+	 */
+	void addCapsule(size_t start_link, size_t end_link, double radius);
+
+	/**
+	 * @brief Add a sphere centered on the origin of a link.
+	 * @param link The index of the link.
+	 * @param radius The radius of the sphere.
+	 */
+	void addSphere(size_t link, double radius);
+
+	/**
+	 * @brief The number of capsules and spheres.
+	 * @return The capsule count.
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Compute the distance between the surface of the capsules and the closest point, or the given bound if it is smaller.
+	 * @param points The points, in the same frame as the link positions, one per column.
+	 * @param bound The current closest distance, e.g. the result for another set of points. Capsules that can't be closer than this bound are skipped.
+	 * @return The distance, zero if a point is inside a capsule, or the bound if no point is closer.
+	 */
+	double distance(const Matrix3Xd& points, double bound = std::numeric_limits<double>::infinity());
+
+	/**
+	 * @brief The index of the capsule that was the closest to the points during the last computation.
+	 * @return The capsule index.
+	 */
+	size_t closestCapsule() const;
+
+private:
+	struct Capsule {
+		size_t start_link;
+		size_t end_link;
+		double radius;
+	};
+
+	double capsuleDistance(const Capsule& capsule, const Matrix3Xd& points);
+
+	Matrix3XdConstPtr link_positions_;
+	std::vector<Capsule> capsules_;
+	size_t closest_capsule_;
+
+	// Buffers reused across the computations
+	Eigen::RowVectorXd projections_;
+	Eigen::RowVectorXd squared_distances_;
+};
+
+using RobotGeometryPtr = std::shared_ptr<RobotGeometry>;
+using RobotGeometryConstPtr = std::shared_ptr<const RobotGeometry>;
+
+} // namespace phri
@@ -2,25 +2,80 @@
 
 #include <OpenPHRI/robot.h>
 #include <OpenPHRI/fwd_decl.h>
+#include <OpenPHRI/utilities/joint_limits.h>
 
 namespace phri {
 
 class RobotModel {
 public:
+	/**
+	 * @brief Construct a robot model from a URDF or YAML file.
+	 * @param robot The robot to update.
+	 * @param model_path The path to the model file, resolved with PID_PATH.
+	 * @param control_point The name of the body used as control point.
+	 * @param cache_directory If not empty, the parsed model is stored in this directory and reloaded from it on subsequent constructions, as long as the model file is unchanged.
+	 */
 	RobotModel(
 		RobotPtr robot,
 		const std::string& model_path,
-		const std::string& control_point);
+		const std::string& control_point,
+		const std::string& cache_directory = "");
+
+	/**
+	 * @brief Construct a robot model using a YAML configuration.
+	 * @details The 'model' section must provide the 'path' and 'control_point' fields and can provide a 'cache_directory' field.
+	 * @param robot The robot to update.
+	 * @param configuration The YAML configuration.
+	 */
 	RobotModel(RobotPtr robot, const YAML::Node& configuration);
 	~RobotModel();
 
 	void forwardKinematics() const;
 
+	/**
+	 * @brief Update the joint space dynamics (inertia matrix, Coriolis and gravity forces).
+	 * @details The inertia matrix (CRBA) and the gravity forces are only recomputed when the joint positions have changed since the last call.
+	 * The Coriolis forces (RNEA) use Robot::jointVelocity, the last velocity sent to the robot, since no measured joint velocity is available.
+	 * The model must provide the links' inertial parameters for the results to be meaningful.
+	 */
+	void updateDynamics() const;
+
+	MatrixXdConstPtr getInertiaMatrix() const;
+	VectorXdConstPtr getCoriolisForces() const;
+	VectorXdConstPtr getGravityForces() const;
+	VectorXdConstPtr getBiasForces() const;
+
 	VectorXdConstPtr getLowerLimits() const;
 	VectorXdConstPtr getUpperLimits() const;
 	VectorXdConstPtr getVelocityLimits() const;
 	VectorXdConstPtr getForceLimits() const;
 
+	/**
+	 * @brief All the joint limits extracted from the model, stored in a single block.
+	 * @return A shared pointer to the limits.
+	 */
+	JointLimitsConstPtr getJointLimits() const;
+
+	/**
+	 * @brief The positions of the origins of all the links of the model, in the base frame, updated by forwardKinematics().
+	 * @return A shared pointer to the positions, one column per link.
+	 */
+	Matrix3XdConstPtr getLinkPositions() const;
+
+	/**
+	 * @brief The transformation from a link frame to the base frame, updated by forwardKinematics(). Throws std::out_of_range if the index is invalid.
+	 * @param link The index of the link, see linkIndex().
+	 * @return A shared pointer to the transformation.
+	 */
+	AffineTransformConstPtr getLinkTransform(size_t link) const;
+
+	/**
+	 * @brief The column of a link in getLinkPositions(). Throws std::runtime_error if the model has no link with this name.
+	 * @param name The name of the link.
+	 * @return The index of the link.
+	 */
+	size_t linkIndex(const std::string& name) const;
+
 	size_t jointCount() const;
 	const std::string& name() const;
 
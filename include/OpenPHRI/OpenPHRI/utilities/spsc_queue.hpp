@@ -0,0 +1,204 @@
+/*      File: spsc_queue.hpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file spsc_queue.hpp
+ * @author Benjamin Navarro
+ * @brief Definition of the SPSCQueue class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include <atomic>
+#include <vector>
+
+namespace phri {
+
+/** @brief A bounded, lock-free, single producer single consumer queue.
+ *  @details All the slots are allocated at construction and copy assigned afterwards, so pushing and popping
+ *  objects of a constant size (e.g. Eigen vectors) does not allocate. push() must only be called from the producer
+ *  thread and pop() only from the consumer one.
+ */
+template<typename T>
+class SPSCQueue {
+public:
+	/**
+	 * @brief Construct a queue able to store a given number of elements.
+	 * @param capacity The maximum number of elements in the queue.
+	 * @param initial_value The value used to initialize all the slots, e.g. to preallocate dynamic vectors.
+	 */
+	explicit SPSCQueue(size_t capacity, const T& initial_value = T()) :
+		buffer_(capacity + 1, initial_value),
+		head_(0),
+		tail_(0)
+	{
+	}
+
+	/**
+	 * @brief Copy an element at the end of the queue. Producer side only.
+	 * @param value The element to push.
+	 * @return True on success, false if the queue is full.
+	 */
+	bool push(const T& value) {
+		auto head = head_.load(std::memory_order_relaxed);
+		auto next_head = increment(head);
+		if(next_head == tail_.load(std::memory_order_acquire)) {
+			return false;
+		}
+		buffer_[head] = value;
+		head_.store(next_head, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Copy the first element of the queue and remove it. Consumer side only.
+	 * @param value [out] The popped element.
+	 * @return True on success, false if the queue is empty.
+	 */
+	bool pop(T& value) {
+		auto tail = tail_.load(std::memory_order_relaxed);
+		if(tail == head_.load(std::memory_order_acquire)) {
+			return false;
+		}
+		value = buffer_[tail];
+		tail_.store(increment(tail), std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Check if the queue is empty. Only accurate from the consumer side.
+	 * @return True if empty, false otherwise.
+	 */
+	bool empty() const {
+		return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief The maximum number of elements in the queue.
+	 * @return The capacity.
+	 */
+	size_t capacity() const {
+		return buffer_.size() - 1;
+	}
+
+private:
+	size_t increment(size_t index) const {
+		return ++index == buffer_.size() ? 0 : index;
+	}
+
+	std::vector<T, Eigen::aligned_allocator<T>> buffer_;
+	// Padded to separate cache lines to avoid false sharing between the producer and the consumer
+	std::atomic<size_t> head_;
+	char padding_[64 - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t> tail_;
+};
+
+/** @brief A bounded, lock-free, single producer single consumer buffer of fixed size records of doubles.
+ *  @details The records are written and read in place: the producer fills the slot given by writeSlot() and publishes it with
+ *  commitWrite(), the consumer reads the slot given by readSlot() and releases it with commitRead(). Nothing is allocated after construction.
+ */
+class SPSCRecordBuffer {
+public:
+	/**
+	 * @brief Construct a buffer able to store a given number of records.
+	 * @param capacity The maximum number of records in the buffer.
+	 * @param record_size The number of doubles in a record.
+	 */
+	SPSCRecordBuffer(size_t capacity, size_t record_size) :
+		buffer_((capacity + 1) * record_size, 0.),
+		record_size_(record_size),
+		slots_(capacity + 1),
+		head_(0),
+		tail_(0)
+	{
+	}
+
+	/**
+	 * @brief The slot in which the next record must be written. Producer side only.
+	 * @return A pointer to the slot, or nullptr if the buffer is full.
+	 */
+	double* writeSlot() {
+		auto head = head_.load(std::memory_order_relaxed);
+		if(increment(head) == tail_.load(std::memory_order_acquire)) {
+			return nullptr;
+		}
+		return buffer_.data() + head * record_size_;
+	}
+
+	/**
+	 * @brief Publish the record written in the slot given by writeSlot(). Producer side only.
+	 */
+	void commitWrite() {
+		head_.store(increment(head_.load(std::memory_order_relaxed)), std::memory_order_release);
+	}
+
+	/**
+	 * @brief The slot holding the oldest record. Consumer side only.
+	 * @return A pointer to the slot, or nullptr if the buffer is empty.
+	 */
+	const double* readSlot() const {
+		auto tail = tail_.load(std::memory_order_relaxed);
+		if(tail == head_.load(std::memory_order_acquire)) {
+			return nullptr;
+		}
+		return buffer_.data() + tail * record_size_;
+	}
+
+	/**
+	 * @brief Release the slot given by readSlot(). Consumer side only.
+	 */
+	void commitRead() {
+		tail_.store(increment(tail_.load(std::memory_order_relaxed)), std::memory_order_release);
+	}
+
+	/**
+	 * @brief The number of doubles in a record.
+	 * @return The record size.
+	 */
+	size_t recordSize() const {
+		return record_size_;
+	}
+
+	/**
+	 * @brief The maximum number of records in the buffer.
+	 * @return The capacity.
+	 */
+	size_t capacity() const {
+		return slots_ - 1;
+	}
+
+private:
+	size_t increment(size_t index) const {
+		return ++index == slots_ ? 0 : index;
+	}
+
+	std::vector<double> buffer_;
+	size_t record_size_;
+	size_t slots_;
+	std::atomic<size_t> head_;
+	char padding_[64 - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t> tail_;
+};
+
+} // namespace phri
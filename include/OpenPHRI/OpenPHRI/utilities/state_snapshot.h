@@ -0,0 +1,308 @@
+/*      File: state_snapshot.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file state_snapshot.h
+ * @author Benjamin Navarro
+ * @brief Definition of the StateWriter, StateReader and StateSnapshot classes
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace phri {
+
+/** @brief Serializes the internal state of objects to a compact binary buffer, see StateSnapshot.
+ */
+class StateWriter {
+public:
+	/**
+	 * @brief Construct a writer appending to the given buffer.
+	 * @param buffer The buffer to write to.
+	 */
+	explicit StateWriter(std::vector<char>& buffer) :
+		buffer_(buffer)
+	{
+	}
+
+	template<typename T>
+	void write(const T& value) {
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly");
+		auto bytes = reinterpret_cast<const char*>(&value);
+		buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+	}
+
+	template<typename Derived>
+	void writeMatrix(const Eigen::MatrixBase<Derived>& matrix) {
+		write<uint32_t>(matrix.rows());
+		write<uint32_t>(matrix.cols());
+		for (Eigen::Index col = 0; col < matrix.cols(); ++col) {
+			for (Eigen::Index row = 0; row < matrix.rows(); ++row) {
+				write<double>(matrix(row, col));
+			}
+		}
+	}
+
+	void writeString(const std::string& str) {
+		write<uint32_t>(str.size());
+		buffer_.insert(buffer_.end(), str.begin(), str.end());
+	}
+
+	template<typename T>
+	void writeVector(const std::vector<T>& vec) {
+		write<uint32_t>(vec.size());
+		for(const auto& value: vec) {
+			write(value);
+		}
+	}
+
+	// Overloads for generic code working on scalars, vectors or twists
+	void writeValue(double value) {
+		write(value);
+	}
+
+	template<typename Derived>
+	void writeValue(const Eigen::MatrixBase<Derived>& value) {
+		writeMatrix(value);
+	}
+
+	void writeValue(const Twist& value) {
+		writeMatrix(static_cast<const Vector6d&>(value));
+	}
+
+	/**
+	 * @brief Write a size prefixed block, so that it can be skipped or checked on reading.
+	 * @param content Function writing the block content.
+	 */
+	void writeBlock(const std::function<void(StateWriter&)>& content);
+
+private:
+	std::vector<char>& buffer_;
+};
+
+/** @brief Reads a state written by a StateWriter. Throws std::out_of_range if the data is truncated or
+ *  std::length_error if a size doesn't match the object being restored.
+ */
+class StateReader {
+public:
+	/**
+	 * @brief Construct a reader for the given memory.
+	 * @param data Pointer to the data.
+	 * @param size The size of the data, in bytes.
+	 */
+	StateReader(const char* data, size_t size) :
+		data_(data),
+		size_(size),
+		offset_(0)
+	{
+	}
+
+	template<typename T>
+	T read() {
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly");
+		T value;
+		std::memcpy(&value, take(sizeof(T)), sizeof(T));
+		return value;
+	}
+
+	template<typename T>
+	void read(T& value) {
+		value = read<T>();
+	}
+
+	// Taken by const reference to also accept temporary blocks and maps, as advised by the Eigen documentation
+	template<typename Derived>
+	void readMatrix(const Eigen::MatrixBase<Derived>& const_matrix) {
+		auto& matrix = const_cast<Eigen::MatrixBase<Derived>&>(const_matrix);
+		auto rows = read<uint32_t>();
+		auto cols = read<uint32_t>();
+		checkSize(rows == matrix.rows() and cols == matrix.cols(), rows, cols, matrix);
+		readCoefficients(matrix);
+	}
+
+	// Matrices and vectors with a dynamic size are resized to the stored size
+	template<typename Derived>
+	void readMatrix(Eigen::PlainObjectBase<Derived>& matrix) {
+		auto rows = read<uint32_t>();
+		auto cols = read<uint32_t>();
+		checkSize(
+			(Derived::RowsAtCompileTime == Eigen::Dynamic or rows == matrix.rows()) and
+			(Derived::ColsAtCompileTime == Eigen::Dynamic or cols == matrix.cols()),
+			rows, cols, matrix);
+		checkRemaining(static_cast<size_t>(rows) * cols * sizeof(double));
+		matrix.resize(rows, cols);
+		readCoefficients(matrix);
+	}
+
+	void readString(std::string& str) {
+		auto size = read<uint32_t>();
+		auto data = take(size);
+		str.assign(data, size);
+	}
+
+	template<typename T>
+	void readVector(std::vector<T>& vec) {
+		auto size = read<uint32_t>();
+		checkRemaining(size * sizeof(T));
+		vec.resize(size);
+		for(auto& value: vec) {
+			read(value);
+		}
+	}
+
+	// Overloads for generic code working on scalars, vectors or twists
+	void readValue(double& value) {
+		read(value);
+	}
+
+	template<typename Derived>
+	void readValue(Eigen::PlainObjectBase<Derived>& value) {
+		readMatrix(value);
+	}
+
+	void readValue(Twist& value) {
+		readMatrix(static_cast<Vector6d&>(value));
+	}
+
+	/**
+	 * @brief Read a block written by StateWriter::writeBlock.
+	 * @param content Function reading the block content. It must read the whole block.
+	 */
+	void readBlock(const std::function<void(StateReader&)>& content);
+
+	/**
+	 * @brief Skip a block written by StateWriter::writeBlock.
+	 */
+	void skipBlock();
+
+	/**
+	 * @brief The number of bytes left to read.
+	 * @return The number of bytes.
+	 */
+	size_t remaining() const {
+		return size_ - offset_;
+	}
+
+private:
+	template<typename Derived>
+	void checkSize(bool ok, uint32_t rows, uint32_t cols, const Eigen::MatrixBase<Derived>& matrix) {
+		if(not ok) {
+			throw std::length_error(OPEN_PHRI_ERROR("The stored matrix is " + std::to_string(rows) + "x" + std::to_string(cols) + " but a " + std::to_string(matrix.rows()) + "x" + std::to_string(matrix.cols()) + " one is being restored"));
+		}
+	}
+
+	template<typename Derived>
+	void readCoefficients(Eigen::MatrixBase<Derived>& matrix) {
+		checkRemaining(matrix.size() * sizeof(double));
+		for (Eigen::Index col = 0; col < matrix.cols(); ++col) {
+			for (Eigen::Index row = 0; row < matrix.rows(); ++row) {
+				matrix(row, col) = read<double>();
+			}
+		}
+	}
+
+	void checkRemaining(size_t size) const {
+		if(size > remaining()) {
+			throw std::out_of_range(OPEN_PHRI_ERROR("Truncated state data"));
+		}
+	}
+
+	const char* take(size_t size) {
+		checkRemaining(size);
+		auto data = data_ + offset_;
+		offset_ += size;
+		return data;
+	}
+
+	const char* data_;
+	size_t size_;
+	size_t offset_;
+};
+
+/** @brief A binary snapshot of the internal state of a set of objects (Robot, SafetyController, TrajectoryGenerator, filters, etc).
+ *  @details The objects are written and read in the same order through the writer() and reader() functions:
+ *  @code
+ *  auto writer = snapshot.writer();
+ *  controller->saveState(writer);
+ *  trajectory_generator.saveState(writer);
+ *  ...
+ *  auto reader = snapshot.reader();
+ *  controller->restoreState(reader);
+ *  trajectory_generator.restoreState(reader);
+ *  @endcode
+ *  A snapshot can be restored in other objects with the same configuration, e.g. to simulate the next cycles from the current state.
+ */
+class StateSnapshot {
+public:
+	StateSnapshot() = default;
+	~StateSnapshot() = default;
+
+	/**
+	 * @brief Clear the snapshot and get a writer to fill it.
+	 * @return The writer. It must not outlive the snapshot.
+	 */
+	StateWriter writer();
+
+	/**
+	 * @brief Get a reader to restore the snapshot.
+	 * @return The reader. It must not outlive the snapshot or be used after a call to writer() or load().
+	 */
+	StateReader reader() const;
+
+	/**
+	 * @brief Write the snapshot to a file, through a temporary file so that an existing snapshot is never partially overwritten.
+	 * @param file The path of the file.
+	 * @return True on success, false otherwise.
+	 */
+	bool save(const std::string& file) const;
+
+	/**
+	 * @brief Read a snapshot written by save().
+	 * @param file The path of the file.
+	 * @return True on success, false if the file can't be read or is not a valid snapshot.
+	 */
+	bool load(const std::string& file);
+
+	/**
+	 * @brief The serialized state.
+	 * @return The data.
+	 */
+	const std::vector<char>& data() const;
+
+private:
+	std::vector<char> data_;
+};
+
+using StateSnapshotPtr = std::shared_ptr<StateSnapshot>;
+using StateSnapshotConstPtr = std::shared_ptr<const StateSnapshot>;
+
+} // namespace phri
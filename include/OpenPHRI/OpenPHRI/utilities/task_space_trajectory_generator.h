@@ -104,6 +104,22 @@ public:
 		super::removeAllPoints();
 	}
 
+	virtual void saveState(StateWriter& writer) const override {
+		super::saveState(writer);
+		writer.writeMatrix(pose_output_->translation());
+		writer.writeMatrix(pose_output_->orientation().coeffs());
+		writer.writeMatrix(static_cast<const Vector6d&>(*twist_output_));
+		writer.writeMatrix(static_cast<const Vector6d&>(*task_space_acceleration_output_));
+	}
+
+	virtual void restoreState(StateReader& reader) override {
+		super::restoreState(reader);
+		reader.readMatrix(pose_output_->translation());
+		reader.readMatrix(pose_output_->orientation().coeffs());
+		reader.readMatrix(static_cast<Vector6d&>(*twist_output_));
+		reader.readMatrix(static_cast<Vector6d&>(*task_space_acceleration_output_));
+	}
+
 	void enableErrorTracking(std::shared_ptr<const Pose> reference, const Vector6d& threshold, bool recompute_when_resumed, double hysteresis_threshold = 0.1) {
 		reference_pose_ = reference;
 		reference_pose_vec_ = std::make_shared<Vector6d>();
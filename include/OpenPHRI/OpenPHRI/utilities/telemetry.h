@@ -0,0 +1,241 @@
+/*      File: telemetry.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file telemetry.h
+ * @author Benjamin Navarro
+ * @brief Definition of the TelemetryPublisher and TelemetryReader classes
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+#include <OpenPHRI/robot.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace phri {
+
+class SafetyController;
+
+/*
+ * Telemetry shared memory segment layout (native endianness, all sizes in bytes):
+ *   header:  TelemetryHeader
+ *   signals: signal count TelemetrySignalDescriptor
+ *   data:    at data offset, row size doubles: the timestamp followed by the values of all the signals
+ * The data is protected by a sequence lock: the sequence is odd while the publisher writes to the segment and
+ * readers retry until they get the same even sequence before and after copying the data.
+ * The replaced flag is set when the publisher moves to a new segment with another layout, after a controller reconfiguration.
+ */
+constexpr char telemetry_magic[8] = {'O', 'P', 'H', 'R', 'I', 'T', 'L', 'M'};
+constexpr uint32_t telemetry_version = 2;
+
+struct TelemetryHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t signal_count;
+	uint64_t row_size;
+	uint64_t data_offset;
+	std::atomic<uint64_t> sequence;
+	std::atomic<uint32_t> replaced;
+	uint32_t reserved;
+};
+
+struct TelemetrySignalDescriptor {
+	char name[56];
+	uint32_t offset;
+	uint32_t size;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 and ATOMIC_INT_LOCK_FREE == 2, "The telemetry sequence and flags must be lock-free to be shared between processes");
+static_assert(sizeof(TelemetryHeader) % 8 == 0 and sizeof(TelemetrySignalDescriptor) % 8 == 0, "The telemetry data must be 8 bytes aligned");
+
+/** @brief Description of a published signal.
+ */
+struct TelemetrySignal {
+	std::string name;
+	size_t offset;
+	size_t size;
+};
+
+/** @brief Publishes the controller state in a POSIX shared memory segment for live monitoring by other processes.
+ *  @details The published data is copied to the segment under a sequence lock on each call to publish(), so the control thread
+ *  never waits for the readers, which can sample a consistent snapshot at any rate with a TelemetryReader.
+ *  The segment layout is fixed on the first call to publish(). If the published SafetyController is reconfigured, the channels are
+ *  collected again and, if the layout has changed, the segment is replaced by a new one with the same name (see TelemetryReader::isReplaced()).
+ */
+class TelemetryPublisher {
+public:
+	/**
+	 * @brief Construct a new telemetry publisher. The segment is created on the first call to publish().
+	 * @param name The name of the shared memory segment (e.g. "/openphri").
+	 * @param time A shared pointer to the current time.
+	 */
+	TelemetryPublisher(const std::string& name, doubleConstPtr time);
+
+	/**
+	 * @brief Unmap and remove the shared memory segment.
+	 */
+	~TelemetryPublisher();
+
+	TelemetryPublisher(const TelemetryPublisher&) = delete;
+	TelemetryPublisher& operator=(const TelemetryPublisher&) = delete;
+
+	/**
+	 * @brief Publish the last values of the constraints and generators of a SafetyController.
+	 * @param controller Pointer to a SafetyController object.
+	 */
+	void publishSafetyControllerData(SafetyController* controller);
+
+	/**
+	 * @brief Publish the joint and control point state and commands of a robot.
+	 * @param robot A shared pointer to the robot.
+	 */
+	void publishRobotData(RobotConstPtr robot);
+
+	/**
+	 * @brief Publish some external data.
+	 * @param name The name given to this data.
+	 * @param data A pointer to the data.
+	 * @param size The number of values.
+	 */
+	void publishExternalData(const std::string& name, const double* data, size_t size);
+
+	/**
+	 * @brief Copy all the published data to the shared memory segment. Creates the segment on the first call.
+	 */
+	void publish();
+
+	/**
+	 * @brief The published signals.
+	 * @return The signals, in the segment order. Empty before the first call to publish().
+	 */
+	const std::vector<TelemetrySignal>& signals() const;
+
+	/**
+	 * @brief The number of calls to publish() since the first segment creation.
+	 * @return The number of published snapshots.
+	 */
+	uint64_t publishCount() const;
+
+private:
+	struct channel {
+		std::string name;
+		const double* data;
+		size_t size;
+	};
+
+	void collectChannels();
+	void updateChannels();
+	void createSegment();
+	size_t controllerItemCount() const;
+
+	std::string name_;
+	doubleConstPtr time_;
+	SafetyController* controller_;
+	RobotConstPtr robot_;
+	std::vector<channel> external_channels_;
+	std::vector<channel> channels_;
+	std::vector<TelemetrySignal> signals_;
+	size_t controller_items_;
+	size_t controller_version_;
+	TelemetryHeader* header_;
+	double* data_;
+	size_t segment_size_;
+	uint64_t publish_count_;
+};
+
+using TelemetryPublisherPtr = std::shared_ptr<TelemetryPublisher>;
+using TelemetryPublisherConstPtr = std::shared_ptr<const TelemetryPublisher>;
+
+/** @brief Reads consistent snapshots of the data published by a TelemetryPublisher, possibly from another process.
+ */
+class TelemetryReader {
+public:
+	/**
+	 * @brief Map the shared memory segment in read-only mode.
+	 * @param name The name of the shared memory segment.
+	 */
+	explicit TelemetryReader(const std::string& name);
+	~TelemetryReader();
+
+	TelemetryReader(const TelemetryReader&) = delete;
+	TelemetryReader& operator=(const TelemetryReader&) = delete;
+
+	/**
+	 * @brief The published signals.
+	 * @return The signals, in the segment order.
+	 */
+	const std::vector<TelemetrySignal>& signals() const;
+
+	/**
+	 * @brief The index of a signal.
+	 * @param name The name of the signal.
+	 * @return The index, or -1 if there is no such signal.
+	 */
+	int signalIndex(const std::string& name) const;
+
+	/**
+	 * @brief The number of doubles in a snapshot, including the timestamp.
+	 * @return The snapshot size.
+	 */
+	size_t rowSize() const;
+
+	/**
+	 * @brief Copy the last published snapshot. Retries while the publisher is writing to the segment.
+	 * @details Throws a std::runtime_error if the publisher is still writing after the timeout, e.g. if it stopped in the middle of a publish().
+	 * @param row [out] The timestamp followed by the values of all the signals. Resized if needed.
+	 * @param timeout The maximum time to wait for the publisher to finish writing, in seconds.
+	 * @return The number of snapshots published so far, the copied one included.
+	 */
+	uint64_t read(std::vector<double>& row, double timeout = 1.) const;
+
+	/**
+	 * @brief Map the values of a signal in a snapshot obtained with read().
+	 * @param row The snapshot.
+	 * @param signal The signal index.
+	 * @return The values.
+	 */
+	Eigen::Map<const VectorXd> signal(const std::vector<double>& row, size_t signal) const;
+
+	/**
+	 * @brief Tell if the publisher has replaced the segment by a new one with another layout. A new reader must then be created to get the new data.
+	 * @return True if the segment has been replaced.
+	 */
+	bool isReplaced() const;
+
+private:
+	std::vector<TelemetrySignal> signals_;
+	const TelemetryHeader* header_;
+	const double* data_;
+	size_t segment_size_;
+	size_t row_size_;
+};
+
+using TelemetryReaderPtr = std::shared_ptr<TelemetryReader>;
+using TelemetryReaderConstPtr = std::shared_ptr<const TelemetryReader>;
+
+} // namespace phri
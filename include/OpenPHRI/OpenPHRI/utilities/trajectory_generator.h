@@ -31,6 +31,8 @@
 #include <OpenPHRI/utilities/interpolators_common.h>
 #include <OpenPHRI/utilities/object_collection.hpp>
 #include <OpenPHRI/utilities/fifth_order_polynomial.h>
+#include <OpenPHRI/utilities/clock.h>
+#include <OpenPHRI/utilities/state_snapshot.h>
 #include <vector>
 
 namespace phri {
@@ -164,6 +166,27 @@ public:
 		segment_params_[segment].current_time[component] = time;
 	}
 
+	double getSampleTime() const {
+		return sample_time_;
+	}
+
+	void setSampleTime(double sample_time) {
+		sample_time_ = sample_time;
+	}
+
+	/**
+	 * @brief Advance the trajectories by the measured cycle time of a clock instead of the fixed sample time, so that slipped cycles don't slow them down.
+	 * @details The generator must outlive the subscription. Use Clock::unsubscribe with the returned identifier otherwise.
+	 * @param clock The clock to follow.
+	 * @return The subscription identifier.
+	 */
+	Clock::SubscriptionID followClock(Clock& clock) {
+		return clock.subscribe(
+			[this](const Clock& clock) {
+				sample_time_ = *clock.getCycleTime();
+			});
+	}
+
 	bool computeParameters() {
 		int segments = getSegmentCount();
 		if(segments < 1) {
@@ -464,6 +487,51 @@ public:
 		segment_params_.clear();
 	}
 
+	/**
+	 * @brief Write the trajectory progress (current segments and times, polynomials, error tracking states and outputs) to a snapshot.
+	 * @param writer The writer to use.
+	 */
+	virtual void saveState(StateWriter& writer) const {
+		writer.writeVector(current_segement_);
+		writer.write<uint32_t>(segment_params_.size());
+		for(const auto& params: segment_params_) {
+			writer.writeVector(params.minimum_time);
+			writer.writeVector(params.current_time);
+			writer.writeVector(params.padding_time);
+			writer.writeVector(params.poly_params);
+		}
+		writer.writeVector(error_tracking_params_.state);
+		writer.writeVector(error_tracking_params_.previous_state);
+		writer.writeValue(*position_output_);
+		writer.writeValue(*velocity_output_);
+		writer.writeValue(*acceleration_output_);
+	}
+
+	/**
+	 * @brief Restore a state written by saveState(). The generator must have the same waypoints, with their timings computed.
+	 * @param reader The reader to use. Throws std::length_error if the number of components or segments doesn't match.
+	 */
+	virtual void restoreState(StateReader& reader) {
+		std::vector<size_t> current_segments;
+		reader.readVector(current_segments);
+		auto segment_count = reader.read<uint32_t>();
+		if(current_segments.size() != getComponentCount() or segment_count != getSegmentCount()) {
+			throw std::length_error(OPEN_PHRI_ERROR("The stored trajectory has a different number of components or segments"));
+		}
+		current_segement_ = current_segments;
+		for(auto& params: segment_params_) {
+			reader.readVector(params.minimum_time);
+			reader.readVector(params.current_time);
+			reader.readVector(params.padding_time);
+			reader.readVector(params.poly_params);
+		}
+		reader.readVector(error_tracking_params_.state);
+		reader.readVector(error_tracking_params_.previous_state);
+		reader.readValue(*position_output_);
+		reader.readValue(*velocity_output_);
+		reader.readValue(*acceleration_output_);
+	}
+
 	static size_t getComputeTimingsIterations() {
 		return FifthOrderPolynomial::compute_timings_total_iter;
 	}
@@ -0,0 +1,108 @@
+/*      File: uniform_grid.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file uniform_grid.h
+ * @author Benjamin Navarro
+ * @brief Definition of the UniformGrid class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/definitions.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace phri {
+
+/** @brief A hashed uniform grid over a set of 3D points, to find the points close to a given location without visiting all of them.
+ *  @details The cells are hashed into a fixed number of buckets and the points are sorted by bucket (counting sort), so a rebuild is linear in
+ *  the number of points and doesn't allocate memory once the grid has reached its maximum size. A query visits the points in the 27 cells
+ *  around a location, i.e. all the points closer than the cell size, plus some farther ones (neighboring cells and hash collisions) that must
+ *  be filtered by the caller.
+ */
+class UniformGrid {
+public:
+	UniformGrid();
+	~UniformGrid() = default;
+
+	/**
+	 * @brief Sort the given points in the grid. The coordinates are given as separate arrays (structure of arrays).
+	 * @param x The x coordinates.
+	 * @param y The y coordinates.
+	 * @param z The z coordinates.
+	 * @param count The number of points.
+	 * @param cell_size The size of the cells. Must be strictly positive and finite.
+	 */
+	void build(const double* x, const double* y, const double* z, size_t count, double cell_size);
+
+	/**
+	 * @brief Call a function with the index of each point in the cells around the given location. Each point is visited once.
+	 * @param x The x coordinate of the location.
+	 * @param y The y coordinate of the location.
+	 * @param z The z coordinate of the location.
+	 * @param visitor A function taking a point index (size_t).
+	 */
+	template<typename Visitor>
+	void forEachNear(double x, double y, double z, Visitor&& visitor) const {
+		if(bucket_objects_.empty()) {
+			return;
+		}
+		std::array<size_t, 27> buckets;
+		size_t bucket_count = neighborBuckets(x, y, z, buckets);
+		for (size_t i = 0; i < bucket_count; ++i) {
+			for (size_t j = bucket_start_[buckets[i]]; j < bucket_start_[buckets[i]+1]; ++j) {
+				visitor(bucket_objects_[j]);
+			}
+		}
+	}
+
+	/**
+	 * @brief The size of the cells given to the last call to build().
+	 * @return The cell size.
+	 */
+	double cellSize() const;
+
+	/**
+	 * @brief The number of points in the grid.
+	 * @return The point count.
+	 */
+	size_t size() const;
+
+private:
+	int64_t cellCoordinate(double value) const;
+	size_t bucket(int64_t cx, int64_t cy, int64_t cz) const;
+	size_t neighborBuckets(double x, double y, double z, std::array<size_t, 27>& buckets) const;
+
+	double cell_size_;
+	size_t bucket_mask_;
+	std::vector<size_t> bucket_start_;
+	std::vector<size_t> bucket_objects_;
+	std::vector<size_t> object_buckets_;
+};
+
+using UniformGridPtr = std::shared_ptr<UniformGrid>;
+using UniformGridConstPtr = std::shared_ptr<const UniformGrid>;
+
+} // namespace phri
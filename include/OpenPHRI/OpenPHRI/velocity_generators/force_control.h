@@ -55,6 +55,9 @@ public:
 
 	void configureFilter(double sample_time, double time_constant);
 
+	virtual void saveState(StateWriter& writer) const override;
+	virtual void restoreState(StateReader& reader) override;
+
 protected:
 	virtual void update(Twist& velocity) override;
 	void applySelection(Vector6d& vec) const;
@@ -55,6 +55,18 @@ public:
 	 */
 	virtual Twist operator()() final;
 
+	/**
+	 * @brief Write the internal state of the velocity generator (e.g. filters, hysteresis) to a snapshot. Does nothing by default.
+	 * @param writer The writer to use.
+	 */
+	virtual void saveState(StateWriter& writer) const;
+
+	/**
+	 * @brief Restore a state written by saveState().
+	 * @param reader The reader to use.
+	 */
+	virtual void restoreState(StateReader& reader);
+
 protected:
 	/**
 	 * @brief Construct a velocity generator
@@ -37,7 +37,6 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>
 #include <map>
 #include <vector>
 #include <utility>
@@ -167,6 +166,8 @@ public:
 
 	/**
 	 * @brief Get the Jacobian matrix associated with the TCP.
+	 * @details The binary signal 'JacobianData-<robot name>' (two int32 for the V-REP rows and columns followed by the values as floats, see share/scenes/binary_matrices.lua) is used if available.
+	 * Otherwise the text signal 'Jacobian-<robot name>' is parsed.
 	 * @param jacobian [out] The current Jacobian matrix.
 	 * @return True if correctly read, false otherwise.
 	 */
@@ -174,6 +175,8 @@ public:
 
 	/**
 	 * @brief Get the transformation matrix associated with the TCP.
+	 * @details The binary signal 'RotMatData-<robot name>' (the first three rows as floats) is used if available.
+	 * Otherwise the text signal 'RotMat-<robot name>' is parsed.
 	 * @param matrix [out] The current transformation matrix.
 	 * @return True if correctly read, false otherwise.
 	 */
@@ -196,6 +199,21 @@ public:
 	phri::VectorXdConstPtr initLaserScanner(const std::string& name);
 	bool updateLaserScanners();
 
+	/**
+	 * @brief Exchange the joint and TCP data through packed string signals instead of one remote API call per value.
+	 * @details The V-REP scene must run the share/scenes/packed_joint_data.lua script in the robot child script.
+	 * The state signal 'JointState-<robot name><suffix>' holds the joint positions, the TCP twist in the base frame, the TCP wrench and the wrench validity, as floats.
+	 * The command signal 'JointTargetPositions-<robot name><suffix>' holds the joint target positions, as floats.
+	 * @param state True to enable the packed exchanges, false to go back to the default ones.
+	 */
+	void enablePackedJointData(bool state);
+
+	/**
+	 * @brief Read the Jacobian and transformation matrix in read() and update the control point pose from them, making the model forward kinematics unnecessary.
+	 * @param state True to read the kinematics, false otherwise.
+	 */
+	void enableKinematicsReading(bool state);
+
 	bool readJointPosition(phri::VectorXdPtr position) const;
 	bool sendJointTargetPosition(phri::VectorXdConstPtr position) const;
 	bool sendJointTargetVelocity(phri::VectorXdConstPtr velocity) const;
@@ -203,6 +221,8 @@ public:
 	virtual bool read() override;
 	virtual bool send() override;
 
+	virtual phri::DriverCapabilities capabilities() const override;
+
 	static bool isRegisteredInFactory();
 
 private:
@@ -211,12 +231,30 @@ private:
 	bool getObjectHandles();
 	void startStreaming() const;
 	int getFrameHandle(phri::ReferenceFrame frame) const;
+	bool readPackedState();
+	bool sendPackedJointTargetPosition();
 
 	bool sync_mode_;
+	bool packed_joint_data_;
+	bool read_kinematics_;
 	std::string suffix_;
 	int client_id_;
 
-	std::unordered_map<std::string, int> object_handles_;
+	int tcp_handle_;
+	int base_frame_handle_;
+	int world_frame_handle_;
+	int force_sensor_handle_;
+	std::vector<int> joint_handles_;
+	std::string jacobian_signal_;
+	std::string jacobian_text_signal_;
+	std::string transformation_signal_;
+	std::string transformation_text_signal_;
+	std::string packed_state_signal_;
+	std::string packed_command_signal_;
+	mutable std::vector<float> joint_data_;
+	std::vector<float> packed_state_;
+	std::vector<float> packed_command_;
+
 	std::map<std::string, phri::VectorXdPtr> lasers_data_;
 	std::map<std::pair<int,int>, phri::PosePtr> tracked_objects_;
 
@@ -0,0 +1,15 @@
+-- Binary Jacobian and transformation matrix transport for the OpenPHRI V-REP driver
+-- The driver reads 'JacobianData-<robot name>' and 'RotMatData-<robot name>' when available and only falls back
+-- to the text signals 'Jacobian-<robot name>' and 'RotMat-<robot name>' otherwise.
+-- In the robot child script, replace the text serialization of the matrices by calls to these functions.
+
+-- jacobian: the values as given by sim.getIkGroupMatrix, in row major order
+-- rows, cols: the matrix size, in the same order as in the text signal
+function publishJacobian(robot_name, jacobian, rows, cols)
+    sim.setStringSignal('JacobianData-'..robot_name, sim.packInt32Table({rows, cols})..sim.packFloatTable(jacobian))
+end
+
+-- matrix: the 12 values given by sim.getObjectMatrix (first three rows of the transformation, in row major order)
+function publishTransformationMatrix(robot_name, matrix)
+    sim.setStringSignal('RotMatData-'..robot_name, sim.packFloatTable(matrix))
+end
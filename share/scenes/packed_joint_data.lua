@@ -0,0 +1,76 @@
+-- Packed joint data exchange with the OpenPHRI V-REP driver
+-- Add this to the non-threaded child script of the robot and enable 'packed_joint_data' in the driver configuration.
+-- robot_name and suffix must match the ones used by the driver.
+
+function sysCall_init()
+    robot_name = 'LBR4p'
+    suffix = ''
+
+    tcp = sim.getObjectHandle(robot_name..'_tcp'..suffix)
+    base_frame = sim.getObjectHandle(robot_name..'_base_frame'..suffix)
+    force_sensor = sim.getObjectHandle(robot_name..'_force_sensor'..suffix)
+    joints = {}
+    local i = 1
+    while true do
+        local handle = sim.getObjectHandle(robot_name..'_joint'..i..suffix..'@silentError')
+        if handle == -1 then
+            break
+        end
+        joints[i] = handle
+        i = i + 1
+    end
+
+    state_signal = 'JointState-'..robot_name..suffix
+    command_signal = 'JointTargetPositions-'..robot_name..suffix
+end
+
+function sysCall_actuation()
+    local data = sim.getStringSignal(command_signal)
+    if data then
+        sim.clearStringSignal(command_signal)
+        -- Several commands can be queued, only apply the most recent one
+        local values = sim.unpackFloatTable(data)
+        local offset = #values - #joints
+        if offset >= 0 and offset % #joints == 0 then
+            for i = 1, #joints do
+                sim.setJointTargetPosition(joints[i], values[offset + i])
+            end
+        end
+    end
+end
+
+function sysCall_sensing()
+    local state = {}
+    for i = 1, #joints do
+        state[i] = sim.getJointPosition(joints[i])
+    end
+
+    -- TCP twist, expressed in the base frame
+    local linear, angular = sim.getObjectVelocity(tcp)
+    local base_rotation = sim.getObjectMatrix(base_frame, -1)
+    base_rotation[4] = 0
+    base_rotation[8] = 0
+    base_rotation[12] = 0
+    sim.invertMatrix(base_rotation)
+    linear = sim.multiplyVector(base_rotation, linear)
+    angular = sim.multiplyVector(base_rotation, angular)
+    for i = 1, 3 do
+        state[#state + 1] = linear[i]
+    end
+    for i = 1, 3 do
+        state[#state + 1] = angular[i]
+    end
+
+    -- TCP wrench, followed by its validity (sensor not broken and data available)
+    local result, force, torque = sim.readForceSensor(force_sensor)
+    local wrench_ok = result == 1 and force and torque
+    for i = 1, 3 do
+        state[#state + 1] = wrench_ok and force[i] or 0
+    end
+    for i = 1, 3 do
+        state[#state + 1] = wrench_ok and torque[i] or 0
+    end
+    state[#state + 1] = wrench_ok and 1 or 0
+
+    sim.setStringSignal(state_signal, sim.packFloatTable(state))
+end
@@ -0,0 +1,177 @@
+/*      File: collaborative_mode_constraint.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/constraints/collaborative_mode_constraint.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace phri;
+
+/***		Constructor & destructor		***/
+CollaborativeModeConstraint::CollaborativeModeConstraint(
+	CollaborativeMode mode,
+	doubleConstPtr separation_distance,
+	doubleConstPtr robot_mass,
+	const CollaborativeModeParameters& parameters) :
+	separation_distance_(separation_distance),
+	robot_mass_(robot_mass)
+{
+	mode_maximum_velocity_ = std::make_shared<double>(0.);
+	maximum_velocity_ = mode_maximum_velocity_;
+
+	setMode(mode);
+	setParameters(parameters);
+}
+
+/***		Algorithm		***/
+double CollaborativeModeConstraint::compute() {
+	switch(mode_) {
+	case CollaborativeMode::SafetyRatedMonitoredStop:
+		*mode_maximum_velocity_ = 0.;
+		return 0.;
+	case CollaborativeMode::HandGuiding:
+		*mode_maximum_velocity_ = parameters_.hand_guiding_velocity;
+		break;
+	case CollaborativeMode::SpeedAndSeparationMonitoring:
+		*mode_maximum_velocity_ = separation_velocity_table_(*separation_distance_);
+		break;
+	case CollaborativeMode::PowerAndForceLimiting:
+		// An invalid mass gives the lowest velocity (infinite mass)
+		*mode_maximum_velocity_ = contact_velocity_table_(*robot_mass_ > 0. ? 1. / *robot_mass_ : 0.);
+		break;
+	}
+
+	return VelocityConstraint::compute();
+}
+
+void CollaborativeModeConstraint::setMode(CollaborativeMode mode) {
+	checkInputs(mode);
+	mode_ = mode;
+}
+
+CollaborativeMode CollaborativeModeConstraint::getMode() const {
+	return mode_;
+}
+
+void CollaborativeModeConstraint::setParameters(const CollaborativeModeParameters& parameters) {
+	parameters_ = parameters;
+	buildTables();
+}
+
+const CollaborativeModeParameters& CollaborativeModeConstraint::getParameters() const {
+	return parameters_;
+}
+
+doubleConstPtr CollaborativeModeConstraint::getMaximumVelocity() const {
+	return mode_maximum_velocity_;
+}
+
+BodyRegionLimits CollaborativeModeConstraint::bodyRegionLimits(BodyRegion region) {
+	// ISO/TS 15066 tables A.2 (quasi-static forces) and A.3 (spring constants and effective masses)
+	switch(region) {
+	case BodyRegion::Skull:     return {130., 150e3, 4.4};
+	case BodyRegion::Face:      return {65.,  75e3,  4.4};
+	case BodyRegion::Neck:      return {150., 50e3,  1.2};
+	case BodyRegion::Back:      return {210., 35e3,  40.};
+	case BodyRegion::Chest:     return {140., 25e3,  40.};
+	case BodyRegion::Abdomen:   return {110., 10e3,  40.};
+	case BodyRegion::Pelvis:    return {180., 25e3,  40.};
+	case BodyRegion::UpperArm:  return {150., 30e3,  3.};
+	case BodyRegion::LowerArm:  return {160., 40e3,  2.};
+	case BodyRegion::Hand:      return {140., 75e3,  0.6};
+	case BodyRegion::Thigh:     return {220., 50e3,  75.};
+	case BodyRegion::LowerLeg:  return {130., 60e3,  75.};
+	}
+	throw std::runtime_error(OPEN_PHRI_ERROR("Unknown body region"));
+}
+
+double CollaborativeModeConstraint::separationVelocity(const CollaborativeModeParameters& parameters, double separation_distance) {
+	const double reaction_time = parameters.reaction_time;
+	const double deceleration = parameters.maximum_deceleration;
+	// Distance left for the robot to react and stop once the operator's motion and the intrusion distance are accounted for
+	const double available_distance =
+		separation_distance
+		- parameters.human_velocity * (reaction_time + parameters.stopping_time)
+		- parameters.intrusion_distance;
+	if(available_distance <= 0.) {
+		return 0.;
+	}
+	// Positive root of v^2/(2a) + v*T_r = available distance
+	return deceleration * (std::sqrt(reaction_time * reaction_time + 2. * available_distance / deceleration) - reaction_time);
+}
+
+double CollaborativeModeConstraint::contactVelocity(const BodyRegionLimits& limits, double robot_mass, double transient_contact_factor) {
+	const double reduced_mass = 1. / (1. / limits.effective_mass + 1. / robot_mass);
+	return transient_contact_factor * limits.maximum_force / std::sqrt(reduced_mass * limits.spring_constant);
+}
+
+void CollaborativeModeConstraint::checkInputs(CollaborativeMode mode) const {
+	if(mode == CollaborativeMode::SpeedAndSeparationMonitoring and not separation_distance_) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The speed and separation monitoring mode requires a separation distance"));
+	}
+	if(mode == CollaborativeMode::PowerAndForceLimiting and not robot_mass_) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The power and force limiting mode requires the robot effective mass"));
+	}
+}
+
+void CollaborativeModeConstraint::buildTables() {
+	const auto& params = parameters_;
+	if(not (params.maximum_deceleration > 0.) or not (params.minimum_robot_mass > 0.)) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The maximum deceleration and the minimum robot mass must be strictly positive"));
+	}
+
+	// The table starts where the velocity becomes positive, so that the sampled function is concave
+	const double min_separation = params.human_velocity * (params.reaction_time + params.stopping_time) + params.intrusion_distance;
+	separation_velocity_table_ = LookupTable(
+		[&params](double separation_distance) {
+			return separationVelocity(params, separation_distance);
+		},
+		min_separation,
+		std::max(params.maximum_separation_distance, min_separation + 1e-3),
+		params.table_size);
+
+	std::vector<BodyRegionLimits> regions;
+	if(params.body_regions.empty()) {
+		for (int region = static_cast<int>(BodyRegion::Skull); region <= static_cast<int>(BodyRegion::LowerLeg); ++region) {
+			regions.push_back(bodyRegionLimits(static_cast<BodyRegion>(region)));
+		}
+	}
+	else {
+		for(auto region: params.body_regions) {
+			regions.push_back(bodyRegionLimits(region));
+		}
+	}
+
+	// Sampled on the inverse robot mass: v^2 is linear in 1/m_R so v is concave
+	contact_velocity_table_ = LookupTable(
+		[&params, &regions](double inverse_robot_mass) {
+			double velocity = std::numeric_limits<double>::infinity();
+			for(const auto& region: regions) {
+				velocity = std::min(velocity, contactVelocity(region, 1. / inverse_robot_mass, params.transient_contact_factor));
+			}
+			return velocity;
+		},
+		0.,
+		1. / params.minimum_robot_mass,
+		params.table_size);
+}
@@ -28,3 +28,9 @@ void Constraint::setRobot(RobotConstPtr robot) {
 double Constraint::operator()() {
 	return compute();
 }
+
+void Constraint::saveState(StateWriter& writer) const {
+}
+
+void Constraint::restoreState(StateReader& reader) {
+}
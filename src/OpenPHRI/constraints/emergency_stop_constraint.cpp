@@ -18,6 +18,7 @@
 */
 
 #include <OpenPHRI/constraints/emergency_stop_constraint.h>
+#include <OpenPHRI/utilities/state_snapshot.h>
 #include <iostream>
 
 using namespace phri;
@@ -96,3 +97,11 @@ double EmergencyStopConstraint::compute() {
 
 	return constraint;
 }
+
+void EmergencyStopConstraint::saveState(StateWriter& writer) const {
+	writer.write(previous_constraint_value_);
+}
+
+void EmergencyStopConstraint::restoreState(StateReader& reader) {
+	reader.read(previous_constraint_value_);
+}
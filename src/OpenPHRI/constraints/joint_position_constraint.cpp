@@ -0,0 +1,57 @@
+/*      File: joint_position_constraint.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/constraints/joint_position_constraint.h>
+
+using namespace phri;
+
+using namespace Eigen;
+
+/***		Constructor & destructor		***/
+JointPositionConstraint::JointPositionConstraint(
+	JointLimitsConstPtr limits,
+	double sample_time) :
+	limits_(limits),
+	sample_time_(sample_time),
+	lower_distance_(limits->jointCount()),
+	upper_distance_(limits->jointCount())
+{
+}
+
+/***		Algorithm		***/
+double JointPositionConstraint::compute() {
+	double constraint = 1.;
+	const auto& joint_pos = *robot_->jointCurrentPosition();
+	const auto& joint_vel = *robot_->jointTotalVelocity();
+
+	limits_->distanceToLowerLimits(joint_pos, lower_distance_);
+	limits_->distanceToUpperLimits(joint_pos, upper_distance_);
+
+	for (Eigen::Index i = 0; i < joint_vel.size(); ++i) {
+		double step = joint_vel(i) * sample_time_;
+		if(step > 0.) {
+			constraint = std::min(constraint, std::max(upper_distance_(i), 0.) / step);
+		}
+		else if(step < 0.) {
+			constraint = std::min(constraint, std::max(lower_distance_(i), 0.) / -step);
+		}
+	}
+
+	return constraint;
+}
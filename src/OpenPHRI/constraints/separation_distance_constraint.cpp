@@ -54,19 +54,42 @@ doubleConstPtr SeparationDistanceConstraint::getSeparationDistance() const {
 	return separation_distance_;
 }
 
+void SeparationDistanceConstraint::setPointCloud(PointCloudConstPtr point_cloud) {
+	point_cloud_ = point_cloud;
+}
+
+void SeparationDistanceConstraint::setRobotGeometry(RobotGeometryPtr robot_geometry) {
+	robot_geometry_ = robot_geometry;
+}
+
 void SeparationDistanceConstraint::setRobot(RobotConstPtr robot) {
 	constraint_->setRobot(robot);
 	Constraint::setRobot(robot);
 }
 
 double SeparationDistanceConstraint::closestObjectDistance() {
-	const Vector3d& rob_pos = robot_position_->block<3,1>(0,0);
-
-	double min_dist = std::numeric_limits<double>::infinity();
+	// Gather the object positions to process them all at once
+	object_positions_.resize(3, items_.size());
+	Eigen::Index idx = 0;
 	for(const auto& item : items_) {
-		Vector3d obj_rob_vec = item.second->translation() - rob_pos;
+		object_positions_.col(idx++) = item.second->translation();
+	}
 
-		min_dist = std::min(min_dist, obj_rob_vec.norm());
+	double min_dist = std::numeric_limits<double>::infinity();
+	if(robot_geometry_) {
+		min_dist = robot_geometry_->distance(object_positions_);
+		if(point_cloud_) {
+			min_dist = robot_geometry_->distance(point_cloud_->points(), min_dist);
+		}
+	}
+	else {
+		const Vector3d rob_pos = robot_position_->block<3,1>(0,0);
+		if(object_positions_.cols() > 0) {
+			min_dist = (object_positions_.colwise() - rob_pos).colwise().norm().minCoeff();
+		}
+		if(point_cloud_) {
+			min_dist = std::min(min_dist, point_cloud_->closestDistance(rob_pos));
+		}
 	}
 
 	return min_dist;
@@ -0,0 +1,249 @@
+/*      File: async_driver.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/drivers/async_driver.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+using namespace phri;
+
+AsyncDriver::AsyncDriver(
+	RobotPtr robot,
+	DriverPtr driver,
+	RobotPtr driver_robot,
+	size_t queue_size) :
+	Driver(robot, driver->getSampleTime()),
+	driver_(driver),
+	driver_robot_(driver_robot),
+	transfer_kinematics_(driver->capabilities().kinematics),
+	measurements_(queue_size, initialMeasurement(*driver_robot)),
+	commands_(queue_size, initialCommand(*robot)),
+	measurement_(initialMeasurement(*driver_robot)),
+	command_(initialCommand(*robot)),
+	io_measurement_(measurement_),
+	io_command_(command_),
+	running_(false),
+	last_send_ok_(true),
+	measurement_overruns_(0),
+	command_overruns_(0),
+	late_commands_(0),
+	driver_errors_(0),
+	command_age_(0.)
+{
+	if(robot_->jointCount() != driver_robot_->jointCount()) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The robot and the driver robot must have the same joint count."));
+	}
+}
+
+AsyncDriver::~AsyncDriver() {
+	running_ = false;
+	if(io_thread_.joinable()) {
+		io_thread_.join();
+	}
+}
+
+bool AsyncDriver::init(double timeout) {
+	// The I/O thread must be stopped before reinitializing the wrapped driver it uses
+	running_ = false;
+	if(io_thread_.joinable()) {
+		io_thread_.join();
+	}
+
+	if(not driver_->init(timeout)) {
+		return false;
+	}
+
+	copyMeasurement(*driver_robot_, measurement_);
+	copyMeasurement(measurement_, *robot_);
+
+	running_ = true;
+	io_thread_ = std::thread(&AsyncDriver::ioLoop, this);
+
+	return true;
+}
+
+bool AsyncDriver::start(double timeout) {
+	return driver_->start(timeout);
+}
+
+bool AsyncDriver::stop() {
+	running_ = false;
+	if(io_thread_.joinable()) {
+		io_thread_.join();
+	}
+	return driver_->stop();
+}
+
+bool AsyncDriver::read() {
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(10. * getSampleTime());
+
+	while(measurements_.empty()) {
+		if(not running_ or std::chrono::steady_clock::now() > deadline) {
+			return false;
+		}
+		std::this_thread::sleep_for(std::chrono::microseconds(50));
+	}
+
+	// Only keep the most recent measurement
+	while(measurements_.pop(measurement_)) {
+		continue;
+	}
+	copyMeasurement(measurement_, *robot_);
+
+	return measurement_.valid;
+}
+
+bool AsyncDriver::send() {
+	copyCommand(*robot_, command_);
+	command_.timestamp = std::chrono::steady_clock::now();
+	if(not commands_.push(command_)) {
+		++command_overruns_;
+	}
+	return last_send_ok_;
+}
+
+uint64_t AsyncDriver::measurementOverruns() const {
+	return measurement_overruns_;
+}
+
+uint64_t AsyncDriver::commandOverruns() const {
+	return command_overruns_;
+}
+
+uint64_t AsyncDriver::lateCommands() const {
+	return late_commands_;
+}
+
+uint64_t AsyncDriver::driverErrors() const {
+	return driver_errors_;
+}
+
+double AsyncDriver::commandAge() const {
+	return command_age_;
+}
+
+double AsyncDriver::measurementAge() const {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - measurement_.timestamp).count();
+}
+
+DriverCapabilities AsyncDriver::capabilities() const {
+	return driver_->capabilities();
+}
+
+DriverPtr AsyncDriver::getDriver() const {
+	return driver_;
+}
+
+void AsyncDriver::ioLoop() {
+	const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(getSampleTime()));
+	auto next_cycle = std::chrono::steady_clock::now();
+	// Self paced drivers already synchronize in read(), syncing them again would skip samples
+	const bool self_paced = driver_->capabilities().self_paced;
+
+	while(running_) {
+		bool sync_ok = true;
+		if(not self_paced) {
+			sync_ok = driver_->sync();
+		}
+
+		io_measurement_.valid = driver_->read();
+		io_measurement_.timestamp = std::chrono::steady_clock::now();
+		copyMeasurement(*driver_robot_, io_measurement_);
+		if(not measurements_.push(io_measurement_)) {
+			++measurement_overruns_;
+		}
+
+		bool new_command = false;
+		while(commands_.pop(io_command_)) {
+			new_command = true;
+		}
+		if(new_command) {
+			copyCommand(io_command_, *driver_robot_);
+			command_age_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - io_command_.timestamp).count();
+		}
+		else {
+			++late_commands_;
+		}
+
+		bool send_ok = driver_->send();
+		last_send_ok_ = send_ok;
+		if(not (sync_ok and send_ok and io_measurement_.valid)) {
+			++driver_errors_;
+		}
+
+		// Drivers with a non-blocking sync() are paced using the sample time
+		if(not self_paced) {
+			next_cycle += period;
+			std::this_thread::sleep_until(next_cycle);
+		}
+	}
+}
+
+// All the buffers are sized at construction so that no allocation happens during the exchanges
+AsyncDriver::Measurement AsyncDriver::initialMeasurement(const Robot& robot) const {
+	Measurement measurement;
+	copyMeasurement(robot, measurement);
+	measurement.valid = false;
+	return measurement;
+}
+
+AsyncDriver::Command AsyncDriver::initialCommand(const Robot& robot) {
+	Command command;
+	copyCommand(robot, command);
+	return command;
+}
+
+void AsyncDriver::copyMeasurement(const Robot& from, Measurement& to) const {
+	to.joint_current_position = *from.jointCurrentPosition();
+	to.joint_target_position = *from.jointTargetPosition();
+	to.joint_external_torque = *from.jointExternalTorque();
+	to.control_point_current_pose = *from.controlPointCurrentPose();
+	to.control_point_current_velocity = *from.controlPointCurrentVelocity();
+	to.control_point_current_acceleration = *from.controlPointCurrentAcceleration();
+	to.control_point_external_force = *from.controlPointExternalForce();
+	if(transfer_kinematics_) {
+		to.jacobian = *from.jacobian();
+		to.transformation_matrix = *from.transformationMatrix();
+		to.spatial_transformation_matrix = *from.spatialTransformationMatrix();
+	}
+}
+
+void AsyncDriver::copyMeasurement(const Measurement& from, Robot& to) const {
+	*to.jointCurrentPosition() = from.joint_current_position;
+	*to.jointTargetPosition() = from.joint_target_position;
+	*to.jointExternalTorque() = from.joint_external_torque;
+	*to.controlPointCurrentPose() = from.control_point_current_pose;
+	*to.controlPointCurrentVelocity() = from.control_point_current_velocity;
+	*to.controlPointCurrentAcceleration() = from.control_point_current_acceleration;
+	*to.controlPointExternalForce() = from.control_point_external_force;
+	if(transfer_kinematics_) {
+		*to.jacobian() = from.jacobian;
+		*to.transformationMatrix() = from.transformation_matrix;
+		*to.spatialTransformationMatrix() = from.spatial_transformation_matrix;
+	}
+}
+
+void AsyncDriver::copyCommand(const Robot& from, Command& to) {
+	to.joint_velocity = *from.jointVelocity();
+	to.control_point_velocity = *from.controlPointVelocity();
+}
+
+void AsyncDriver::copyCommand(const Command& from, Robot& to) {
+	*to.joint_velocity_ = from.joint_velocity;
+	*to.control_point_velocity_ = from.control_point_velocity;
+}
@@ -1,5 +1,9 @@
 #include <OpenPHRI/drivers/driver.h>
 
+#include <yaml-cpp/yaml.h>
+#include <dlfcn.h>
+#include <iostream>
+
 using namespace phri;
 
 Driver::Driver(
@@ -34,3 +38,29 @@ bool Driver::sync() {
 double Driver::getSampleTime() const {
 	return sample_time_;
 }
+
+DriverCapabilities Driver::capabilities() const {
+	return DriverCapabilities();
+}
+
+bool DriverFactory::loadPlugin(const std::string& name, const YAML::Node& configuration) {
+	std::vector<std::string> libraries;
+	const auto& driver = configuration["driver"];
+	if(driver and driver["plugin"]) {
+		libraries.push_back(driver["plugin"].as<std::string>());
+	}
+	else {
+		libraries.push_back("libopen-phri-" + name + "-driver.so");
+		libraries.push_back("libopen-phri-" + name + "-driver-dbg.so");
+	}
+
+	for(const auto& library: libraries) {
+		// The handle is never closed since the registered create methods point inside the library
+		if(dlopen(library.c_str(), RTLD_NOW | RTLD_GLOBAL) != nullptr) {
+			return true;
+		}
+	}
+
+	std::cerr << "[phri::DriverFactory] Can't load a plugin for the driver '" << name << "': " << dlerror() << std::endl;
+	return false;
+}
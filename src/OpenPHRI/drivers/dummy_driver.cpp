@@ -13,7 +13,8 @@ bool DummyDriver::registered_in_factory = phri::DriverFactory::add<DummyDriver>(
 DummyDriver::DummyDriver(
 	phri::RobotPtr robot,
 	double sample_time) :
-	Driver(robot, sample_time)
+	Driver(robot, sample_time),
+	first_sync_(true)
 {
 
 }
@@ -21,7 +22,8 @@ DummyDriver::DummyDriver(
 DummyDriver::DummyDriver(
 	const phri::RobotPtr& robot,
 	const YAML::Node& configuration) :
-	Driver(robot, 0.)
+	Driver(robot, 0.),
+	first_sync_(true)
 {
 	const auto& driver = configuration["driver"];
 
@@ -61,7 +63,15 @@ bool DummyDriver::stop() {
 }
 
 bool DummyDriver::sync() {
-	std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int>(sample_time_ * 1e6)));
+	const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(sample_time_));
+	auto now = std::chrono::steady_clock::now();
+	// Restart from the current time on the first call or if more than a period has been missed
+	if(first_sync_ or now > next_sync_time_ + period) {
+		next_sync_time_ = now;
+		first_sync_ = false;
+	}
+	next_sync_time_ += period;
+	std::this_thread::sleep_until(next_sync_time_);
 	return true;
 }
 
@@ -0,0 +1,203 @@
+/*      File: simulation_driver.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/drivers/simulation_driver.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <yaml-cpp/yaml.h>
+#include <thread>
+
+using namespace phri;
+using namespace std;
+
+bool SimulationDriver::registered_in_factory = phri::DriverFactory::add<SimulationDriver>("simulation");
+
+SimulationDriver::SimulationDriver(
+	phri::RobotPtr robot,
+	double sample_time,
+	RobotModelPtr model,
+	bool free_run) :
+	Driver(robot, sample_time),
+	model_(model),
+	free_run_(free_run),
+	time_(std::make_shared<double>(0.)),
+	next_cycle_(std::chrono::steady_clock::now())
+{
+
+}
+
+SimulationDriver::SimulationDriver(
+	const phri::RobotPtr& robot,
+	const YAML::Node& configuration) :
+	Driver(robot, 0.),
+	free_run_(false),
+	time_(std::make_shared<double>(0.)),
+	next_cycle_(std::chrono::steady_clock::now())
+{
+	const auto& driver = configuration["driver"];
+
+	if(driver) {
+		try {
+			sample_time_ = driver["sample_time"].as<double>();
+		}
+		catch(...) {
+			throw std::runtime_error(OPEN_PHRI_ERROR("You must provide a 'sample_time' field in the driver configuration."));
+		}
+
+		free_run_ = driver["free_run"].as<bool>(false);
+
+		if(driver["init_joint_positions"]) {
+			auto init_joint_positions = driver["init_joint_positions"].as<std::vector<double>>();
+			if(init_joint_positions.size() != robot_->jointCount()) {
+				throw std::runtime_error(OPEN_PHRI_ERROR("The number of values in 'init_joint_positions' does not match the number of joints."));
+			}
+			for (size_t i = 0; i < robot_->jointCount(); ++i) {
+				(*robot_->jointCurrentPosition())(i) = init_joint_positions[i] * M_PI/180.;
+			}
+		}
+
+		for(const auto& contact: driver["contacts"]) {
+			try {
+				auto wrench = contact["wrench"].as<std::vector<double>>();
+				if(wrench.size() != 6) {
+					throw std::runtime_error("");
+				}
+				addContact(
+					contact["start"].as<double>(),
+					contact["end"].as<double>(),
+					Vector6d(Eigen::Map<const Vector6d>(wrench.data())));
+			}
+			catch(...) {
+				throw std::runtime_error(OPEN_PHRI_ERROR("Each contact must provide 'start', 'end' and 'wrench' (6 values) fields."));
+			}
+		}
+
+		for(const auto& wall: driver["walls"]) {
+			try {
+				auto point = wall["point"].as<std::vector<double>>();
+				auto normal = wall["normal"].as<std::vector<double>>();
+				if(point.size() != 3 or normal.size() != 3) {
+					throw std::runtime_error("");
+				}
+				addWall(
+					Vector3d(Eigen::Map<const Vector3d>(point.data())),
+					Vector3d(Eigen::Map<const Vector3d>(normal.data())),
+					wall["stiffness"].as<double>());
+			}
+			catch(...) {
+				throw std::runtime_error(OPEN_PHRI_ERROR("Each wall must provide 'point' (3 values), 'normal' (3 values) and 'stiffness' fields."));
+			}
+		}
+	}
+	else {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The configuration file doesn't include a 'driver' field."));
+	}
+
+	if(configuration["model"]) {
+		model_ = std::make_shared<RobotModel>(robot_, configuration);
+	}
+}
+
+SimulationDriver::~SimulationDriver() = default;
+
+bool SimulationDriver::start(double timeout) {
+	next_cycle_ = std::chrono::steady_clock::now();
+	return true;
+}
+
+bool SimulationDriver::stop() {
+	return true;
+}
+
+bool SimulationDriver::read() {
+	if(not free_run_) {
+		next_cycle_ += std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(sample_time_));
+		std::this_thread::sleep_until(next_cycle_);
+	}
+	if(model_) {
+		model_->forwardKinematics();
+	}
+	computeExternalForce();
+	return true;
+}
+
+bool SimulationDriver::send() {
+	auto& joint_position = *robot_->jointCurrentPosition();
+	joint_position += *robot_->jointVelocity() * sample_time_;
+	if(model_) {
+		model_->getJointLimits()->clampPosition(joint_position);
+	}
+	*time_ += sample_time_;
+	return true;
+}
+
+DriverCapabilities SimulationDriver::capabilities() const {
+	DriverCapabilities capabilities;
+	capabilities.external_force = true;
+	capabilities.kinematics = static_cast<bool>(model_);
+	capabilities.synchronous = true;
+	capabilities.self_paced = not free_run_;
+	return capabilities;
+}
+
+void SimulationDriver::addContact(double start_time, double end_time, const Vector6d& wrench) {
+	Contact contact;
+	contact.start_time = start_time;
+	contact.end_time = end_time;
+	contact.wrench = wrench;
+	contacts_.push_back(contact);
+}
+
+void SimulationDriver::addWall(const Vector3d& point, const Vector3d& normal, double stiffness) {
+	Wall wall;
+	wall.point = point;
+	wall.normal = normal.normalized();
+	wall.stiffness = stiffness;
+	walls_.push_back(wall);
+}
+
+void SimulationDriver::setFreeRun(bool state) {
+	free_run_ = state;
+	next_cycle_ = std::chrono::steady_clock::now();
+}
+
+doubleConstPtr SimulationDriver::getTime() const {
+	return time_;
+}
+
+void SimulationDriver::computeExternalForce() {
+	Vector6d wrench = Vector6d::Zero();
+
+	for(const auto& contact: contacts_) {
+		if(*time_ >= contact.start_time and *time_ < contact.end_time) {
+			wrench += contact.wrench;
+		}
+	}
+
+	const auto& position = robot_->controlPointCurrentPose()->translation();
+	for(const auto& wall: walls_) {
+		double penetration = (position - wall.point).dot(wall.normal);
+		if(penetration < 0.) {
+			wrench.block<3,1>(0,0) -= wall.stiffness * penetration * wall.normal;
+		}
+	}
+
+	// The external force is expressed in the control point frame
+	*robot_->controlPointExternalForce() = robot_->spatialTransformationMatrix()->transpose() * wrench;
+}
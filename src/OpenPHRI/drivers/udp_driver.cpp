@@ -0,0 +1,267 @@
+/*      File: udp_driver.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/drivers/udp_driver.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cmath>
+#include <cstring>
+
+using namespace phri;
+using namespace std;
+
+bool UDPDriver::registered_in_factory = phri::DriverFactory::add<UDPDriver>("udp");
+
+namespace {
+
+uint64_t nanoseconds(std::chrono::steady_clock::time_point time) {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+// A single lost or late state must not make read() fail
+constexpr double default_read_timeout_periods = 10.;
+
+}
+
+UDPDriver::UDPDriver(
+	phri::RobotPtr robot,
+	double sample_time,
+	const std::string& server_ip,
+	int server_port,
+	int local_port,
+	double read_timeout) :
+	Driver(robot, sample_time),
+	socket_(-1),
+	read_timeout_(read_timeout < 0. ? default_read_timeout_periods * sample_time : read_timeout),
+	command_sequence_(0),
+	state_sequence_(0),
+	state_received_(false)
+{
+	open(server_ip, server_port, local_port);
+}
+
+UDPDriver::UDPDriver(
+	const phri::RobotPtr& robot,
+	const YAML::Node& configuration) :
+	Driver(robot, 0.),
+	socket_(-1),
+	command_sequence_(0),
+	state_sequence_(0),
+	state_received_(false)
+{
+	const auto& driver = configuration["driver"];
+
+	if(driver) {
+		std::string ip;
+		int port;
+		try {
+			sample_time_ = driver["sample_time"].as<double>();
+		}
+		catch(...) {
+			throw std::runtime_error(OPEN_PHRI_ERROR("You must provide a 'sample_time' field in the driver configuration."));
+		}
+		try {
+			ip = driver["ip"].as<std::string>();
+			port = driver["port"].as<int>();
+		}
+		catch(...) {
+			throw std::runtime_error(OPEN_PHRI_ERROR("You must provide the 'ip' and 'port' fields in the driver configuration."));
+		}
+		read_timeout_ = driver["read_timeout"].as<double>(default_read_timeout_periods * sample_time_);
+		open(ip, port, driver["local_port"].as<int>(0));
+	}
+	else {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The configuration file doesn't include a 'driver' field."));
+	}
+}
+
+UDPDriver::~UDPDriver() {
+	if(socket_ >= 0) {
+		close(socket_);
+	}
+}
+
+void UDPDriver::open(const std::string& server_ip, int server_port, int local_port) {
+	if(robot_->jointCount() > udp_max_joint_count) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The UDP protocol is limited to " + std::to_string(udp_max_joint_count) + " joints."));
+	}
+
+	socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+	if(socket_ < 0) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Can't create the UDP socket: " + std::string(strerror(errno))));
+	}
+
+	// The destructor is not called if the constructor throws, so the socket must be closed here
+	auto fail = [this](const std::string& message) {
+		close(socket_);
+		socket_ = -1;
+		throw std::runtime_error(message);
+	};
+
+	sockaddr_in local_address;
+	std::memset(&local_address, 0, sizeof(local_address));
+	local_address.sin_family = AF_INET;
+	local_address.sin_addr.s_addr = htonl(INADDR_ANY);
+	local_address.sin_port = htons(local_port);
+	if(bind(socket_, reinterpret_cast<sockaddr*>(&local_address), sizeof(local_address)) < 0) {
+		fail(OPEN_PHRI_ERROR("Can't bind the UDP socket to port " + std::to_string(local_port) + ": " + std::string(strerror(errno))));
+	}
+
+	// Connecting the socket filters out the packets not coming from the server
+	sockaddr_in server_address;
+	std::memset(&server_address, 0, sizeof(server_address));
+	server_address.sin_family = AF_INET;
+	server_address.sin_port = htons(server_port);
+	if(inet_pton(AF_INET, server_ip.c_str(), &server_address.sin_addr) != 1) {
+		fail(OPEN_PHRI_ERROR("Invalid server IP address " + server_ip));
+	}
+	if(connect(socket_, reinterpret_cast<sockaddr*>(&server_address), sizeof(server_address)) < 0) {
+		fail(OPEN_PHRI_ERROR("Can't connect the UDP socket to " + server_ip + ":" + std::to_string(server_port) + ": " + std::string(strerror(errno))));
+	}
+
+	std::memset(&state_packet_, 0, sizeof(state_packet_));
+	std::memset(&command_packet_, 0, sizeof(command_packet_));
+	command_packet_.header.magic = udp_protocol_magic;
+	command_packet_.header.version = udp_protocol_version;
+	command_packet_.header.type = UDPPacketType::Command;
+	command_packet_.header.joint_count = robot_->jointCount();
+}
+
+bool UDPDriver::start(double timeout) {
+	// Let the server know where to send the states
+	return send();
+}
+
+bool UDPDriver::stop() {
+	return true;
+}
+
+bool UDPDriver::read() {
+	// The server only knows us after a first command
+	if(not state_received_) {
+		send();
+	}
+
+	bool new_state = false;
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(read_timeout_);
+	while(true) {
+		// Wait for a first state, then only drain the already received ones
+		int timeout_ms = 0;
+		if(not new_state) {
+			auto remaining = std::chrono::duration<double, std::milli>(deadline - std::chrono::steady_clock::now()).count();
+			timeout_ms = static_cast<int>(std::ceil(std::max(remaining, 0.)));
+		}
+		if(not receiveState(timeout_ms)) {
+			if(new_state or std::chrono::steady_clock::now() >= deadline) {
+				break;
+			}
+			continue;
+		}
+		new_state = true;
+	}
+
+	if(not new_state) {
+		++statistics_.timeouts;
+		return false;
+	}
+
+	const auto joint_count = robot_->jointCount();
+	*robot_->jointCurrentPosition() = Eigen::Map<const VectorXd>(state_packet_.joint_position, joint_count);
+	*robot_->controlPointExternalForce() = Eigen::Map<const Vector6d>(state_packet_.external_force);
+
+	auto acknowledge = state_packet_.header.acknowledge;
+	if(acknowledge > 0 and command_sequence_ - acknowledge < command_times_.size()) {
+		statistics_.round_trip_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - command_times_[acknowledge % command_times_.size()]).count();
+	}
+
+	return true;
+}
+
+bool UDPDriver::receiveState(int timeout_ms) {
+	pollfd poll_fd;
+	poll_fd.fd = socket_;
+	poll_fd.events = POLLIN;
+	if(poll(&poll_fd, 1, timeout_ms) <= 0) {
+		return false;
+	}
+
+	UDPStatePacket packet;
+	auto size = recv(socket_, &packet, sizeof(packet), 0);
+	if(size < 0) {
+		// e.g. connection refused because the server is not started yet
+		return false;
+	}
+
+	if(not isValidUDPPacket(packet.header, size, sizeof(packet), UDPPacketType::State) or packet.header.joint_count != robot_->jointCount()) {
+		++statistics_.invalid_packets;
+		return false;
+	}
+	++statistics_.received_packets;
+
+	auto sequence = packet.header.sequence;
+	if(state_received_) {
+		// Signed difference to handle the sequence number wrap around
+		auto difference = static_cast<int32_t>(sequence - state_sequence_);
+		if(difference <= 0) {
+			++statistics_.out_of_order_packets;
+			return false;
+		}
+		statistics_.lost_packets += difference - 1;
+	}
+
+	state_sequence_ = sequence;
+	state_received_ = true;
+	state_packet_ = packet;
+	return true;
+}
+
+bool UDPDriver::send() {
+	auto now = std::chrono::steady_clock::now();
+	command_packet_.header.sequence = ++command_sequence_;
+	command_packet_.header.acknowledge = state_sequence_;
+	command_packet_.header.timestamp = nanoseconds(now);
+	Eigen::Map<VectorXd>(command_packet_.joint_velocity, robot_->jointCount()) = *robot_->jointVelocity();
+
+	command_times_[command_sequence_ % command_times_.size()] = now;
+	ssize_t sent = ::send(socket_, &command_packet_, sizeof(command_packet_), 0);
+	if(sent != static_cast<ssize_t>(sizeof(command_packet_))) {
+		return false;
+	}
+	++statistics_.sent_packets;
+	return true;
+}
+
+DriverCapabilities UDPDriver::capabilities() const {
+	DriverCapabilities capabilities;
+	capabilities.external_force = true;
+	// read() waits for the next state sent by the server
+	capabilities.self_paced = true;
+	return capabilities;
+}
+
+const UDPDriver::Statistics& UDPDriver::statistics() const {
+	return statistics_;
+}
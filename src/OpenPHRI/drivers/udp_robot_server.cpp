@@ -0,0 +1,179 @@
+/*      File: udp_robot_server.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/drivers/udp_robot_server.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+
+using namespace phri;
+
+UDPRobotServer::UDPRobotServer(size_t joint_count, double sample_time, int port) :
+	sample_time_(sample_time),
+	joint_count_(joint_count),
+	running_(false),
+	drop_period_(0),
+	received_commands_(0),
+	joint_position_(VectorXd::Zero(joint_count)),
+	joint_velocity_(VectorXd::Zero(joint_count)),
+	external_force_(Vector6d::Zero()),
+	state_sequence_(0),
+	command_sequence_(0),
+	client_known_(false)
+{
+	if(joint_count > udp_max_joint_count) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The UDP protocol is limited to " + std::to_string(udp_max_joint_count) + " joints."));
+	}
+
+	socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+	if(socket_ < 0) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Can't create the UDP socket: " + std::string(strerror(errno))));
+	}
+
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons(port);
+	if(bind(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+		close(socket_);
+		throw std::runtime_error(OPEN_PHRI_ERROR("Can't bind the UDP socket to port " + std::to_string(port) + ": " + std::string(strerror(errno))));
+	}
+
+	std::memset(&client_address_, 0, sizeof(client_address_));
+	std::memset(&state_packet_, 0, sizeof(state_packet_));
+	state_packet_.header.magic = udp_protocol_magic;
+	state_packet_.header.version = udp_protocol_version;
+	state_packet_.header.type = UDPPacketType::State;
+	state_packet_.header.joint_count = joint_count_;
+}
+
+UDPRobotServer::~UDPRobotServer() {
+	stop();
+	close(socket_);
+}
+
+void UDPRobotServer::start() {
+	if(not running_) {
+		running_ = true;
+		thread_ = std::thread(&UDPRobotServer::run, this);
+	}
+}
+
+void UDPRobotServer::stop() {
+	running_ = false;
+	if(thread_.joinable()) {
+		thread_.join();
+	}
+}
+
+void UDPRobotServer::setJointPosition(const VectorXd& position) {
+	std::lock_guard<std::mutex> lock(state_mutex_);
+	joint_position_ = position;
+}
+
+VectorXd UDPRobotServer::getJointPosition() const {
+	std::lock_guard<std::mutex> lock(state_mutex_);
+	return joint_position_;
+}
+
+void UDPRobotServer::setExternalForce(const Vector6d& force) {
+	std::lock_guard<std::mutex> lock(state_mutex_);
+	external_force_ = force;
+}
+
+void UDPRobotServer::setStateDropPeriod(size_t period) {
+	drop_period_ = period;
+}
+
+uint64_t UDPRobotServer::receivedCommands() const {
+	return received_commands_;
+}
+
+void UDPRobotServer::run() {
+	const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(sample_time_));
+	auto next_period = std::chrono::steady_clock::now();
+	while(running_) {
+		next_period += period;
+
+		receiveCommands();
+		{
+			std::lock_guard<std::mutex> lock(state_mutex_);
+			joint_position_ += joint_velocity_ * sample_time_;
+		}
+		sendState();
+
+		std::this_thread::sleep_until(next_period);
+	}
+}
+
+void UDPRobotServer::receiveCommands() {
+	pollfd poll_fd;
+	poll_fd.fd = socket_;
+	poll_fd.events = POLLIN;
+	// Only keep the most recent command
+	while(poll(&poll_fd, 1, 0) > 0) {
+		UDPCommandPacket packet;
+		sockaddr_in address;
+		socklen_t address_length = sizeof(address);
+		auto size = recvfrom(socket_, &packet, sizeof(packet), 0, reinterpret_cast<sockaddr*>(&address), &address_length);
+		if(size < 0) {
+			break;
+		}
+		if(not isValidUDPPacket(packet.header, size, sizeof(packet), UDPPacketType::Command) or packet.header.joint_count != joint_count_) {
+			continue;
+		}
+		++received_commands_;
+		// A new client resets the sequence numbering
+		bool new_client = not client_known_ or address.sin_addr.s_addr != client_address_.sin_addr.s_addr or address.sin_port != client_address_.sin_port;
+		if(not new_client and static_cast<int32_t>(packet.header.sequence - command_sequence_) <= 0) {
+			continue;
+		}
+		client_address_ = address;
+		client_known_ = true;
+		command_sequence_ = packet.header.sequence;
+
+		std::lock_guard<std::mutex> lock(state_mutex_);
+		joint_velocity_ = Eigen::Map<const VectorXd>(packet.joint_velocity, joint_count_);
+	}
+}
+
+void UDPRobotServer::sendState() {
+	++state_sequence_;
+	size_t drop_period = drop_period_;
+	if(not client_known_ or (drop_period > 0 and state_sequence_ % drop_period == 0)) {
+		return;
+	}
+
+	state_packet_.header.sequence = state_sequence_;
+	state_packet_.header.acknowledge = command_sequence_;
+	state_packet_.header.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	{
+		std::lock_guard<std::mutex> lock(state_mutex_);
+		Eigen::Map<VectorXd>(state_packet_.joint_position, joint_count_) = joint_position_;
+		Eigen::Map<Vector6d>(state_packet_.external_force) = external_force_;
+	}
+
+	sendto(socket_, &state_packet_, sizeof(state_packet_), 0, reinterpret_cast<const sockaddr*>(&client_address_), sizeof(client_address_));
+}
@@ -41,3 +41,9 @@ Vector6d ForceGenerator::transform(const Vector6d& force) {
 Vector6d ForceGenerator::operator()() {
 	return compute();
 }
+
+void ForceGenerator::saveState(StateWriter& writer) const {
+}
+
+void ForceGenerator::restoreState(StateReader& reader) {
+}
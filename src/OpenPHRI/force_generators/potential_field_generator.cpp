@@ -19,14 +19,29 @@
 
 #include <OpenPHRI/force_generators/potential_field_generator.h>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace phri;
 using namespace Eigen;
 
+namespace {
+
+// Below this number of static repulsive objects, a linear pass is as fast as a grid query (measured crossover around 100)
+constexpr size_t grid_min_objects = 128;
+// Building the grid costs about two linear passes, so it is only built once the objects have stopped moving for a few cycles
+constexpr size_t grid_min_static_cycles = 2;
+constexpr double min_distance = 1e-3;
+
+}
 
 PotentialFieldGenerator::PotentialFieldGenerator(
 	ReferenceFrame objects_frame) :
 	ForceGenerator(objects_frame),
-	objects_frame_(objects_frame)
+	objects_frame_(objects_frame),
+	objects_changed_(true),
+	grid_valid_(false),
+	static_cycles_(0)
 {
 	offset_ = std::make_shared<Vector3d>(Vector3d::Zero());
 }
@@ -39,8 +54,25 @@ PotentialFieldGenerator::PotentialFieldGenerator(
 	offset_ = offset;
 }
 
+bool PotentialFieldGenerator::add(const std::string& name, PotentialFieldObjectPtr item, bool force) {
+	bool ok = ObjectCollection<PotentialFieldObjectPtr>::add(name, item, force);
+	objects_changed_ |= ok;
+	return ok;
+}
+
+bool PotentialFieldGenerator::remove(const std::string& name) {
+	bool ok = ObjectCollection<PotentialFieldObjectPtr>::remove(name);
+	objects_changed_ |= ok;
+	return ok;
+}
+
+void PotentialFieldGenerator::setPointCloud(PointCloudConstPtr point_cloud, doubleConstPtr gain, doubleConstPtr threshold_distance) {
+	point_cloud_ = point_cloud;
+	point_cloud_gain_ = gain;
+	point_cloud_threshold_distance_ = threshold_distance;
+}
+
 void PotentialFieldGenerator::update(Vector6d& force) {
-	Vector3d total_force = Vector3d::Zero();
 	Vector3d rob_pos;
 
 	if(objects_frame_ == ReferenceFrame::TCP) {
@@ -50,28 +82,121 @@ void PotentialFieldGenerator::update(Vector6d& force) {
 		rob_pos = robot_->controlPointCurrentPose()->translation() + robot_->transformationMatrix()->block<3,3>(0,0) * *offset_;
 	}
 
+	if(objects_changed_) {
+		updateObjects();
+	}
+
+	force.segment<3>(0) = attractiveForce(rob_pos) + repulsiveForce(rob_pos);
+	if(point_cloud_) {
+		force.segment<3>(0) += point_cloud_->repulsiveForce(rob_pos, *point_cloud_gain_, *point_cloud_threshold_distance_);
+	}
+	force.segment<3>(3) = Vector3d::Zero();
+}
+
+void PotentialFieldGenerator::updateObjects() {
+	attractive_objects_.clear();
+	repulsive_objects_.clear();
 	for(const auto& item : items_) {
-		const PotentialFieldObject& obj = *(item.second);
-		Vector3d obj_rob_vec = obj.object_position->translation() - rob_pos;
+		if(item.second->type == PotentialFieldType::Attractive) {
+			attractive_objects_.push_back(item.second.get());
+		}
+		else {
+			repulsive_objects_.push_back(item.second.get());
+		}
+	}
 
+	const size_t count = repulsive_objects_.size();
+	repulsive_x_.resize(count);
+	repulsive_y_.resize(count);
+	repulsive_z_.resize(count);
+	repulsive_gain_.resize(count);
+	repulsive_threshold_.resize(count);
+
+	objects_changed_ = false;
+	grid_valid_ = false;
+	static_cycles_ = 0;
+}
+
+Vector3d PotentialFieldGenerator::attractiveForce(const Vector3d& rob_pos) const {
+	Vector3d total_force = Vector3d::Zero();
+	for(const auto obj : attractive_objects_) {
+		Vector3d obj_rob_vec = obj->object_position->translation() - rob_pos;
 		double distance = obj_rob_vec.norm();
-		if(std::abs(distance) > 1e-3) {
-			Vector3d obj_rob_vec_unit = obj_rob_vec/distance;
-
-			double gain = *obj.gain;
-
-			if(obj.type == PotentialFieldType::Attractive) {
-				total_force += gain * obj_rob_vec_unit;
-			}
-			else {
-				double th = *obj.threshold_distance;
-				if(distance < th) {
-					total_force += gain * (1./th - 1./distance)*obj_rob_vec_unit;
-				}
-			}
+		if(distance > min_distance) {
+			total_force += *obj->gain * obj_rob_vec / distance;
 		}
 	}
+	return total_force;
+}
 
-	force.segment<3>(0) = total_force;
-	force.segment<3>(3) = Vector3d::Zero();
+Vector3d PotentialFieldGenerator::repulsiveForce(const Vector3d& rob_pos) {
+	const size_t count = repulsive_objects_.size();
+
+	// Gather the current object parameters and check if they have moved
+	bool moved = false;
+	double max_threshold = 0.;
+	for (size_t i = 0; i < count; ++i) {
+		const auto& obj = *repulsive_objects_[i];
+		const auto& position = obj.object_position->translation();
+		const double threshold = *obj.threshold_distance;
+		if(position.x() != repulsive_x_[i] or position.y() != repulsive_y_[i] or position.z() != repulsive_z_[i] or threshold != repulsive_threshold_[i]) {
+			repulsive_x_[i] = position.x();
+			repulsive_y_[i] = position.y();
+			repulsive_z_[i] = position.z();
+			repulsive_threshold_[i] = threshold;
+			moved = true;
+		}
+		repulsive_gain_[i] = *obj.gain;
+		max_threshold = std::max(max_threshold, threshold);
+	}
+
+	if(moved) {
+		grid_valid_ = false;
+		static_cycles_ = 0;
+	}
+	else if(static_cycles_ < grid_min_static_cycles) {
+		++static_cycles_;
+	}
+
+	Vector3d total_force = Vector3d::Zero();
+	const bool use_grid = count >= grid_min_objects and static_cycles_ >= grid_min_static_cycles and max_threshold > 0. and std::isfinite(max_threshold);
+	if(not use_grid) {
+		// Pass over all the objects, the ones out of range being masked by a select. Multiplying by zero instead would give
+		// a NaN for a zero threshold distance, since its inverse is infinite
+		double fx = 0., fy = 0., fz = 0.;
+		for (size_t i = 0; i < count; ++i) {
+			const double dx = repulsive_x_[i] - rob_pos.x();
+			const double dy = repulsive_y_[i] - rob_pos.y();
+			const double dz = repulsive_z_[i] - rob_pos.z();
+			const double distance = std::max(std::sqrt(dx*dx + dy*dy + dz*dz), min_distance);
+			const bool in_range = distance > min_distance and distance < repulsive_threshold_[i];
+			const double scale = in_range ? repulsive_gain_[i] * (1./repulsive_threshold_[i] - 1./distance) / distance : 0.;
+			fx += scale * dx;
+			fy += scale * dy;
+			fz += scale * dz;
+		}
+		total_force << fx, fy, fz;
+	}
+	else {
+		// Objects closer than their threshold distance are in the cells around the robot since the cell size is the largest threshold
+		if(not grid_valid_) {
+			grid_.build(repulsive_x_.data(), repulsive_y_.data(), repulsive_z_.data(), count, max_threshold);
+			grid_valid_ = true;
+		}
+		grid_.forEachNear(rob_pos.x(), rob_pos.y(), rob_pos.z(),
+			[this, &rob_pos, &total_force](size_t index) {
+				addRepulsiveForce(index, rob_pos, total_force);
+			});
+	}
+
+	return total_force;
+}
+
+void PotentialFieldGenerator::addRepulsiveForce(size_t index, const Vector3d& rob_pos, Vector3d& force) const {
+	const Vector3d obj_rob_vec(repulsive_x_[index] - rob_pos.x(), repulsive_y_[index] - rob_pos.y(), repulsive_z_[index] - rob_pos.z());
+	const double distance = obj_rob_vec.norm();
+	const double threshold = repulsive_threshold_[index];
+	if(distance > min_distance and distance < threshold) {
+		force += repulsive_gain_[index] * (1./threshold - 1./distance) * obj_rob_vec / distance;
+	}
 }
@@ -30,3 +30,9 @@ VectorXd JointVelocityGenerator::compute() {
 VectorXd JointVelocityGenerator::operator()() {
 	return compute();
 }
+
+void JointVelocityGenerator::saveState(StateWriter& writer) const {
+}
+
+void JointVelocityGenerator::restoreState(StateReader& reader) {
+}
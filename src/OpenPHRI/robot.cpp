@@ -19,6 +19,7 @@
 
 #include <OpenPHRI/robot.h>
 #include <OpenPHRI/utilities/exceptions.h>
+#include <OpenPHRI/utilities/state_snapshot.h>
 
 #include <yaml-cpp/yaml.h>
 
@@ -249,3 +250,86 @@ Matrix4dPtr Robot::transformationMatrix() const {
 Matrix6dPtr Robot::spatialTransformationMatrix() const {
 	return spatial_transformation_matrix_;
 }
+
+void Robot::saveState(StateWriter& writer) const {
+	writer.write<uint64_t>(joint_count_);
+
+	writer.writeMatrix(*joint_damping_matrix_);
+	writer.writeMatrix(*control_point_damping_matrix_);
+
+	writer.writeMatrix(*joint_velocity_);
+	writer.writeMatrix(*joint_velocity_sum_);
+	writer.writeMatrix(*joint_torque_sum_);
+	writer.writeMatrix(*joint_velocity_command_);
+	writer.writeMatrix(*joint_total_velocity_);
+	writer.writeMatrix(*joint_total_torque_);
+
+	writer.writeMatrix(*joint_current_position_);
+	writer.writeMatrix(*joint_target_position_);
+	writer.writeMatrix(*joint_external_torque_);
+
+	writer.writeMatrix(static_cast<const Vector6d&>(*control_point_velocity_));
+	writer.writeMatrix(static_cast<const Vector6d&>(*control_point_velocity_sum_));
+	writer.writeMatrix(*control_point_force_sum_);
+	writer.writeMatrix(static_cast<const Vector6d&>(*control_point_velocity_command_));
+	writer.writeMatrix(static_cast<const Vector6d&>(*control_point_total_velocity_));
+	writer.writeMatrix(*control_point_total_force_);
+
+	writer.writeMatrix(control_point_current_pose_->translation());
+	writer.writeMatrix(control_point_current_pose_->orientation().coeffs());
+	writer.writeMatrix(control_point_target_pose_->translation());
+	writer.writeMatrix(control_point_target_pose_->orientation().coeffs());
+	writer.writeMatrix(static_cast<const Vector6d&>(*control_point_current_velocity_));
+	writer.writeMatrix(static_cast<const Vector6d&>(*control_point_current_acceleration_));
+	writer.writeMatrix(*control_point_external_force_);
+
+	writer.write(*scaling_factor_);
+
+	writer.writeMatrix(*jacobian_);
+	writer.writeMatrix(*jacobian_inverse_);
+	writer.writeMatrix(*transformation_matrix_);
+	writer.writeMatrix(*spatial_transformation_matrix_);
+}
+
+void Robot::restoreState(StateReader& reader) {
+	auto joint_count = reader.read<uint64_t>();
+	if(joint_count != joint_count_) {
+		throw std::length_error(OPEN_PHRI_ERROR("The stored state is for a robot with " + std::to_string(joint_count) + " joints but this one has " + std::to_string(joint_count_)));
+	}
+
+	reader.readMatrix(*joint_damping_matrix_);
+	reader.readMatrix(*control_point_damping_matrix_);
+
+	reader.readMatrix(*joint_velocity_);
+	reader.readMatrix(*joint_velocity_sum_);
+	reader.readMatrix(*joint_torque_sum_);
+	reader.readMatrix(*joint_velocity_command_);
+	reader.readMatrix(*joint_total_velocity_);
+	reader.readMatrix(*joint_total_torque_);
+
+	reader.readMatrix(*joint_current_position_);
+	reader.readMatrix(*joint_target_position_);
+	reader.readMatrix(*joint_external_torque_);
+
+	reader.readMatrix(static_cast<Vector6d&>(*control_point_velocity_));
+	reader.readMatrix(static_cast<Vector6d&>(*control_point_velocity_sum_));
+	reader.readMatrix(*control_point_force_sum_);
+	reader.readMatrix(static_cast<Vector6d&>(*control_point_velocity_command_));
+	reader.readMatrix(static_cast<Vector6d&>(*control_point_total_velocity_));
+	reader.readMatrix(*control_point_total_force_);
+
+	reader.readMatrix(control_point_current_pose_->translation());
+	reader.readMatrix(control_point_current_pose_->orientation().coeffs());
+	reader.readMatrix(control_point_target_pose_->translation());
+	reader.readMatrix(control_point_target_pose_->orientation().coeffs());
+	reader.readMatrix(static_cast<Vector6d&>(*control_point_current_velocity_));
+	reader.readMatrix(static_cast<Vector6d&>(*control_point_current_acceleration_));
+	reader.readMatrix(*control_point_external_force_);
+
+	reader.read(*scaling_factor_);
+
+	reader.readMatrix(*jacobian_);
+	reader.readMatrix(*jacobian_inverse_);
+	reader.readMatrix(*transformation_matrix_);
+	reader.readMatrix(*spatial_transformation_matrix_);
+}
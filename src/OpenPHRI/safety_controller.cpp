@@ -25,6 +25,7 @@
 #include <OpenPHRI/velocity_generators/velocity_generator.h>
 #include <OpenPHRI/joint_velocity_generators/joint_velocity_generator.h>
 #include <OpenPHRI/utilities/demangle.h>
+#include <OpenPHRI/utilities/state_snapshot.h>
 
 #include <Eigen/SVD>
 #include <yaml-cpp/yaml.h>
@@ -34,11 +35,49 @@
 
 using namespace phri;
 
+namespace {
+
+template<typename CollectionT>
+void saveItems(StateWriter& writer, const CollectionT& items) {
+	writer.write<uint32_t>(std::distance(items.begin(), items.end()));
+	for(const auto& item: items) {
+		writer.writeString(item.first);
+		writer.writeValue(item.second.last_value);
+		writer.writeBlock(
+			[&item](StateWriter& block) {
+				item.second.object->saveState(block);
+			});
+	}
+}
+
+template<typename CollectionT>
+void restoreItems(StateReader& reader, CollectionT& items, const std::string& collection_name) {
+	auto count = reader.read<uint32_t>();
+	if(static_cast<ptrdiff_t>(count) != std::distance(items.begin(), items.end())) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The stored state has " + std::to_string(count) + " " + collection_name + "s but the controller has " + std::to_string(std::distance(items.begin(), items.end()))));
+	}
+	std::string name;
+	for(auto& item: items) {
+		reader.readString(name);
+		if(name != item.first) {
+			throw std::runtime_error(OPEN_PHRI_ERROR("The stored " + collection_name + " '" + name + "' doesn't match the controller's one ('" + item.first + "')"));
+		}
+		reader.readValue(item.second.last_value);
+		reader.readBlock(
+			[&item](StateReader& block) {
+				item.second.object->restoreState(block);
+			});
+	}
+}
+
+}
+
 #define HEAVY_PRINTING 0
 
 SafetyController::SafetyController(
 	RobotPtr robot) :
-	skip_jacobian_inverse_computation_(false)
+	skip_jacobian_inverse_computation_(false),
+	configuration_version_(0)
 {
 	addConstraint("default constraint", std::make_shared<DefaultConstraint>());
 	robot_ = robot;
@@ -81,47 +120,47 @@ void SafetyController::skipJacobianInverseComputation(bool on) {
 
 bool SafetyController::addConstraint(const std::string& name, ConstraintPtr constraint, bool force) {
 	constraint->setRobot(robot_);
-	return constraints_.add(name, {constraint}, force);
+	return itemsChanged(constraints_.add(name, {constraint}, force));
 }
 
 bool SafetyController::addForceGenerator(const std::string& name, ForceGeneratorPtr generator, bool force) {
 	generator->robot_ = robot_;
-	return force_generators_.add(name, {generator}, force);
+	return itemsChanged(force_generators_.add(name, {generator}, force));
 }
 
 bool SafetyController::addTorqueGenerator(const std::string& name, TorqueGeneratorPtr generator, bool force) {
 	generator->robot_ = robot_;
-	return torque_generators_.add(name, {generator}, force);
+	return itemsChanged(torque_generators_.add(name, {generator}, force));
 }
 
 bool SafetyController::addVelocityGenerator(const std::string& name, VelocityGeneratorPtr generator, bool force) {
 	generator->robot_ = robot_;
-	return velocity_generators_.add(name, {generator}, force);
+	return itemsChanged(velocity_generators_.add(name, {generator}, force));
 }
 
 bool SafetyController::addJointVelocityGenerator(const std::string& name, JointVelocityGeneratorPtr generator, bool force) {
 	generator->robot_ = robot_;
-	return joint_velocity_generators_.add(name, {generator}, force);
+	return itemsChanged(joint_velocity_generators_.add(name, {generator}, force));
 }
 
 bool SafetyController::removeConstraint(const std::string& name) {
-	return constraints_.remove(name);
+	return itemsChanged(constraints_.remove(name));
 }
 
 bool SafetyController::removeForceGenerator(const std::string& name) {
-	return force_generators_.remove(name);
+	return itemsChanged(force_generators_.remove(name));
 }
 
 bool SafetyController::removeTorqueGenerator(const std::string& name) {
-	return torque_generators_.remove(name);
+	return itemsChanged(torque_generators_.remove(name));
 }
 
 bool SafetyController::removeVelocityGenerator(const std::string& name) {
-	return velocity_generators_.remove(name);
+	return itemsChanged(velocity_generators_.remove(name));
 }
 
 bool SafetyController::removeJointVelocityGenerator(const std::string& name) {
-	return joint_velocity_generators_.remove(name);
+	return itemsChanged(joint_velocity_generators_.remove(name));
 }
 
 ConstraintPtr SafetyController::getConstraint(const std::string& name) {
@@ -136,6 +175,10 @@ TorqueGeneratorPtr SafetyController::getTorqueGenerator(const std::string& name)
 	return torque_generators_.get(name).object;
 }
 
+VelocityGeneratorPtr SafetyController::getVelocityGenerator(const std::string& name) {
+	return velocity_generators_.get(name).object;
+}
+
 JointVelocityGeneratorPtr SafetyController::getJointVelocityGenerator(const std::string& name) {
 	return joint_velocity_generators_.get(name).object;
 }
@@ -150,22 +193,27 @@ void SafetyController::removeAll() {
 
 void SafetyController::removeAllVelocityInputs() {
 	velocity_generators_.removeAll();
+	++configuration_version_;
 }
 
 void SafetyController::removeAllJointVelocityInputs() {
 	joint_velocity_generators_.removeAll();
+	++configuration_version_;
 }
 
 void SafetyController::removeAllForceInputs() {
 	force_generators_.removeAll();
+	++configuration_version_;
 }
 
 void SafetyController::removeAllTorqueInputs() {
 	torque_generators_.removeAll();
+	++configuration_version_;
 }
 
 void SafetyController::removeAllConstraints() {
 	constraints_.removeAll();
+	++configuration_version_;
 }
 
 
@@ -275,6 +323,49 @@ void SafetyController::operator()() {
 	compute();
 }
 
+void SafetyController::saveState(StateWriter& writer) const {
+	robot_->saveState(writer);
+	saveItems(writer, constraints_);
+	saveItems(writer, force_generators_);
+	saveItems(writer, torque_generators_);
+	saveItems(writer, velocity_generators_);
+	saveItems(writer, joint_velocity_generators_);
+}
+
+void SafetyController::restoreState(StateReader& reader) {
+	robot_->restoreState(reader);
+	restoreItems(reader, constraints_, "constraint");
+	restoreItems(reader, force_generators_, "force generator");
+	restoreItems(reader, torque_generators_, "torque generator");
+	restoreItems(reader, velocity_generators_, "velocity generator");
+	restoreItems(reader, joint_velocity_generators_, "joint velocity generator");
+}
+
+void SafetyController::swapConfiguration(SafetyController& other) {
+	assert(robot_ == other.robot_);
+	constraints_.swap(other.constraints_);
+	force_generators_.swap(other.force_generators_);
+	torque_generators_.swap(other.torque_generators_);
+	velocity_generators_.swap(other.velocity_generators_);
+	joint_velocity_generators_.swap(other.joint_velocity_generators_);
+	std::swap(dynamic_dls_, other.dynamic_dls_);
+	std::swap(lambda2_, other.lambda2_);
+	std::swap(sigma_min_threshold_, other.sigma_min_threshold_);
+	++configuration_version_;
+	++other.configuration_version_;
+}
+
+size_t SafetyController::configurationVersion() const {
+	return configuration_version_;
+}
+
+bool SafetyController::itemsChanged(bool changed) {
+	if(changed) {
+		++configuration_version_;
+	}
+	return changed;
+}
+
 SafetyController::storage_const_iterator<Constraint> SafetyController::constraints_begin() const {
 	return constraints_.begin();
 }
@@ -29,3 +29,9 @@ VectorXd TorqueGenerator::compute() {
 VectorXd TorqueGenerator::operator()() {
 	return compute();
 }
+
+void TorqueGenerator::saveState(StateWriter& writer) const {
+}
+
+void TorqueGenerator::restoreState(StateReader& reader) {
+}
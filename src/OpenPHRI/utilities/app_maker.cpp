@@ -1,4 +1,5 @@
 #include <OpenPHRI/OpenPHRI.h>
+#include <OpenPHRI/drivers/async_driver.h>
 
 #include <pid/rpath.h>
 
@@ -11,9 +12,16 @@ struct AppMaker::pImpl {
 	DriverPtr driver;
 	DataLoggerPtr data_logger;
 	ClockPtr clock;
+	LoopRunnerPtr loop_runner;
+	TelemetryPublisherPtr telemetry;
+	ControllerReconfiguratorPtr reconfigurator;
 	YAML::Node app_configuration;
 	double init_timeout;
 	double start_timeout;
+	bool compute_dynamics;
+	bool driver_provides_kinematics;
+	// Reset on the first cycle so that the configuration and initialization durations are not measured as a cycle
+	bool clock_started = false;
 };
 
 AppMaker::AppMaker(const std::string& configuration_file) :
@@ -36,18 +44,34 @@ AppMaker::AppMaker(const std::string& configuration_file) :
 
 	std::cout << "[phri::AppMaker] Configuring the robot with the model parameters..." << std::flush;
 	impl_->robot->create(impl_->model->name(), impl_->model->jointCount());
+	impl_->compute_dynamics = conf["model"]["compute_dynamics"].as<bool>(false);
 	std::cout << " done." << std::endl;
 
 	/***				Robot driver				***/
 	std::cout << "[phri::AppMaker] Creating the robot driver..." << std::flush;
 	auto driver_namme = conf["driver"]["type"].as<std::string>();
+	bool asynchronous_driver = conf["driver"]["asynchronous"].as<bool>(false);
+	// An asynchronous driver runs the actual one on its own robot, from a dedicated thread
+	auto driver_robot = impl_->robot;
+	if(asynchronous_driver) {
+		driver_robot = std::make_shared<Robot>(impl_->robot->name(), impl_->robot->jointCount());
+	}
 	impl_->driver = DriverFactory::create(
 		driver_namme,
-		impl_->robot,
+		driver_robot,
 		conf);
 	if(not impl_->driver) {
-		throw std::runtime_error(OPEN_PHRI_ERROR("The driver '" + driver_namme + "' cannot be created. Make sure its header is included and its library is linked to your application."));
+		throw std::runtime_error(OPEN_PHRI_ERROR("The driver '" + driver_namme + "' cannot be created. Make sure its library is linked to your application or can be loaded as a plugin."));
+	}
+	if(asynchronous_driver) {
+		impl_->driver = std::make_shared<AsyncDriver>(
+			impl_->robot,
+			impl_->driver,
+			driver_robot,
+			conf["driver"]["queue_size"].as<size_t>(4));
 	}
+	// No need to compute the forward kinematics if the driver already updates the robot with it
+	impl_->driver_provides_kinematics = impl_->driver->capabilities().kinematics;
 	impl_->init_timeout = conf["driver"]["init_timeout"].as<double>(30.);
 	impl_->start_timeout = conf["driver"]["start_timeout"].as<double>(30.);
 	std::cout << " done." << std::endl;
@@ -59,24 +83,87 @@ AppMaker::AppMaker(const std::string& configuration_file) :
 	/***			Controller configuration			***/
 	std::cout << "[phri::AppMaker] Creating the robot controller..." << std::flush;
 	impl_->controller = std::make_shared<SafetyController>(impl_->robot, conf);
+	auto controller_parameters = ControllerFactory::build(*impl_->controller, impl_->robot, conf, impl_->driver->getSampleTime());
+	impl_->reconfigurator = std::make_shared<ControllerReconfigurator>(impl_->controller, impl_->robot, controller_parameters);
+	auto robot = impl_->robot;
+	auto sample_time = impl_->driver->getSampleTime();
+	impl_->reconfigurator->setBuilder(
+		[robot, sample_time](SafetyController& controller, const YAML::Node& configuration) {
+			return ControllerFactory::build(controller, robot, configuration, sample_time);
+		});
 	std::cout << " done." << std::endl;
 
 	/***			Data logger configuration			***/
 	std::cout << "[phri::AppMaker] Creating the data logger..." << std::flush;
 	impl_->clock = std::make_shared<Clock>(impl_->driver->getSampleTime());
+	impl_->clock->setReconciliation(conf["data_logger"]["reconcile_time"].as<bool>(false));
+	// Timestamp with the measured time so that the slipped cycles are visible in the logs
 	impl_->data_logger = std::make_shared<DataLogger>(
 		PID_PATH(conf["data_logger"]["folder"].as<std::string>("/tmp")),
-		impl_->clock->getTime(),
+		impl_->clock->getMeasuredTime(),
 		true);
 
+	if(conf["data_logger"]["binary"].as<bool>(false)) {
+		impl_->data_logger->enableBinaryMode(
+			conf["data_logger"]["buffer_cycles"].as<size_t>(4096),
+			conf["data_logger"]["chunk_rows"].as<size_t>(1024),
+			conf["data_logger"]["append"].as<bool>(false));
+	}
+	impl_->data_logger->setDefaultDecimation(conf["data_logger"]["decimation"].as<size_t>(1));
+	if(conf["data_logger"]["trigger_on_constraints"]) {
+		impl_->data_logger->addConstraintTrigger("", conf["data_logger"]["trigger_on_constraints"].as<double>());
+	}
+	if(conf["data_logger"]["black_box_duration"]) {
+		impl_->data_logger->enableBlackBox(
+			conf["data_logger"]["black_box_duration"].as<double>(),
+			impl_->driver->getSampleTime());
+	}
 	if(conf["data_logger"]["log_control_data"].as<bool>(false)) {
 		impl_->data_logger->logSafetyControllerData(impl_->controller.get());
 	}
 	if(conf["data_logger"]["log_robot_data"].as<bool>(false)) {
 		impl_->data_logger->logRobotData(impl_->robot);
 	}
+	if(conf["data_logger"]["log_clock_data"].as<bool>(false)) {
+		impl_->data_logger->logClockData(impl_->clock);
+	}
+	// The logger is owned by the pImpl, as the clock, so a raw pointer can be captured
+	auto data_logger = impl_->data_logger.get();
+	impl_->clock->subscribe(
+		[data_logger](const Clock&) {
+			data_logger->process();
+		});
 	std::cout << " done." << std::endl;
 
+	/***			Telemetry configuration			***/
+	if(conf["telemetry"]) {
+		std::cout << "[phri::AppMaker] Creating the telemetry publisher..." << std::flush;
+		impl_->telemetry = std::make_shared<TelemetryPublisher>(
+			conf["telemetry"]["name"].as<std::string>("/openphri"),
+			impl_->clock->getMeasuredTime());
+		if(conf["telemetry"]["publish_control_data"].as<bool>(true)) {
+			impl_->telemetry->publishSafetyControllerData(impl_->controller.get());
+		}
+		if(conf["telemetry"]["publish_robot_data"].as<bool>(true)) {
+			impl_->telemetry->publishRobotData(impl_->robot);
+		}
+		auto telemetry = impl_->telemetry.get();
+		impl_->clock->subscribe(
+			[telemetry](const Clock&) {
+				telemetry->publish();
+			});
+		std::cout << " done." << std::endl;
+	}
+
+	/***			Loop configuration			***/
+	LoopRunner::Options loop_options;
+	loop_options.priority = conf["loop"]["priority"].as<int>(0);
+	loop_options.cpu = conf["loop"]["cpu"].as<int>(-1);
+	loop_options.lock_memory = conf["loop"]["lock_memory"].as<bool>(false);
+	// Drivers waiting for the next sample in read() already pace the loop
+	loop_options.pace = conf["loop"]["pace"].as<bool>(not impl_->driver->capabilities().self_paced);
+	impl_->loop_runner = std::make_shared<LoopRunner>(impl_->driver->getSampleTime(), loop_options);
+
 	impl_->app_configuration = conf["parameters"];
 
 	std::cout << "[phri::AppMaker] The application is now fully configured." << std::endl;
@@ -88,13 +175,19 @@ bool AppMaker::init(std::function<bool(void)> init_code) {
 	bool all_ok = true;
 	std::cout << "[phri::AppMaker] Initializing the robot..." << std::flush;
 	all_ok &= impl_->driver->init(impl_->init_timeout);
-	impl_->model->forwardKinematics();
+	if(not impl_->driver_provides_kinematics) {
+		impl_->model->forwardKinematics();
+	}
+	if(impl_->compute_dynamics) {
+		impl_->model->updateDynamics();
+	}
 	std::cout << " done." << std::endl;
 	if(init_code) {
 		std::cout << "[phri::AppMaker] Calling user initialization function..." << std::flush;
 		all_ok &= init_code();
 		std::cout << " done." << std::endl;
 	}
+	impl_->clock_started = false;
 	return all_ok;
 }
 
@@ -103,8 +196,19 @@ bool AppMaker::run(
 	std::function<bool(void)> post_controller_code)
 {
 	bool ok = true;
+	if(not impl_->clock_started) {
+		impl_->clock->reset();
+		impl_->clock_started = true;
+	}
 	if(impl_->driver->read()) {
-		impl_->model->forwardKinematics();
+		if(not impl_->driver_provides_kinematics) {
+			impl_->model->forwardKinematics();
+		}
+		if(impl_->compute_dynamics) {
+			impl_->model->updateDynamics();
+		}
+		// Cycle boundary: swap in the last configuration built by the reconfigurator, if any
+		impl_->reconfigurator->update();
 		if(pre_controller_code) {
 			ok &= pre_controller_code();
 		}
@@ -116,8 +220,8 @@ bool AppMaker::run(
 			std::cerr << "[phri::AppMaker] Can'send data to the driver" << std::endl;
 			ok = false;
 		}
+		// Also triggers the data logger
 		impl_->clock->update();
-		impl_->data_logger->process();
 	}
 	else {
 		std::cerr << "[phri::AppMaker] Can't get data from the driver" << std::endl;
@@ -126,6 +230,16 @@ bool AppMaker::run(
 	return ok;
 }
 
+bool AppMaker::runLoop(
+	std::function<bool(void)> pre_controller_code,
+	std::function<bool(void)> post_controller_code)
+{
+	return impl_->loop_runner->run(
+		[this, &pre_controller_code, &post_controller_code]() {
+			return run(pre_controller_code, post_controller_code);
+		});
+}
+
 bool AppMaker::stop() {
 	std::cout << "[phri::AppMaker] Stopping the robot..." << std::flush;
 	bool ok = impl_->driver->stop();
@@ -141,6 +255,15 @@ SafetyControllerPtr AppMaker::getController() const {
 	return impl_->controller;
 }
 
+ParameterBlockPtr AppMaker::getControllerParameters() const {
+	// Follows the reconfigurations
+	return impl_->reconfigurator->parameters();
+}
+
+ControllerReconfiguratorPtr AppMaker::getReconfigurator() const {
+	return impl_->reconfigurator;
+}
+
 RobotModelPtr AppMaker::getModel() const {
 	return impl_->model;
 }
@@ -153,6 +276,18 @@ DataLoggerPtr AppMaker::getDataLogger() const {
 	return impl_->data_logger;
 }
 
+ClockPtr AppMaker::getClock() const {
+	return impl_->clock;
+}
+
+LoopRunnerPtr AppMaker::getLoopRunner() const {
+	return impl_->loop_runner;
+}
+
+TelemetryPublisherPtr AppMaker::getTelemetry() const {
+	return impl_->telemetry;
+}
+
 const YAML::Node& AppMaker::getParameters() const {
 	return impl_->app_configuration;
 }
@@ -0,0 +1,210 @@
+/*      File: binary_data_replayer.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/binary_data_replayer.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+
+using namespace phri;
+
+namespace {
+
+// Parse the tab separated values of a line, the first one being the timestamp
+size_t parseLine(const std::string& line, std::vector<double>& values) {
+	values.clear();
+	const char* str = line.c_str();
+	char* end;
+	while(true) {
+		double value = std::strtod(str, &end);
+		if(end == str) {
+			break;
+		}
+		values.push_back(value);
+		str = end;
+	}
+	return values.size();
+}
+
+}
+
+BinaryDataReplayer::BinaryDataReplayer(const std::string& log_file) :
+	reader_(log_file),
+	next_row_(0),
+	current_row_(std::numeric_limits<size_t>::max()),
+	current_chunk_(0),
+	chunk_row_(0)
+{
+}
+
+void BinaryDataReplayer::replay(const std::string& signal, double* output, size_t size) {
+	auto index = signalIndex(signal);
+	if(reader_.signals()[index].size != size) {
+		throw std::length_error(OPEN_PHRI_ERROR("The signal " + signal + " has " + std::to_string(reader_.signals()[index].size) + " values but the output has " + std::to_string(size)));
+	}
+	outputs_.push_back({index, output, size});
+}
+
+bool BinaryDataReplayer::process() {
+	// Return false if the end of the log is reached
+	if(next_row_ >= reader_.rowCount()) {
+		return false;
+	}
+	load(next_row_++);
+	return true;
+}
+
+bool BinaryDataReplayer::operator()() {
+	return process();
+}
+
+bool BinaryDataReplayer::processUntil(double time) {
+	auto row = reader_.findRow(std::nextafter(time, std::numeric_limits<double>::infinity()));
+	if(row > next_row_) {
+		load(row - 1);
+		next_row_ = row;
+	}
+	return next_row_ < reader_.rowCount();
+}
+
+bool BinaryDataReplayer::seek(double time) {
+	next_row_ = reader_.findRow(time);
+	return next_row_ < reader_.rowCount();
+}
+
+void BinaryDataReplayer::rewind() {
+	next_row_ = 0;
+}
+
+BinaryLogReader::SignalMap BinaryDataReplayer::get(const std::string& signal) const {
+	return this->signal(signalIndex(signal));
+}
+
+double BinaryDataReplayer::time() const {
+	if(current_row_ >= reader_.rowCount()) {
+		throw std::out_of_range(OPEN_PHRI_ERROR("No row has been loaded yet"));
+	}
+	return reader_.column(current_chunk_, 0)[chunk_row_];
+}
+
+size_t BinaryDataReplayer::row() const {
+	return current_row_;
+}
+
+const BinaryLogReader& BinaryDataReplayer::reader() const {
+	return reader_;
+}
+
+void BinaryDataReplayer::load(size_t row) {
+	const auto& chunks = reader_.chunks();
+	// Rows are mostly loaded sequentially so check the current and next chunks before searching
+	auto contains = [&chunks, row](size_t chunk) {
+		return chunk < chunks.size() and row >= chunks[chunk].first_row and row < chunks[chunk].first_row + chunks[chunk].row_count;
+	};
+	if(not contains(current_chunk_)) {
+		if(contains(current_chunk_ + 1)) {
+			++current_chunk_;
+		}
+		else {
+			auto chunk = std::upper_bound(chunks.begin(), chunks.end(), row, [](size_t row, const BinaryLogReader::Chunk& chunk) {
+				return row < chunk.first_row;
+			});
+			current_chunk_ = (chunk - chunks.begin()) - 1;
+		}
+	}
+	current_row_ = row;
+	chunk_row_ = row - chunks[current_chunk_].first_row;
+
+	for(const auto& output: outputs_) {
+		Eigen::Map<VectorXd>(output.data, output.size) = signal(output.signal);
+	}
+}
+
+size_t BinaryDataReplayer::signalIndex(const std::string& signal) const {
+	int index = reader_.signalIndex(signal);
+	if(index < 0) {
+		throw std::out_of_range(OPEN_PHRI_ERROR("There is no signal named " + signal + " in the log"));
+	}
+	return index;
+}
+
+BinaryLogReader::SignalMap BinaryDataReplayer::signal(size_t signal) const {
+	if(current_row_ >= reader_.rowCount()) {
+		throw std::out_of_range(OPEN_PHRI_ERROR("No row has been loaded yet"));
+	}
+	const auto& chunk = reader_.chunks()[current_chunk_];
+	return BinaryLogReader::SignalMap(
+		reader_.column(current_chunk_, reader_.signalColumn(signal)) + chunk_row_,
+		reader_.signals()[signal].size,
+		Eigen::InnerStride<>(chunk.row_count));
+}
+
+size_t BinaryDataReplayer::convertTextLogs(const std::map<std::string, std::string>& text_files, const std::string& log_file) {
+	std::vector<std::ifstream> files;
+	std::vector<BinaryLogSignal> signals;
+	std::vector<double> values;
+	std::string line;
+
+	for(const auto& text_file: text_files) {
+		files.emplace_back(text_file.second);
+		auto& file = files.back();
+		if(not file.is_open()) {
+			throw std::runtime_error(OPEN_PHRI_ERROR("Cannot open the file " + text_file.second + " for reading"));
+		}
+		// Get the number of values from the first line
+		auto position = file.tellg();
+		std::getline(file, line);
+		if(parseLine(line, values) < 2) {
+			throw std::runtime_error(OPEN_PHRI_ERROR("The file " + text_file.second + " doesn't contain any data"));
+		}
+		file.seekg(position);
+		signals.push_back({text_file.first, values.size() - 1});
+	}
+
+	BinaryLogWriter writer(log_file, signals);
+
+	size_t rows = 0;
+	while(true) {
+		bool end_of_files = false;
+		double* row = nullptr;
+		for (size_t i = 0; i < files.size(); ++i) {
+			if(not std::getline(files[i], line) or parseLine(line, values) != signals[i].size + 1) {
+				end_of_files = true;
+				break;
+			}
+			if(row == nullptr) {
+				row = writer.waitRow();
+				*row++ = values[0];
+			}
+			row = std::copy(values.begin() + 1, values.end(), row);
+		}
+		if(end_of_files) {
+			break;
+		}
+		writer.commitRow();
+		++rows;
+	}
+	writer.close();
+
+	return rows;
+}
@@ -0,0 +1,395 @@
+/*      File: binary_log.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/binary_log.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+using namespace phri;
+
+namespace {
+
+template<typename T>
+void write(std::ostream& stream, const T& value) {
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+size_t rowSize(const std::vector<BinaryLogSignal>& signals) {
+	size_t size = 1;
+	for(const auto& signal: signals) {
+		size += signal.size;
+	}
+	return size;
+}
+
+}
+
+BinaryLogWriter::BinaryLogWriter(
+	const std::string& file,
+	const std::vector<BinaryLogSignal>& signals,
+	size_t buffer_rows,
+	size_t chunk_rows,
+	bool append) :
+	buffer_(buffer_rows, ::rowSize(signals)),
+	chunk_rows_(chunk_rows),
+	chunk_(chunk_rows * buffer_.recordSize()),
+	chunk_row_count_(0),
+	running_(true),
+	written_rows_(0),
+	dropped_rows_(0)
+{
+	if(chunk_rows_ == 0) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The chunks must have at least one row"));
+	}
+
+	bool append_to_file = false;
+	if(append and access(file.c_str(), F_OK) == 0) {
+		try {
+			BinaryLogReader reader(file);
+			if(reader.signals() != signals) {
+				throw std::runtime_error(OPEN_PHRI_ERROR("Can't append to " + file + ": the logged signals are different"));
+			}
+			append_to_file = true;
+		}
+		catch(std::invalid_argument&) {
+			// Not a log file (e.g. empty), overwrite it
+		}
+		if(append_to_file) {
+			BinaryLogReader::recover(file);
+		}
+	}
+
+	file_.open(file, std::ios::binary | (append_to_file ? std::ios::app : std::ios::trunc));
+	if(not file_.is_open()) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Unable to open the file " + file + " for writing"));
+	}
+	if(not append_to_file) {
+		writeHeader(signals);
+	}
+
+	writer_thread_ = std::thread(&BinaryLogWriter::writerLoop, this);
+}
+
+BinaryLogWriter::~BinaryLogWriter() {
+	close();
+}
+
+double* BinaryLogWriter::beginRow() {
+	auto row = buffer_.writeSlot();
+	if(row == nullptr) {
+		dropped_rows_.fetch_add(1, std::memory_order_relaxed);
+	}
+	return row;
+}
+
+double* BinaryLogWriter::waitRow() {
+	double* row;
+	while((row = buffer_.writeSlot()) == nullptr) {
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+	return row;
+}
+
+void BinaryLogWriter::commitRow() {
+	buffer_.commitWrite();
+}
+
+size_t BinaryLogWriter::rowSize() const {
+	return buffer_.recordSize();
+}
+
+uint64_t BinaryLogWriter::writtenRows() const {
+	return written_rows_;
+}
+
+uint64_t BinaryLogWriter::droppedRows() const {
+	return dropped_rows_;
+}
+
+void BinaryLogWriter::close() {
+	running_ = false;
+	if(writer_thread_.joinable()) {
+		writer_thread_.join();
+	}
+	if(file_.is_open()) {
+		file_.close();
+	}
+}
+
+void BinaryLogWriter::writeHeader(const std::vector<BinaryLogSignal>& signals) {
+	uint32_t header_size = sizeof(binary_log_magic) + 4 * sizeof(uint32_t);
+	for(const auto& signal: signals) {
+		header_size += 2 * sizeof(uint32_t) + signal.name.size();
+	}
+	header_size = (header_size + 7) & ~7u;
+
+	file_.write(binary_log_magic, sizeof(binary_log_magic));
+	write<uint32_t>(file_, binary_log_version);
+	write<uint32_t>(file_, header_size);
+	write<uint32_t>(file_, signals.size());
+	write<uint32_t>(file_, 0);
+	for(const auto& signal: signals) {
+		write<uint32_t>(file_, signal.name.size());
+		write<uint32_t>(file_, signal.size);
+		file_.write(signal.name.data(), signal.name.size());
+	}
+	while(file_.tellp() < header_size) {
+		file_.put('\0');
+	}
+	file_.flush();
+}
+
+void BinaryLogWriter::writerLoop() {
+	const size_t row_size = buffer_.recordSize();
+	const auto partial_chunk_period = std::chrono::milliseconds(500);
+	auto last_chunk_time = std::chrono::steady_clock::now();
+	bool stopping = false;
+	while(not stopping) {
+		// Read the running state before draining so that the rows pushed before close() are always written
+		stopping = not running_;
+
+		const double* row;
+		while((row = buffer_.readSlot()) != nullptr) {
+			// Transpose the row into the chunk columns
+			for (size_t column = 0; column < row_size; ++column) {
+				chunk_[column * chunk_rows_ + chunk_row_count_] = row[column];
+			}
+			buffer_.commitRead();
+			if(++chunk_row_count_ == chunk_rows_) {
+				writeChunk();
+				last_chunk_time = std::chrono::steady_clock::now();
+			}
+		}
+
+		// Periodically write partial chunks so that the file doesn't lag too much behind the control thread
+		auto now = std::chrono::steady_clock::now();
+		if(chunk_row_count_ > 0 and (stopping or now - last_chunk_time > partial_chunk_period)) {
+			writeChunk();
+			last_chunk_time = now;
+		}
+
+		if(not stopping) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+	}
+}
+
+void BinaryLogWriter::writeChunk() {
+	BinaryLogChunkHeader header;
+	header.magic = binary_log_chunk_magic;
+	header.row_count = chunk_row_count_;
+	header.first_time = chunk_[0];
+	header.last_time = chunk_[chunk_row_count_ - 1];
+	write(file_, header);
+
+	for (size_t column = 0; column < buffer_.recordSize(); ++column) {
+		file_.write(reinterpret_cast<const char*>(chunk_.data() + column * chunk_rows_), chunk_row_count_ * sizeof(double));
+	}
+	// Only complete chunks reach the disk, so that a crash leaves a readable file
+	file_.flush();
+
+	written_rows_ += chunk_row_count_;
+	chunk_row_count_ = 0;
+}
+
+BinaryLogReader::BinaryLogReader(const std::string& file) :
+	fd_(-1),
+	data_(nullptr),
+	size_(0),
+	valid_size_(0),
+	row_count_(0),
+	row_size_(1)
+{
+	fd_ = open(file.c_str(), O_RDONLY);
+	if(fd_ < 0) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Unable to open the file " + file + ": " + std::string(std::strerror(errno))));
+	}
+	struct stat file_stat;
+	fstat(fd_, &file_stat);
+	size_ = file_stat.st_size;
+
+	constexpr size_t fixed_header_size = sizeof(binary_log_magic) + 4 * sizeof(uint32_t);
+	if(size_ < fixed_header_size) {
+		::close(fd_);
+		throw std::invalid_argument(OPEN_PHRI_ERROR(file + " is not a binary log file"));
+	}
+
+	void* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+	if(data == MAP_FAILED) {
+		::close(fd_);
+		throw std::runtime_error(OPEN_PHRI_ERROR("Unable to map the file " + file + " in memory: " + std::string(std::strerror(errno))));
+	}
+	data_ = static_cast<const char*>(data);
+
+	auto read_uint32 = [this](size_t offset) {
+		uint32_t value;
+		std::memcpy(&value, data_ + offset, sizeof(value));
+		return value;
+	};
+
+	uint32_t header_size = read_uint32(12);
+	if(not std::equal(binary_log_magic, binary_log_magic + sizeof(binary_log_magic), data_) or
+	   read_uint32(8) != binary_log_version or
+	   header_size > size_ or header_size % 8 != 0)
+	{
+		munmap(const_cast<char*>(data_), size_);
+		::close(fd_);
+		throw std::invalid_argument(OPEN_PHRI_ERROR(file + " is not a binary log file or has an unsupported version"));
+	}
+
+	uint32_t signal_count = read_uint32(16);
+	size_t offset = fixed_header_size;
+	for (size_t i = 0; i < signal_count; ++i) {
+		if(offset + 2 * sizeof(uint32_t) > header_size) {
+			break;
+		}
+		uint32_t name_size = read_uint32(offset);
+		uint32_t value_count = read_uint32(offset + sizeof(uint32_t));
+		offset += 2 * sizeof(uint32_t);
+		if(offset + name_size > header_size) {
+			break;
+		}
+		signals_.push_back({std::string(data_ + offset, name_size), value_count});
+		signal_columns_.push_back(row_size_);
+		row_size_ += value_count;
+		offset += name_size;
+	}
+	if(signals_.size() != signal_count) {
+		munmap(const_cast<char*>(data_), size_);
+		::close(fd_);
+		throw std::invalid_argument(OPEN_PHRI_ERROR(file + " has a corrupted header"));
+	}
+
+	// Index the chunks, stopping at the first incomplete or invalid one
+	offset = header_size;
+	while(offset + sizeof(BinaryLogChunkHeader) <= size_) {
+		BinaryLogChunkHeader header;
+		std::memcpy(&header, data_ + offset, sizeof(header));
+		size_t chunk_size = sizeof(header) + header.row_count * row_size_ * sizeof(double);
+		if(header.magic != binary_log_chunk_magic or header.row_count == 0 or offset + chunk_size > size_) {
+			break;
+		}
+		chunks_.push_back({offset, row_count_, header.row_count, header.first_time, header.last_time});
+		row_count_ += header.row_count;
+		offset += chunk_size;
+	}
+	valid_size_ = offset;
+}
+
+BinaryLogReader::~BinaryLogReader() {
+	munmap(const_cast<char*>(data_), size_);
+	::close(fd_);
+}
+
+const std::vector<BinaryLogSignal>& BinaryLogReader::signals() const {
+	return signals_;
+}
+
+int BinaryLogReader::signalIndex(const std::string& name) const {
+	auto it = std::find_if(signals_.begin(), signals_.end(), [&name](const BinaryLogSignal& signal) {
+		return signal.name == name;
+	});
+	return it == signals_.end() ? -1 : static_cast<int>(it - signals_.begin());
+}
+
+size_t BinaryLogReader::signalColumn(size_t signal) const {
+	return signal_columns_.at(signal);
+}
+
+size_t BinaryLogReader::rowCount() const {
+	return row_count_;
+}
+
+size_t BinaryLogReader::rowSize() const {
+	return row_size_;
+}
+
+const std::vector<BinaryLogReader::Chunk>& BinaryLogReader::chunks() const {
+	return chunks_;
+}
+
+size_t BinaryLogReader::validSize() const {
+	return valid_size_;
+}
+
+bool BinaryLogReader::isTruncated() const {
+	return valid_size_ < size_;
+}
+
+size_t BinaryLogReader::findRow(double time) const {
+	// First chunk whose last timestamp is not before the given time, then search inside its time column
+	auto chunk = std::lower_bound(chunks_.begin(), chunks_.end(), time, [](const Chunk& chunk, double time) {
+		return chunk.last_time < time;
+	});
+	if(chunk == chunks_.end()) {
+		return row_count_;
+	}
+	const double* times = column(chunk - chunks_.begin(), 0);
+	return chunk->first_row + (std::lower_bound(times, times + chunk->row_count, time) - times);
+}
+
+double BinaryLogReader::time(size_t row) const {
+	auto chunk = chunkIndex(row);
+	return column(chunk, 0)[row - chunks_[chunk].first_row];
+}
+
+BinaryLogReader::SignalMap BinaryLogReader::signal(size_t row, size_t signal) const {
+	auto chunk = chunkIndex(row);
+	const auto& info = chunks_[chunk];
+	return SignalMap(
+		column(chunk, signal_columns_.at(signal)) + (row - info.first_row),
+		signals_[signal].size,
+		Eigen::InnerStride<>(info.row_count));
+}
+
+const double* BinaryLogReader::column(size_t chunk, size_t column) const {
+	const auto& info = chunks_.at(chunk);
+	return reinterpret_cast<const double*>(data_ + info.offset + sizeof(BinaryLogChunkHeader)) + column * info.row_count;
+}
+
+bool BinaryLogReader::recover(const std::string& file) {
+	size_t valid_size;
+	bool truncated;
+	{
+		BinaryLogReader reader(file);
+		valid_size = reader.validSize();
+		truncated = reader.isTruncated();
+	}
+	if(truncated and truncate(file.c_str(), valid_size) != 0) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Unable to truncate the file " + file + ": " + std::string(std::strerror(errno))));
+	}
+	return truncated;
+}
+
+size_t BinaryLogReader::chunkIndex(size_t row) const {
+	if(row >= row_count_) {
+		throw std::out_of_range(OPEN_PHRI_ERROR("Row " + std::to_string(row) + " is out of range"));
+	}
+	auto chunk = std::upper_bound(chunks_.begin(), chunks_.end(), row, [](size_t row, const Chunk& chunk) {
+		return row < chunk.first_row;
+	});
+	return (chunk - chunks_.begin()) - 1;
+}
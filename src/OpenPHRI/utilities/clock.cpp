@@ -19,43 +19,116 @@
 
 #include <OpenPHRI/utilities/clock.h>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace phri;
 
-Clock::Clock() : sample_time_(-1.) {
-	reset();
-	time_ = std::make_shared<double>(0.);
+Clock::Clock() :
+	Clock(-1.)
+{
 }
 
 Clock::Clock(double sample_time) :
 	sample_time_(sample_time),
-	time_(std::make_shared<double>(0.))
+	reconcile_(false),
+	nominal_time_(std::make_shared<double>(0.)),
+	measured_time_(std::make_shared<double>(0.)),
+	cycle_time_(std::make_shared<double>(0.)),
+	next_subscription_id_(0)
 {
+	reset();
 }
 
 void Clock::reset() {
-	if(sample_time_ < 0) {
-		init_time_ = std::chrono::high_resolution_clock::now();
-	}
-	else {
-		*time_ = 0.;
-	}
+	init_time_ = std::chrono::steady_clock::now();
+	last_update_time_ = init_time_;
+	*nominal_time_ = 0.;
+	*measured_time_ = 0.;
+	*cycle_time_ = 0.;
+	statistics_ = Statistics();
 }
 
 std::shared_ptr<double> Clock::getTime() const {
-	return time_;
+	return nominal_time_;
+}
+
+std::shared_ptr<double> Clock::getNominalTime() const {
+	return nominal_time_;
+}
+
+std::shared_ptr<double> Clock::getMeasuredTime() const {
+	return measured_time_;
+}
+
+std::shared_ptr<double> Clock::getCycleTime() const {
+	return cycle_time_;
+}
+
+double Clock::getDrift() const {
+	return *measured_time_ - *nominal_time_;
+}
+
+double Clock::getSampleTime() const {
+	return sample_time_;
+}
+
+const Clock::Statistics& Clock::getStatistics() const {
+	return statistics_;
+}
+
+void Clock::setReconciliation(bool reconcile) {
+	reconcile_ = reconcile;
 }
 
 double Clock::update() {
-	auto& current_time = *time_;
+	auto now = std::chrono::steady_clock::now();
+	double cycle_time = std::chrono::duration<double>(now - last_update_time_).count();
+	last_update_time_ = now;
+
+	*measured_time_ = std::chrono::duration<double>(now - init_time_).count();
+	*cycle_time_ = cycle_time;
+
 	if(sample_time_ <= 0) {
-		current_time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - init_time_).count();
+		*nominal_time_ = *measured_time_;
 	}
 	else {
-		current_time += sample_time_;
+		uint64_t missed_cycles = 0;
+		if(cycle_time > 1.5 * sample_time_) {
+			missed_cycles = static_cast<uint64_t>(std::llround(cycle_time / sample_time_)) - 1;
+		}
+		statistics_.missed_cycles += missed_cycles;
+		*nominal_time_ += sample_time_ * (reconcile_ ? missed_cycles + 1 : 1);
+	}
+
+	++statistics_.cycles;
+	statistics_.last_cycle_time = cycle_time;
+	if(statistics_.cycles == 1) {
+		statistics_.min_cycle_time = cycle_time;
+		statistics_.max_cycle_time = cycle_time;
 	}
-	return current_time;
+	else {
+		statistics_.min_cycle_time = std::min(statistics_.min_cycle_time, cycle_time);
+		statistics_.max_cycle_time = std::max(statistics_.max_cycle_time, cycle_time);
+	}
+	statistics_.mean_cycle_time += (cycle_time - statistics_.mean_cycle_time) / statistics_.cycles;
+
+	for(auto& subscriber: subscribers_) {
+		subscriber.second(*this);
+	}
+
+	return *nominal_time_;
 }
 
 double Clock::operator()() {
 	return update();
 }
+
+Clock::SubscriptionID Clock::subscribe(const Subscriber& subscriber) {
+	subscribers_[next_subscription_id_] = subscriber;
+	return next_subscription_id_++;
+}
+
+void Clock::unsubscribe(SubscriptionID id) {
+	subscribers_.erase(id);
+}
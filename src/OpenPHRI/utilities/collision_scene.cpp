@@ -0,0 +1,479 @@
+/*      File: collision_scene.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/collision_scene.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+using namespace phri;
+
+namespace {
+
+constexpr size_t gjk_max_iterations = 64;
+constexpr double gjk_relative_tolerance = 1e-12;
+constexpr double gjk_intersection_tolerance = 1e-20;
+
+enum class GJKResult {
+	Separated,
+	Intersecting,
+	Farther     // Farther than the given bound, the computation has been stopped
+};
+
+struct SupportPoint {
+	Vector3d w;  // a - b
+	Vector3d a;
+	Vector3d b;
+};
+
+// Points of the Minkowski difference defining the current closest point, with their barycentric coordinates
+struct Simplex {
+	std::array<SupportPoint, 4> points;
+	std::array<double, 4> weights;
+	size_t size = 0;
+
+	Vector3d closestPoint() const {
+		Vector3d point = Vector3d::Zero();
+		for (size_t i = 0; i < size; ++i) {
+			point += weights[i] * points[i].w;
+		}
+		return point;
+	}
+
+	void witnessPoints(Vector3d& a, Vector3d& b) const {
+		a.setZero();
+		b.setZero();
+		for (size_t i = 0; i < size; ++i) {
+			a += weights[i] * points[i].a;
+			b += weights[i] * points[i].b;
+		}
+	}
+
+	void setVertex(size_t i) {
+		points[0] = points[i];
+		weights[0] = 1.;
+		size = 1;
+	}
+
+	void setEdge(size_t i, size_t j, double t) {
+		auto pi = points[i];
+		auto pj = points[j];
+		points[0] = pi;
+		points[1] = pj;
+		weights[0] = 1. - t;
+		weights[1] = t;
+		size = 2;
+	}
+
+	void setTriangle(size_t i, size_t j, size_t k, double v, double w) {
+		auto pi = points[i];
+		auto pj = points[j];
+		auto pk = points[k];
+		points[0] = pi;
+		points[1] = pj;
+		points[2] = pk;
+		weights[0] = 1. - v - w;
+		weights[1] = v;
+		weights[2] = w;
+		size = 3;
+	}
+};
+
+// Parameter of the point of segment [a,b] closest to the origin
+double segmentParameter(const Vector3d& a, const Vector3d& b) {
+	const Vector3d ab = b - a;
+	const double squared_length = ab.squaredNorm();
+	if(squared_length <= 0.) {
+		return 0.;
+	}
+	return std::max(0., std::min(1., -a.dot(ab) / squared_length));
+}
+
+void closestOnSegment(Simplex& simplex, size_t i, size_t j) {
+	const double t = segmentParameter(simplex.points[i].w, simplex.points[j].w);
+	if(t <= 0.) {
+		simplex.setVertex(i);
+	}
+	else if(t >= 1.) {
+		simplex.setVertex(j);
+	}
+	else {
+		simplex.setEdge(i, j, t);
+	}
+}
+
+// From "Real-Time Collision Detection", C. Ericson, section 5.1.5, with the origin as query point
+void closestOnTriangle(Simplex& simplex, size_t i, size_t j, size_t k) {
+	const Vector3d& a = simplex.points[i].w;
+	const Vector3d& b = simplex.points[j].w;
+	const Vector3d& c = simplex.points[k].w;
+	const Vector3d ab = b - a;
+	const Vector3d ac = c - a;
+
+	const double d1 = -ab.dot(a);
+	const double d2 = -ac.dot(a);
+	if(d1 <= 0. and d2 <= 0.) {
+		simplex.setVertex(i);
+		return;
+	}
+
+	const double d3 = -ab.dot(b);
+	const double d4 = -ac.dot(b);
+	if(d3 >= 0. and d4 <= d3) {
+		simplex.setVertex(j);
+		return;
+	}
+
+	const double vc = d1*d4 - d3*d2;
+	if(vc <= 0. and d1 >= 0. and d3 <= 0.) {
+		simplex.setEdge(i, j, d1 / (d1 - d3));
+		return;
+	}
+
+	const double d5 = -ab.dot(c);
+	const double d6 = -ac.dot(c);
+	if(d6 >= 0. and d5 <= d6) {
+		simplex.setVertex(k);
+		return;
+	}
+
+	const double vb = d5*d2 - d1*d6;
+	if(vb <= 0. and d2 >= 0. and d6 <= 0.) {
+		simplex.setEdge(i, k, d2 / (d2 - d6));
+		return;
+	}
+
+	const double va = d3*d6 - d5*d4;
+	if(va <= 0. and (d4 - d3) >= 0. and (d5 - d6) >= 0.) {
+		simplex.setEdge(j, k, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+		return;
+	}
+
+	const double sum = va + vb + vc;
+	if(sum <= 0.) {
+		// Degenerate (flat) triangle, use its closest edge
+		const double t_ab = segmentParameter(a, b);
+		const double t_ac = segmentParameter(a, c);
+		const double t_bc = segmentParameter(b, c);
+		const double d_ab = (a + t_ab * (b - a)).squaredNorm();
+		const double d_ac = (a + t_ac * (c - a)).squaredNorm();
+		const double d_bc = (b + t_bc * (c - b)).squaredNorm();
+		if(d_ab <= d_ac and d_ab <= d_bc) {
+			closestOnSegment(simplex, i, j);
+		}
+		else if(d_ac <= d_bc) {
+			closestOnSegment(simplex, i, k);
+		}
+		else {
+			closestOnSegment(simplex, j, k);
+		}
+		return;
+	}
+
+	simplex.setTriangle(i, j, k, vb / sum, vc / sum);
+}
+
+// From "Real-Time Collision Detection", C. Ericson, section 5.1.6. Returns false if the origin is inside the tetrahedron
+bool closestOnTetrahedron(Simplex& simplex) {
+	// Faces and the vertex opposite to them
+	constexpr size_t faces[4][4] = {{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}};
+
+	double min_squared_distance = std::numeric_limits<double>::infinity();
+	Simplex closest;
+	for(const auto& face: faces) {
+		const Vector3d& a = simplex.points[face[0]].w;
+		const Vector3d normal = (simplex.points[face[1]].w - a).cross(simplex.points[face[2]].w - a);
+		const Vector3d ad = simplex.points[face[3]].w - a;
+		const double side_origin = -a.dot(normal);
+		const double side_opposite = ad.dot(normal);
+		const bool degenerate = std::abs(side_opposite) <= 1e-12 * normal.norm() * ad.norm();
+		if(side_origin * side_opposite < 0. or degenerate) {
+			Simplex candidate = simplex;
+			closestOnTriangle(candidate, face[0], face[1], face[2]);
+			const double squared_distance = candidate.closestPoint().squaredNorm();
+			if(squared_distance < min_squared_distance) {
+				min_squared_distance = squared_distance;
+				closest = candidate;
+			}
+		}
+	}
+
+	if(std::isinf(min_squared_distance)) {
+		return false;
+	}
+	simplex = closest;
+	return true;
+}
+
+Vector3d worldSupport(const CollisionShape& shape, const AffineTransform& pose, const Vector3d& direction) {
+	return pose * shape.support(pose.linear().transpose() * direction);
+}
+
+/*
+ * GJK distance between the cores of two shapes ("A fast procedure for computing the distance between complex objects in three-dimensional space",
+ * E. G. Gilbert, D. W. Johnson and S. S. Keerthi). direction is the initial guess of the vector from the closest point of B to the closest point of A,
+ * and is set to the final one. The computation stops as soon as the core distance is proven to be larger than bound.
+ */
+GJKResult gjkDistance(
+	const CollisionShape& shape_a, const AffineTransform& pose_a,
+	const CollisionShape& shape_b, const AffineTransform& pose_b,
+	double bound, Vector3d& direction, Vector3d& point_a, Vector3d& point_b)
+{
+	Vector3d v = direction;
+	if(v.squaredNorm() < gjk_intersection_tolerance) {
+		v = pose_a.translation() - pose_b.translation();
+		if(v.squaredNorm() < gjk_intersection_tolerance) {
+			v = Vector3d::UnitX();
+		}
+	}
+
+	Simplex simplex;
+	GJKResult result = GJKResult::Separated;
+	for (size_t iteration = 0; iteration < gjk_max_iterations; ++iteration) {
+		SupportPoint support;
+		support.a = worldSupport(shape_a, pose_a, -v);
+		support.b = worldSupport(shape_b, pose_b, v);
+		support.w = support.a - support.b;
+
+		// v.w/|v| is a lower bound of the distance
+		const double vv = v.squaredNorm();
+		const double vw = v.dot(support.w);
+		if(vw > 0. and vw * vw >= bound * bound * vv) {
+			result = GJKResult::Farther;
+			break;
+		}
+		if(simplex.size > 0 and vv - vw <= gjk_relative_tolerance * vv) {
+			break;
+		}
+
+		bool duplicate = false;
+		for (size_t i = 0; i < simplex.size; ++i) {
+			duplicate |= simplex.points[i].w == support.w;
+		}
+		if(duplicate) {
+			break;
+		}
+
+		simplex.points[simplex.size++] = support;
+		switch(simplex.size) {
+		case 1:
+			simplex.setVertex(0);
+			break;
+		case 2:
+			closestOnSegment(simplex, 0, 1);
+			break;
+		case 3:
+			closestOnTriangle(simplex, 0, 1, 2);
+			break;
+		default:
+			if(not closestOnTetrahedron(simplex)) {
+				result = GJKResult::Intersecting;
+			}
+			break;
+		}
+		if(result == GJKResult::Intersecting) {
+			break;
+		}
+
+		v = simplex.closestPoint();
+		if(v.squaredNorm() < gjk_intersection_tolerance) {
+			result = GJKResult::Intersecting;
+			break;
+		}
+	}
+
+	if(simplex.size > 0) {
+		simplex.witnessPoints(point_a, point_b);
+	}
+	else {
+		point_a = pose_a.translation();
+		point_b = pose_b.translation();
+	}
+	if(result != GJKResult::Intersecting) {
+		direction = v;
+	}
+	return result;
+}
+
+}
+
+CollisionScene::CollisionScene(double maximum_distance) :
+	maximum_distance_(maximum_distance),
+	narrow_phase_count_(0)
+{
+}
+
+size_t CollisionScene::addRobotBody(const std::string& name, CollisionShapeConstPtr shape, AffineTransformConstPtr frame, const AffineTransform& offset) {
+	if(not shape or not frame) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The robot body " + name + " needs a shape and a frame"));
+	}
+	robot_bodies_.push_back({name, shape, frame, offset, AffineTransform::Identity(), Vector3d::Zero(), Vector3d::Zero()});
+	resetCache();
+	return robot_bodies_.size() - 1;
+}
+
+size_t CollisionScene::addObstacleBody(const std::string& name, CollisionShapeConstPtr shape, AffineTransformConstPtr frame, const AffineTransform& offset) {
+	if(not shape or not frame) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The obstacle body " + name + " needs a shape and a frame"));
+	}
+	obstacle_bodies_.push_back({name, shape, frame, offset, AffineTransform::Identity(), Vector3d::Zero(), Vector3d::Zero()});
+	obstacle_order_.push_back(obstacle_bodies_.size() - 1);
+	resetCache();
+	return obstacle_bodies_.size() - 1;
+}
+
+void CollisionScene::update() {
+	for(auto& body: robot_bodies_) {
+		updateBody(body);
+	}
+	for(auto& body: obstacle_bodies_) {
+		updateBody(body);
+	}
+
+	// Sort and prune along the x axis. The order changes little between cycles so an insertion sort is almost linear
+	for (size_t i = 1; i < obstacle_order_.size(); ++i) {
+		const size_t index = obstacle_order_[i];
+		const double key = obstacle_bodies_[index].aabb_min.x();
+		size_t j = i;
+		for (; j > 0 and obstacle_bodies_[obstacle_order_[j-1]].aabb_min.x() > key; --j) {
+			obstacle_order_[j] = obstacle_order_[j-1];
+		}
+		obstacle_order_[j] = index;
+	}
+
+	closest_ = CollisionDistance();
+	narrow_phase_count_ = 0;
+	for (size_t robot_idx = 0; robot_idx < robot_bodies_.size(); ++robot_idx) {
+		const auto& robot_body = robot_bodies_[robot_idx];
+		auto& result = robot_body_distances_[robot_idx];
+
+		// Start with the previous closest obstacle to get a tight bound
+		const bool has_previous = std::isfinite(result.distance);
+		const size_t previous = result.obstacle_body;
+		result = CollisionDistance();
+		result.robot_body = robot_idx;
+		double bound = maximum_distance_;
+		if(has_previous and computeDistance(robot_idx, previous, bound, result)) {
+			bound = result.distance;
+		}
+
+		for(auto obstacle_idx: obstacle_order_) {
+			const auto& obstacle_body = obstacle_bodies_[obstacle_idx];
+			if(obstacle_body.aabb_min.x() - robot_body.aabb_max.x() >= bound) {
+				// The following obstacles are even farther along x
+				break;
+			}
+			if(has_previous and obstacle_idx == previous) {
+				continue;
+			}
+
+			const double aabb_distance = (robot_body.aabb_min - obstacle_body.aabb_max).cwiseMax(obstacle_body.aabb_min - robot_body.aabb_max).cwiseMax(0.).norm();
+			if(aabb_distance >= bound) {
+				continue;
+			}
+
+			if(computeDistance(robot_idx, obstacle_idx, bound, result)) {
+				bound = result.distance;
+			}
+		}
+
+		if(result.distance < closest_.distance) {
+			closest_ = result;
+		}
+	}
+}
+
+const CollisionDistance& CollisionScene::closest() const {
+	return closest_;
+}
+
+const std::vector<CollisionDistance>& CollisionScene::robotBodyDistances() const {
+	return robot_body_distances_;
+}
+
+const std::string& CollisionScene::robotBodyName(size_t index) const {
+	return robot_bodies_.at(index).name;
+}
+
+const std::string& CollisionScene::obstacleBodyName(size_t index) const {
+	return obstacle_bodies_.at(index).name;
+}
+
+size_t CollisionScene::narrowPhaseCount() const {
+	return narrow_phase_count_;
+}
+
+void CollisionScene::updateBody(Body& body) {
+	body.pose = *body.frame * body.offset;
+
+	// Exact bounding box from the support points along the world axes
+	const auto& shape = *body.shape;
+	const double margin = shape.margin();
+	for (size_t axis = 0; axis < 3; ++axis) {
+		const Vector3d direction = Vector3d::Unit(axis);
+		body.aabb_max(axis) = worldSupport(shape, body.pose, direction)(axis) + margin;
+		body.aabb_min(axis) = worldSupport(shape, body.pose, -direction)(axis) - margin;
+	}
+}
+
+bool CollisionScene::computeDistance(size_t robot_body, size_t obstacle_body, double bound, CollisionDistance& result) {
+	const auto& robot = robot_bodies_[robot_body];
+	const auto& obstacle = obstacle_bodies_[obstacle_body];
+	const double robot_margin = robot.shape->margin();
+	const double obstacle_margin = obstacle.shape->margin();
+	auto& direction = pair_directions_[robot_body * obstacle_bodies_.size() + obstacle_body];
+
+	++narrow_phase_count_;
+	Vector3d robot_point, obstacle_point;
+	auto gjk_result = gjkDistance(
+		*robot.shape, robot.pose,
+		*obstacle.shape, obstacle.pose,
+		bound + robot_margin + obstacle_margin, direction, robot_point, obstacle_point);
+
+	if(gjk_result == GJKResult::Farther) {
+		return false;
+	}
+
+	double distance = 0.;
+	if(gjk_result == GJKResult::Separated) {
+		// Apply the margins along the separating direction
+		const double core_distance = direction.norm();
+		const Vector3d normal = direction / core_distance;
+		distance = std::max(0., core_distance - robot_margin - obstacle_margin);
+		robot_point -= robot_margin * normal;
+		obstacle_point += obstacle_margin * normal;
+	}
+
+	if(distance >= bound) {
+		return false;
+	}
+
+	result.distance = distance;
+	result.obstacle_body = obstacle_body;
+	result.robot_point = robot_point;
+	result.obstacle_point = obstacle_point;
+	return true;
+}
+
+void CollisionScene::resetCache() {
+	pair_directions_.assign(robot_bodies_.size() * obstacle_bodies_.size(), Vector3d::Zero());
+	robot_body_distances_.assign(robot_bodies_.size(), CollisionDistance());
+}
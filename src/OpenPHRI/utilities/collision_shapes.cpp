@@ -0,0 +1,99 @@
+/*      File: collision_shapes.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/collision_shapes.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <stdexcept>
+
+using namespace phri;
+
+/***			CollisionShape			***/
+
+CollisionShape::CollisionShape(double margin) :
+	margin_(margin)
+{
+}
+
+double CollisionShape::margin() const {
+	return margin_;
+}
+
+/***			SphereShape			***/
+
+SphereShape::SphereShape(double radius) :
+	CollisionShape(radius)
+{
+}
+
+Vector3d SphereShape::support(const Vector3d& direction) const {
+	return Vector3d::Zero();
+}
+
+/***			CapsuleShape			***/
+
+CapsuleShape::CapsuleShape(double radius, double length) :
+	CollisionShape(radius),
+	half_length_(length / 2.)
+{
+}
+
+Vector3d CapsuleShape::support(const Vector3d& direction) const {
+	return Vector3d(0., 0., direction.z() >= 0. ? half_length_ : -half_length_);
+}
+
+/***			BoxShape			***/
+
+BoxShape::BoxShape(const Vector3d& size) :
+	CollisionShape(0.),
+	half_size_(size / 2.)
+{
+}
+
+Vector3d BoxShape::support(const Vector3d& direction) const {
+	return Vector3d(
+		direction.x() >= 0. ? half_size_.x() : -half_size_.x(),
+		direction.y() >= 0. ? half_size_.y() : -half_size_.y(),
+		direction.z() >= 0. ? half_size_.z() : -half_size_.z());
+}
+
+/***			ConvexHullShape			***/
+
+ConvexHullShape::ConvexHullShape(const Matrix3Xd& vertices, double margin) :
+	CollisionShape(margin),
+	vertices_(vertices)
+{
+	if(vertices_.cols() == 0) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("A convex hull needs at least one vertex"));
+	}
+}
+
+Vector3d ConvexHullShape::support(const Vector3d& direction) const {
+	// Explicit loop, a row vector product would allocate a temporary
+	Eigen::Index index = 0;
+	double max_projection = direction.dot(vertices_.col(0));
+	for (Eigen::Index i = 1; i < vertices_.cols(); ++i) {
+		const double projection = direction.dot(vertices_.col(i));
+		if(projection > max_projection) {
+			max_projection = projection;
+			index = i;
+		}
+	}
+	return vertices_.col(index);
+}
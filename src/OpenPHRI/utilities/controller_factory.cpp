@@ -0,0 +1,546 @@
+/*      File: controller_factory.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/controller_factory.h>
+#include <OpenPHRI/safety_controller.h>
+#include <OpenPHRI/constraints.h>
+#include <OpenPHRI/force_generators.h>
+#include <OpenPHRI/torque_generators.h>
+#include <OpenPHRI/velocity_generators.h>
+#include <OpenPHRI/joint_velocity_generators.h>
+#include <OpenPHRI/utilities/joint_limits.h>
+#include <OpenPHRI/utilities/linear_interpolator.h>
+#include <OpenPHRI/utilities/polynomial_interpolator.h>
+
+using namespace phri;
+
+namespace {
+
+std::string fieldError(const std::string& field, const std::string& message) {
+	return "Invalid field '" + field + "': " + message;
+}
+
+const YAML::Node getField(const YAML::Node& configuration, const std::string& field) {
+	auto node = configuration[field];
+	if(not node) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Missing field '" + field + "'"));
+	}
+	return node;
+}
+
+std::vector<double> getValues(const YAML::Node& configuration, const std::string& field) {
+	auto node = getField(configuration, field);
+	try {
+		return node.as<std::vector<double>>();
+	}
+	catch(YAML::Exception&) {
+		throw std::runtime_error(OPEN_PHRI_ERROR(fieldError(field, "expected a list of numbers")));
+	}
+}
+
+// Number of scalar values in a configuration, an upper bound on the number of parameters it declares
+size_t scalarCount(const YAML::Node& node) {
+	if(node.IsScalar()) {
+		return 1;
+	}
+	size_t count = 0;
+	if(node.IsSequence()) {
+		for(const auto& child: node) {
+			count += scalarCount(child);
+		}
+	}
+	else if(node.IsMap()) {
+		for(const auto& child: node) {
+			count += scalarCount(child.second);
+		}
+	}
+	return count;
+}
+
+CollaborativeMode getCollaborativeMode(const YAML::Node& configuration, const std::string& field) {
+	static const std::map<std::string, CollaborativeMode> modes = {
+		{"monitored_stop", CollaborativeMode::SafetyRatedMonitoredStop},
+		{"hand_guiding", CollaborativeMode::HandGuiding},
+		{"speed_and_separation", CollaborativeMode::SpeedAndSeparationMonitoring},
+		{"power_and_force", CollaborativeMode::PowerAndForceLimiting}
+	};
+	auto mode = modes.find(getField(configuration, field).as<std::string>());
+	if(mode == modes.end()) {
+		throw std::runtime_error(OPEN_PHRI_ERROR(fieldError(field, "expected monitored_stop, hand_guiding, speed_and_separation or power_and_force")));
+	}
+	return mode->second;
+}
+
+BodyRegion getBodyRegion(const YAML::Node& value, const std::string& field) {
+	static const std::map<std::string, BodyRegion> regions = {
+		{"skull", BodyRegion::Skull},
+		{"face", BodyRegion::Face},
+		{"neck", BodyRegion::Neck},
+		{"back", BodyRegion::Back},
+		{"chest", BodyRegion::Chest},
+		{"abdomen", BodyRegion::Abdomen},
+		{"pelvis", BodyRegion::Pelvis},
+		{"upper_arm", BodyRegion::UpperArm},
+		{"lower_arm", BodyRegion::LowerArm},
+		{"hand", BodyRegion::Hand},
+		{"thigh", BodyRegion::Thigh},
+		{"lower_leg", BodyRegion::LowerLeg}
+	};
+	auto region = regions.find(value.as<std::string>(""));
+	if(region == regions.end()) {
+		throw std::runtime_error(OPEN_PHRI_ERROR(fieldError(field, "unknown body region '" + value.as<std::string>("") + "'")));
+	}
+	return region->second;
+}
+
+template<typename T>
+std::map<std::string, typename ObjectFactory<T>::create_method_t> builtinCreateMethods();
+
+template<>
+std::map<std::string, ConstraintFactory::create_method_t> builtinCreateMethods<Constraint>() {
+	return {
+		{"velocity", [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			return std::make_shared<VelocityConstraint>(context.input(conf, "maximum_velocity"));
+		}},
+		{"acceleration", [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			return std::make_shared<AccelerationConstraint>(context.input(conf, "maximum_acceleration"), context.sampleTime());
+		}},
+		{"power", [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			return std::make_shared<PowerConstraint>(context.input(conf, "maximum_power"));
+		}},
+		{"kinetic_energy", [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			return std::make_shared<KineticEnergyConstraint>(context.input(conf, "mass"), context.input(conf, "maximum_kinetic_energy"));
+		}},
+		{"force", [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			auto velocity_constraint = std::dynamic_pointer_cast<VelocityConstraint>(context.create<Constraint>(conf["constraint"]));
+			if(not velocity_constraint) {
+				throw std::runtime_error(OPEN_PHRI_ERROR(fieldError("constraint", "a velocity constraint is expected")));
+			}
+			return std::make_shared<ForceConstraint>(velocity_constraint, context.input(conf, "maximum_force"));
+		}},
+		{"emergency_stop", [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			auto check = conf["check"].as<std::string>(conf["activation_torque_threshold"] ? "both" : "force");
+			if(check == "force") {
+				return std::make_shared<EmergencyStopConstraint>(
+					context.input(conf, "activation_force_threshold"),
+					context.input(conf, "deactivation_force_threshold"));
+			}
+			else if(check == "torque") {
+				return std::make_shared<EmergencyStopConstraint>(
+					EmergencyStopConstraint::CheckJointTorques,
+					context.parameter(conf, "activation_force_threshold", 0.),
+					context.parameter(conf, "deactivation_force_threshold", 0.),
+					context.input(conf, "activation_torque_threshold"),
+					context.input(conf, "deactivation_torque_threshold"));
+			}
+			else if(check == "both") {
+				return std::make_shared<EmergencyStopConstraint>(
+					EmergencyStopConstraint::CheckBoth,
+					context.input(conf, "activation_force_threshold"),
+					context.input(conf, "deactivation_force_threshold"),
+					context.input(conf, "activation_torque_threshold"),
+					context.input(conf, "deactivation_torque_threshold"));
+			}
+			throw std::runtime_error(OPEN_PHRI_ERROR(fieldError("check", "expected force, torque or both")));
+		}},
+		{"joint_velocity", [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			return std::make_shared<JointVelocityConstraint>(std::make_shared<VectorXd>(context.jointVector(conf, "maximum_velocities")));
+		}},
+		{"joint_acceleration", [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			return std::make_shared<JointAccelerationConstraint>(std::make_shared<VectorXd>(context.jointVector(conf, "maximum_accelerations")), context.sampleTime());
+		}},
+		{"joint_position", [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			auto limits = std::make_shared<JointLimits>(context.robot()->jointCount());
+			limits->lowerPositions() = context.jointVector(conf, "lower_positions");
+			limits->upperPositions() = context.jointVector(conf, "upper_positions");
+			return std::make_shared<JointPositionConstraint>(limits, context.sampleTime());
+		}},
+		{"separation_distance", [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			// The interpolator output must be known before creating the constraint using it
+			auto interpolator = context.create<Interpolator>(conf["interpolator"]);
+			context.addInput(conf["interpolator"]["name"].as<std::string>(conf["name"].as<std::string>("")), interpolator->getOutput());
+			auto constraint = context.create<Constraint>(conf["constraint"]);
+			auto separation_constraint = conf["robot_position"] ?
+			                             std::make_shared<SeparationDistanceConstraint>(constraint, interpolator, std::make_shared<Vector6d>(context.vector6d(conf, "robot_position"))) :
+			                             std::make_shared<SeparationDistanceConstraint>(constraint, interpolator);
+			for(const auto& object: conf["objects"]) {
+				separation_constraint->add(getField(object, "name").as<std::string>(), std::make_shared<Pose>(context.pose(object, "position")));
+			}
+			return separation_constraint;
+		}},
+		{"collaborative_mode", [](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			// The tables are built once so their parameters are plain numbers
+			CollaborativeModeParameters params;
+			params.hand_guiding_velocity = conf["hand_guiding_velocity"].as<double>(params.hand_guiding_velocity);
+			params.human_velocity = conf["human_velocity"].as<double>(params.human_velocity);
+			params.reaction_time = conf["reaction_time"].as<double>(params.reaction_time);
+			params.stopping_time = conf["stopping_time"].as<double>(params.stopping_time);
+			params.maximum_deceleration = conf["maximum_deceleration"].as<double>(params.maximum_deceleration);
+			params.intrusion_distance = conf["intrusion_distance"].as<double>(params.intrusion_distance);
+			params.maximum_separation_distance = conf["maximum_separation_distance"].as<double>(params.maximum_separation_distance);
+			params.transient_contact_factor = conf["transient_contact_factor"].as<double>(params.transient_contact_factor);
+			params.minimum_robot_mass = conf["minimum_robot_mass"].as<double>(params.minimum_robot_mass);
+			for(const auto& region: conf["body_regions"]) {
+				params.body_regions.push_back(getBodyRegion(region, "body_regions"));
+			}
+			return std::make_shared<CollaborativeModeConstraint>(
+				getCollaborativeMode(conf, "mode"),
+				conf["separation_distance"] ? context.input(conf, "separation_distance") : nullptr,
+				conf["robot_mass"] ? context.input(conf, "robot_mass") : nullptr,
+				params);
+		}}
+	};
+}
+
+template<>
+std::map<std::string, ForceGeneratorFactory::create_method_t> builtinCreateMethods<ForceGenerator>() {
+	return {
+		{"force_proxy", [](const YAML::Node& conf, FactoryContext& context) -> ForceGeneratorPtr {
+			auto force = conf["force"] ? context.vector6d(conf, "force") : Vector6d::Zero();
+			return std::make_shared<ForceProxy>(std::make_shared<Vector6d>(force), context.frame(conf, "frame"));
+		}},
+		{"external_force", [](const YAML::Node& conf, FactoryContext& context) -> ForceGeneratorPtr {
+			return std::make_shared<ExternalForce>(context.robot());
+		}},
+		{"mass", [](const YAML::Node& conf, FactoryContext& context) -> ForceGeneratorPtr {
+			return std::make_shared<MassGenerator>(
+				std::make_shared<Matrix6d>(context.matrix6d(conf, "mass")),
+				std::make_shared<Acceleration>(context.vector6d(conf, "target_acceleration")),
+				context.frame(conf, "mass_frame"),
+				context.frame(conf, "target_acceleration_frame"));
+		}},
+		{"stiffness", [](const YAML::Node& conf, FactoryContext& context) -> ForceGeneratorPtr {
+			return std::make_shared<StiffnessGenerator>(
+				std::make_shared<Matrix6d>(context.matrix6d(conf, "stiffness")),
+				std::make_shared<Pose>(context.pose(conf, "target_position")),
+				context.frame(conf, "frame"));
+		}},
+		{"potential_field", [](const YAML::Node& conf, FactoryContext& context) -> ForceGeneratorPtr {
+			std::shared_ptr<PotentialFieldGenerator> generator;
+			if(conf["offset"]) {
+				auto offset = getValues(conf, "offset");
+				if(offset.size() != 3) {
+					throw std::runtime_error(OPEN_PHRI_ERROR(fieldError("offset", "expected 3 values")));
+				}
+				generator = std::make_shared<PotentialFieldGenerator>(std::make_shared<Vector3d>(offset[0], offset[1], offset[2]), context.frame(conf, "frame"));
+			}
+			else {
+				generator = std::make_shared<PotentialFieldGenerator>(context.frame(conf, "frame"));
+			}
+			for(const auto& object: conf["objects"]) {
+				auto type = getField(object, "type").as<std::string>();
+				if(type != "attractive" and type != "repulsive") {
+					throw std::runtime_error(OPEN_PHRI_ERROR(fieldError("type", "expected attractive or repulsive")));
+				}
+				generator->add(
+					getField(object, "name").as<std::string>(),
+					std::make_shared<PotentialFieldObject>(
+						type == "attractive" ? PotentialFieldType::Attractive : PotentialFieldType::Repulsive,
+						context.input(object, "gain"),
+						context.input(object, "threshold_distance"),
+						std::make_shared<Pose>(context.pose(object, "position"))));
+			}
+			return generator;
+		}}
+	};
+}
+
+template<>
+std::map<std::string, TorqueGeneratorFactory::create_method_t> builtinCreateMethods<TorqueGenerator>() {
+	return {
+		{"torque_proxy", [](const YAML::Node& conf, FactoryContext& context) -> TorqueGeneratorPtr {
+			auto torque = conf["torque"] ? context.jointVector(conf, "torque") : VectorXd::Zero(context.robot()->jointCount());
+			return std::make_shared<TorqueProxy>(std::make_shared<VectorXd>(torque));
+		}}
+	};
+}
+
+template<>
+std::map<std::string, VelocityGeneratorFactory::create_method_t> builtinCreateMethods<VelocityGenerator>() {
+	return {
+		{"velocity_proxy", [](const YAML::Node& conf, FactoryContext& context) -> VelocityGeneratorPtr {
+			auto velocity = conf["velocity"] ? context.vector6d(conf, "velocity") : Vector6d::Zero();
+			return std::make_shared<VelocityProxy>(std::make_shared<Twist>(velocity), context.frame(conf, "frame"));
+		}},
+		{"force_control", [](const YAML::Node& conf, FactoryContext& context) -> VelocityGeneratorPtr {
+			auto target_type = conf["target_type"].as<std::string>("environment");
+			if(target_type != "environment" and target_type != "robot") {
+				throw std::runtime_error(OPEN_PHRI_ERROR(fieldError("target_type", "expected environment or robot")));
+			}
+			auto generator = std::make_shared<ForceControl>(
+				std::make_shared<Vector6d>(context.vector6d(conf, "target")),
+				context.sampleTime(),
+				std::make_shared<Vector6d>(context.vector6d(conf, "p_gain")),
+				std::make_shared<Vector6d>(context.vector6d(conf, "d_gain")),
+				std::make_shared<Vector6d>(context.vector6d(conf, "selection")),
+				context.frame(conf, "frame"),
+				target_type == "environment" ? ForceControlTargetType::Environment : ForceControlTargetType::Robot);
+			if(conf["filter_time_constant"]) {
+				generator->configureFilter(context.sampleTime(), conf["filter_time_constant"].as<double>());
+			}
+			return generator;
+		}}
+	};
+}
+
+template<>
+std::map<std::string, JointVelocityGeneratorFactory::create_method_t> builtinCreateMethods<JointVelocityGenerator>() {
+	return {
+		{"joint_velocity_proxy", [](const YAML::Node& conf, FactoryContext& context) -> JointVelocityGeneratorPtr {
+			auto velocity = conf["velocity"] ? context.jointVector(conf, "velocity") : VectorXd::Zero(context.robot()->jointCount());
+			return std::make_shared<JointVelocityProxy>(std::make_shared<VectorXd>(velocity));
+		}},
+		{"null_space_motion", [](const YAML::Node& conf, FactoryContext& context) -> JointVelocityGeneratorPtr {
+			auto velocity = conf["velocity"] ? context.jointVector(conf, "velocity") : VectorXd::Zero(context.robot()->jointCount());
+			return std::make_shared<NullSpaceMotion>(std::make_shared<VectorXd>(velocity));
+		}}
+	};
+}
+
+template<>
+std::map<std::string, InterpolatorFactory::create_method_t> builtinCreateMethods<Interpolator>() {
+	return {
+		{"linear", [](const YAML::Node& conf, FactoryContext& context) -> InterpolatorPtr {
+			auto point = [&context, &conf](const std::string& field) {
+				auto values = getField(conf, field);
+				if(not values.IsSequence() or values.size() != 2) {
+					throw std::runtime_error(OPEN_PHRI_ERROR(fieldError(field, "expected [x, y]")));
+				}
+				return std::make_shared<LinearPoint>(context.parameter(values[0]), context.parameter(values[1]));
+			};
+			auto interpolator = std::make_shared<LinearInterpolator>(point("from"), point("to"));
+			interpolator->enableSaturation(conf["saturation"].as<bool>(false));
+			if(conf["input"]) {
+				interpolator->setInput(context.input(conf, "input"));
+			}
+			return interpolator;
+		}},
+		{"polynomial", [](const YAML::Node& conf, FactoryContext& context) -> InterpolatorPtr {
+			auto point = [&context, &conf](const std::string& field) {
+				auto values = getField(conf, field);
+				if(not values.IsSequence() or values.size() != 4) {
+					throw std::runtime_error(OPEN_PHRI_ERROR(fieldError(field, "expected [x, y, dy, d2y]")));
+				}
+				return std::make_shared<PolynomialPoint>(
+					context.parameter(values[0]),
+					context.parameter(values[1]),
+					context.parameter(values[2]),
+					context.parameter(values[3]));
+			};
+			auto interpolator = std::make_shared<PolynomialInterpolator>(point("from"), point("to"));
+			if(conf["input"]) {
+				interpolator->setInput(context.input(conf, "input"));
+			}
+			return interpolator;
+		}}
+	};
+}
+
+template<typename T, typename AddT>
+void buildItems(const YAML::Node& items, FactoryContext& context, const std::string& collection_name, AddT add) {
+	for(const auto& item: items) {
+		auto name = getField(item, "name").as<std::string>();
+		std::shared_ptr<T> object;
+		try {
+			object = context.create<T>(item);
+		}
+		catch(std::exception& e) {
+			throw std::runtime_error(OPEN_PHRI_ERROR("Can't create the " + collection_name + " '" + name + "': " + e.what()));
+		}
+		if(not add(name, object)) {
+			throw std::runtime_error(OPEN_PHRI_ERROR("A " + collection_name + " called '" + name + "' already exists"));
+		}
+	}
+}
+
+}
+
+/***			ObjectFactory			***/
+
+template<typename T>
+std::map<std::string, typename ObjectFactory<T>::create_method_t>& ObjectFactory<T>::createMethods() {
+	// Filled on first use so that the built-in types are always available, whatever the static initialization order
+	static auto create_methods = builtinCreateMethods<T>();
+	return create_methods;
+}
+
+template class phri::ObjectFactory<Constraint>;
+template class phri::ObjectFactory<ForceGenerator>;
+template class phri::ObjectFactory<TorqueGenerator>;
+template class phri::ObjectFactory<VelocityGenerator>;
+template class phri::ObjectFactory<JointVelocityGenerator>;
+template class phri::ObjectFactory<Interpolator>;
+
+/***			FactoryContext			***/
+
+FactoryContext::FactoryContext(RobotPtr robot, double sample_time, ParameterBlockPtr parameters) :
+	robot_(robot),
+	sample_time_(sample_time),
+	parameters_(parameters)
+{
+}
+
+RobotPtr FactoryContext::robot() const {
+	return robot_;
+}
+
+double FactoryContext::sampleTime() const {
+	return sample_time_;
+}
+
+ParameterBlockPtr FactoryContext::parameters() const {
+	return parameters_;
+}
+
+doublePtr FactoryContext::parameter(const YAML::Node& value) {
+	if(not value.IsScalar()) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("A number or a parameter name is expected"));
+	}
+	try {
+		return parameters_->add(value.as<double>());
+	}
+	catch(YAML::BadConversion&) {
+		auto name = value.as<std::string>();
+		if(not parameters_->has(name)) {
+			throw std::runtime_error(OPEN_PHRI_ERROR("No shared parameter called '" + name + "'"));
+		}
+		return parameters_->get(name);
+	}
+}
+
+doublePtr FactoryContext::parameter(const YAML::Node& configuration, const std::string& field) {
+	try {
+		return parameter(getField(configuration, field));
+	}
+	catch(std::runtime_error& e) {
+		throw std::runtime_error(OPEN_PHRI_ERROR(fieldError(field, e.what())));
+	}
+}
+
+doublePtr FactoryContext::parameter(const YAML::Node& configuration, const std::string& field, double default_value) {
+	if(configuration[field]) {
+		return parameter(configuration, field);
+	}
+	return parameters_->add(default_value);
+}
+
+doubleConstPtr FactoryContext::input(const YAML::Node& configuration, const std::string& field) {
+	auto value = getField(configuration, field);
+	if(value.IsScalar()) {
+		auto input = inputs_.find(value.as<std::string>());
+		if(input != inputs_.end()) {
+			return input->second;
+		}
+	}
+	return parameter(configuration, field);
+}
+
+void FactoryContext::addInput(const std::string& name, doubleConstPtr input) {
+	inputs_[name] = input;
+}
+
+Vector6d FactoryContext::vector6d(const YAML::Node& configuration, const std::string& field) {
+	auto values = getValues(configuration, field);
+	if(values.size() != 6) {
+		throw std::runtime_error(OPEN_PHRI_ERROR(fieldError(field, "expected 6 values")));
+	}
+	return Eigen::Map<Vector6d>(values.data());
+}
+
+VectorXd FactoryContext::jointVector(const YAML::Node& configuration, const std::string& field) {
+	auto node = getField(configuration, field);
+	const auto joint_count = robot_->jointCount();
+	if(node.IsScalar()) {
+		return VectorXd::Constant(joint_count, node.as<double>());
+	}
+	auto values = getValues(configuration, field);
+	if(values.size() != joint_count) {
+		throw std::runtime_error(OPEN_PHRI_ERROR(fieldError(field, "expected " + std::to_string(joint_count) + " values")));
+	}
+	return Eigen::Map<VectorXd>(values.data(), values.size());
+}
+
+Matrix6d FactoryContext::matrix6d(const YAML::Node& configuration, const std::string& field) {
+	auto values = getValues(configuration, field);
+	if(values.size() == 6) {
+		return Eigen::Map<Vector6d>(values.data()).asDiagonal();
+	}
+	else if(values.size() == 36) {
+		return Eigen::Map<Eigen::Matrix<double, 6, 6, Eigen::RowMajor>>(values.data());
+	}
+	throw std::runtime_error(OPEN_PHRI_ERROR(fieldError(field, "expected 6 (diagonal) or 36 values")));
+}
+
+Pose FactoryContext::pose(const YAML::Node& configuration, const std::string& field) {
+	auto values = getValues(configuration, field);
+	if(values.size() == 3) {
+		return Pose(Vector3d(values[0], values[1], values[2]), Eigen::Quaterniond::Identity());
+	}
+	else if(values.size() == 6) {
+		return Pose(Vector3d(values[0], values[1], values[2]), Vector3d(values[3], values[4], values[5]));
+	}
+	throw std::runtime_error(OPEN_PHRI_ERROR(fieldError(field, "expected [x, y, z] or [x, y, z, rx, ry, rz]")));
+}
+
+ReferenceFrame FactoryContext::frame(const YAML::Node& configuration, const std::string& field, ReferenceFrame default_value) {
+	if(not configuration[field]) {
+		return default_value;
+	}
+	auto frame = configuration[field].as<std::string>();
+	if(frame == "tcp") {
+		return ReferenceFrame::TCP;
+	}
+	else if(frame == "base") {
+		return ReferenceFrame::Base;
+	}
+	else if(frame == "world") {
+		return ReferenceFrame::World;
+	}
+	throw std::runtime_error(OPEN_PHRI_ERROR(fieldError(field, "expected tcp, base or world")));
+}
+
+/***			ControllerFactory			***/
+
+ParameterBlockPtr ControllerFactory::build(SafetyController& controller, RobotPtr robot, const YAML::Node& configuration, double sample_time) {
+	const auto& controller_configuration = configuration["controller"];
+
+	// All the parameters are allocated at once so that they are contiguous in memory
+	auto parameters = std::make_shared<ParameterBlock>(controller_configuration ? scalarCount(controller_configuration) : 0);
+	if(not controller_configuration) {
+		return parameters;
+	}
+
+	for(const auto& parameter: controller_configuration["shared_parameters"]) {
+		parameters->add(parameter.first.as<std::string>(), parameter.second.as<double>());
+	}
+
+	FactoryContext context(robot, sample_time, parameters);
+	buildItems<Constraint>(controller_configuration["constraints"], context, "constraint",
+		[&controller](const std::string& name, ConstraintPtr object) { return controller.addConstraint(name, object); });
+	buildItems<ForceGenerator>(controller_configuration["force_generators"], context, "force generator",
+		[&controller](const std::string& name, ForceGeneratorPtr object) { return controller.addForceGenerator(name, object); });
+	buildItems<TorqueGenerator>(controller_configuration["torque_generators"], context, "torque generator",
+		[&controller](const std::string& name, TorqueGeneratorPtr object) { return controller.addTorqueGenerator(name, object); });
+	buildItems<VelocityGenerator>(controller_configuration["velocity_generators"], context, "velocity generator",
+		[&controller](const std::string& name, VelocityGeneratorPtr object) { return controller.addVelocityGenerator(name, object); });
+	buildItems<JointVelocityGenerator>(controller_configuration["joint_velocity_generators"], context, "joint velocity generator",
+		[&controller](const std::string& name, JointVelocityGeneratorPtr object) { return controller.addJointVelocityGenerator(name, object); });
+
+	return parameters;
+}
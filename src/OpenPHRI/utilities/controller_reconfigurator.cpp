@@ -0,0 +1,163 @@
+/*      File: controller_reconfigurator.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/controller_reconfigurator.h>
+#include <OpenPHRI/constraints/constraint.h>
+#include <OpenPHRI/force_generators/force_generator.h>
+#include <OpenPHRI/torque_generators/torque_generator.h>
+#include <OpenPHRI/velocity_generators/velocity_generator.h>
+#include <OpenPHRI/joint_velocity_generators/joint_velocity_generator.h>
+
+#include <chrono>
+
+using namespace phri;
+
+ControllerReconfigurator::ControllerReconfigurator(SafetyControllerPtr controller, RobotPtr robot, ParameterBlockPtr parameters) :
+	controller_(controller),
+	robot_(robot),
+	pending_(nullptr),
+	retired_(nullptr),
+	reconfiguration_count_(0),
+	parameters_(parameters),
+	building_(false),
+	stop_(false)
+{
+	thread_ = std::thread(&ControllerReconfigurator::process, this);
+}
+
+ControllerReconfigurator::~ControllerReconfigurator() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	cv_.notify_all();
+	thread_.join();
+	delete pending_.exchange(nullptr);
+	delete retired_.exchange(nullptr);
+}
+
+void ControllerReconfigurator::setBuilder(Builder builder) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	builder_ = builder;
+}
+
+void ControllerReconfigurator::reconfigure(const YAML::Node& configuration) {
+	auto request = std::make_unique<Request>();
+	request->configuration = YAML::Clone(configuration);
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		request_ = std::move(request);
+	}
+	cv_.notify_all();
+}
+
+void ControllerReconfigurator::reconfigureFromFile(const std::string& configuration_file) {
+	auto request = std::make_unique<Request>();
+	request->file = configuration_file;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		request_ = std::move(request);
+	}
+	cv_.notify_all();
+}
+
+bool ControllerReconfigurator::update() {
+	// Wait for the background thread to destroy the previous configuration so that the control thread never has to
+	if(retired_.load(std::memory_order_acquire) != nullptr) {
+		return false;
+	}
+	auto configuration = pending_.exchange(nullptr, std::memory_order_acquire);
+	if(configuration == nullptr) {
+		return false;
+	}
+	controller_->swapConfiguration(*configuration->controller);
+	retired_.store(configuration, std::memory_order_release);
+	reconfiguration_count_.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void ControllerReconfigurator::waitUntilBuilt() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	cv_.wait(lock, [this]{ return stop_ or (not request_ and not building_); });
+}
+
+size_t ControllerReconfigurator::reconfigurationCount() const {
+	return reconfiguration_count_.load(std::memory_order_relaxed);
+}
+
+ParameterBlockPtr ControllerReconfigurator::parameters() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	// The background thread only deletes the retired configuration while holding the lock
+	auto retired = retired_.load(std::memory_order_acquire);
+	if(retired != nullptr) {
+		return retired->parameters;
+	}
+	return parameters_;
+}
+
+std::string ControllerReconfigurator::lastError() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return last_error_;
+}
+
+void ControllerReconfigurator::process() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	while(not stop_) {
+		// Wake up periodically to destroy the configurations swapped out by update()
+		cv_.wait_for(lock, std::chrono::milliseconds(10), [this]{ return stop_ or request_; });
+		auto retired = retired_.load(std::memory_order_acquire);
+		if(retired != nullptr) {
+			// The previous parameter block is released here rather than on the control thread
+			parameters_ = std::move(retired->parameters);
+			retired_.store(nullptr, std::memory_order_release);
+			delete retired;
+		}
+		if(request_ and not stop_) {
+			auto request = std::move(request_);
+			building_ = true;
+			lock.unlock();
+			build(*request);
+			lock.lock();
+			building_ = false;
+			cv_.notify_all();
+		}
+	}
+}
+
+void ControllerReconfigurator::build(const Request& request) {
+	try {
+		auto configuration = request.file.empty() ? request.configuration : YAML::LoadFile(request.file);
+		auto staged = std::make_unique<Configuration>();
+		staged->controller = std::make_unique<SafetyController>(robot_, configuration);
+		Builder builder;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			builder = builder_;
+		}
+		if(builder) {
+			staged->parameters = builder(*staged->controller, configuration);
+		}
+		// A configuration not swapped in yet is replaced by the new one
+		delete pending_.exchange(staged.release(), std::memory_order_acq_rel);
+	}
+	catch(std::exception& e) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		last_error_ = e.what();
+	}
+}
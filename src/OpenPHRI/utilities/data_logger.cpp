@@ -19,12 +19,14 @@
 
 #include <OpenPHRI/safety_controller.h>
 #include <OpenPHRI/utilities/data_logger.h>
+#include <OpenPHRI/utilities/exceptions.h>
 #include <OpenPHRI/constraints/constraint.h>
 #include <OpenPHRI/force_generators/force_generator.h>
 #include <OpenPHRI/torque_generators/torque_generator.h>
 #include <OpenPHRI/velocity_generators/velocity_generator.h>
 #include <OpenPHRI/joint_velocity_generators/joint_velocity_generator.h>
 #include <iomanip>
+#include <cmath>
 
 using namespace phri;
 
@@ -38,7 +40,24 @@ DataLogger::DataLogger(
 	directory_(directory),
 	time_(time),
 	create_gnuplot_files_(create_gnuplot_files),
-	delay_disk_write_(delay_disk_write)
+	delay_disk_write_(delay_disk_write),
+	binary_mode_(false),
+	binary_buffer_cycles_(0),
+	binary_chunk_rows_(0),
+	binary_append_(false),
+	binary_row_size_(1),
+	binary_controller_items_(0),
+	binary_controller_version_(0),
+	binary_file_index_(0),
+	channels_collected_(false),
+	cycle_(0),
+	default_decimation_(1),
+	triggered_(false),
+	black_box_capacity_(0),
+	black_box_{{}, 0, 0},
+	black_box_spare_{{}, 0, 0},
+	black_box_writing_(false),
+	black_box_flushes_(0)
 {
 	if(*directory_.end() != '/') {
 		directory_.push_back('/');
@@ -46,10 +65,72 @@ DataLogger::DataLogger(
 }
 
 DataLogger::~DataLogger() {
+	waitBlackBoxWriter();
 	writeStoredDataToDisk();
 	closeFiles();
 }
 
+void DataLogger::enableBinaryMode(size_t buffer_cycles, size_t chunk_rows, bool append) {
+	if(not log_files_.empty() or controller_ != nullptr) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The binary mode must be enabled before adding data to log"));
+	}
+	binary_mode_ = true;
+	binary_buffer_cycles_ = buffer_cycles;
+	binary_chunk_rows_ = chunk_rows;
+	binary_append_ = append;
+}
+
+uint64_t DataLogger::droppedCycles() const {
+	return binary_writer_ ? binary_writer_->droppedRows() : 0;
+}
+
+void DataLogger::setDecimation(const std::string& data_name, size_t factor) {
+	decimations_[data_name] = factor;
+}
+
+void DataLogger::setDefaultDecimation(size_t factor) {
+	default_decimation_ = factor;
+}
+
+void DataLogger::addTrigger(const std::string& name, const std::function<bool(void)>& condition) {
+	triggers_[name] = condition;
+}
+
+void DataLogger::addConstraintTrigger(const std::string& constraint, double threshold) {
+	addTrigger(
+		"constraint " + constraint,
+		[this, constraint, threshold]() {
+			if(controller_ == nullptr) {
+				return false;
+			}
+			for(auto it=controller_->constraints_begin(); it!=controller_->constraints_end(); ++it) {
+				if((constraint.empty() or it->first == constraint) and it->second.last_value < threshold) {
+					return true;
+				}
+			}
+			return false;
+		});
+}
+
+void DataLogger::removeTrigger(const std::string& name) {
+	triggers_.erase(name);
+}
+
+bool DataLogger::isTriggered() const {
+	return triggered_;
+}
+
+void DataLogger::enableBlackBox(double duration, double sample_time) {
+	if(duration <= 0. or sample_time <= 0.) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The black box duration and the sample time must be strictly positive"));
+	}
+	black_box_capacity_ = static_cast<size_t>(std::ceil(duration / sample_time));
+}
+
+size_t DataLogger::blackBoxFlushes() const {
+	return black_box_flushes_;
+}
+
 void DataLogger::logSafetyControllerData(SafetyController* controller) {
 	controller_ = controller;
 }
@@ -88,10 +169,27 @@ void DataLogger::logRobotData(RobotConstPtr robot) {
 	robot_ = robot;
 }
 
+void DataLogger::logClockData(ClockConstPtr clock) {
+	clock_ = clock;
+
+	logExternalData("clockNominalTime", clock->getNominalTime().get(), 1);
+	logExternalData("clockMeasuredTime", clock->getMeasuredTime().get(), 1);
+	logExternalData("clockCycleTime", clock->getCycleTime().get(), 1);
+}
+
 void DataLogger::reset() {
 	controller_ = nullptr;
 	robot_.reset();
+	clock_.reset();
 	external_data_.clear();
+	binary_writer_.reset();
+	waitBinaryWriterClosing();
+	binary_file_index_ = 0;
+	binary_channels_.clear();
+	channels_collected_ = false;
+	waitBlackBoxWriter();
+	black_box_ = black_box{{}, 0, 0};
+	black_box_spare_ = black_box{{}, 0, 0};
 }
 
 std::ofstream& DataLogger::createLog(const std::string& data_name, size_t data_count) {
@@ -100,6 +198,10 @@ std::ofstream& DataLogger::createLog(const std::string& data_name, size_t data_c
 		return ch == ' ' ? '_' : ch;
 	});
 	auto& file = log_files_[data_name];
+	// In binary mode the stream is only used as an identifier for the data
+	if(binary_mode_) {
+		return file;
+	}
 	file.open(filename, std::ios_base::trunc);
 	if(not file.is_open()) {
 		throw std::runtime_error("Unable to open the file " + filename + " for writting");
@@ -156,10 +258,59 @@ void DataLogger::logData(std::ofstream& file, const external_data& data) {
 	data.write(stream);
 }
 
+bool DataLogger::isLogged(const std::string& data_name) const {
+	if(triggered_) {
+		return true;
+	}
+	size_t factor = default_decimation_;
+	if(not decimations_.empty()) {
+		auto decimation = decimations_.find(data_name);
+		if(decimation != decimations_.end()) {
+			factor = decimation->second;
+		}
+	}
+	return factor != 0 and cycle_ % factor == 0;
+}
+
 void DataLogger::process() {
+	bool triggered = false;
+	for(const auto& trigger: triggers_) {
+		triggered |= trigger.second();
+	}
+	bool trigger_fired = triggered and not triggered_;
+	triggered_ = triggered;
+
+	if(binary_mode_ or black_box_capacity_ > 0) {
+		if(not channels_collected_) {
+			collectChannels();
+		}
+		// The stored pointers would be dangling if items were removed from the controller or if it was reconfigured
+		else if(controllerItemCount() != binary_controller_items_ or (controller_ != nullptr and controller_->configurationVersion() != binary_controller_version_)) {
+			updateChannels();
+		}
+	}
+
+	if(black_box_capacity_ > 0) {
+		recordBlackBox();
+		if(trigger_fired) {
+			flushBlackBox();
+		}
+	}
+
+	if(binary_mode_) {
+		if(isLogged("")) {
+			processBinary();
+		}
+		++cycle_;
+		return;
+	}
+
 	if(controller_ != nullptr) {
 		for(auto it=controller_->constraints_begin(); it!=controller_->constraints_end(); ++it) {
 			const std::string& data_name = it->first;
+			if(not isLogged(data_name)) {
+				continue;
+			}
 			auto& file = log_files_[data_name];
 			if(not file.is_open()) {
 				createLog(data_name, 1);
@@ -169,6 +320,9 @@ void DataLogger::process() {
 
 		for(auto it=controller_->force_generators_begin(); it!=controller_->force_generators_end(); ++it) {
 			const std::string& data_name = it->first;
+			if(not isLogged(data_name)) {
+				continue;
+			}
 			auto& file = log_files_[data_name];
 			if(not file.is_open()) {
 				createLog(data_name, 6);
@@ -178,6 +332,9 @@ void DataLogger::process() {
 
 		for(auto it=controller_->torque_generators_begin(); it!=controller_->torque_generators_end(); ++it) {
 			const std::string& data_name = it->first;
+			if(not isLogged(data_name)) {
+				continue;
+			}
 			auto& file = log_files_[data_name];
 			if(not file.is_open()) {
 				createLog(data_name, 6);
@@ -187,6 +344,9 @@ void DataLogger::process() {
 
 		for(auto it=controller_->velocity_generators_begin(); it!=controller_->velocity_generators_end(); ++it) {
 			const std::string& data_name = it->first;
+			if(not isLogged(data_name)) {
+				continue;
+			}
 			auto& file = log_files_[data_name];
 			if(not file.is_open()) {
 				createLog(data_name, 6);
@@ -196,6 +356,9 @@ void DataLogger::process() {
 
 		for(auto it=controller_->joint_velocity_generators_begin(); it!=controller_->joint_velocity_generators_end(); ++it) {
 			const std::string& data_name = it->first;
+			if(not isLogged(data_name)) {
+				continue;
+			}
 			auto& file = log_files_[data_name];
 			if(not file.is_open()) {
 				createLog(data_name, 6);
@@ -205,8 +368,12 @@ void DataLogger::process() {
 	}
 
 	for(auto& data: external_data_) {
-		logData(*data.first, *data.second);
+		if(isLogged(data.second->name)) {
+			logData(*data.first, *data.second);
+		}
 	}
+
+	++cycle_;
 }
 
 void DataLogger::operator()() {
@@ -223,4 +390,198 @@ void DataLogger::closeFiles() {
 	for(auto& file: log_files_) {
 		file.second.close();
 	}
+	if(binary_writer_) {
+		binary_writer_->close();
+	}
+	waitBinaryWriterClosing();
+	waitBlackBoxWriter();
+}
+
+namespace {
+
+template<typename T>
+const double* valueData(const T& value) {
+	return value.data();
+}
+
+const double* valueData(const double& value) {
+	return &value;
+}
+
+template<typename T>
+size_t valueSize(const T& value) {
+	return value.size();
+}
+
+size_t valueSize(const double& value) {
+	return 1;
+}
+
+size_t valueSize(const Twist& value) {
+	return 6;
+}
+
+template<typename ItT, typename ChannelT>
+void addControllerChannels(ItT begin, ItT end, std::vector<BinaryLogSignal>& signals, std::vector<ChannelT>& channels) {
+	for(auto it=begin; it!=end; ++it) {
+		const auto& value = it->second.last_value;
+		signals.push_back({it->first, valueSize(value)});
+		channels.push_back({valueData(value), nullptr, valueSize(value)});
+	}
+}
+
+}
+
+size_t DataLogger::controllerItemCount() const {
+	if(controller_ == nullptr) {
+		return 0;
+	}
+	return
+		std::distance(controller_->constraints_begin(), controller_->constraints_end()) +
+		std::distance(controller_->force_generators_begin(), controller_->force_generators_end()) +
+		std::distance(controller_->torque_generators_begin(), controller_->torque_generators_end()) +
+		std::distance(controller_->velocity_generators_begin(), controller_->velocity_generators_end()) +
+		std::distance(controller_->joint_velocity_generators_begin(), controller_->joint_velocity_generators_end());
+}
+
+void DataLogger::collectChannels() {
+	binary_signals_.clear();
+	binary_channels_.clear();
+
+	if(controller_ != nullptr) {
+		addControllerChannels(controller_->constraints_begin(), controller_->constraints_end(), binary_signals_, binary_channels_);
+		addControllerChannels(controller_->force_generators_begin(), controller_->force_generators_end(), binary_signals_, binary_channels_);
+		addControllerChannels(controller_->torque_generators_begin(), controller_->torque_generators_end(), binary_signals_, binary_channels_);
+		addControllerChannels(controller_->velocity_generators_begin(), controller_->velocity_generators_end(), binary_signals_, binary_channels_);
+		addControllerChannels(controller_->joint_velocity_generators_begin(), controller_->joint_velocity_generators_end(), binary_signals_, binary_channels_);
+	}
+	binary_controller_items_ = controllerItemCount();
+	binary_controller_version_ = controller_ != nullptr ? controller_->configurationVersion() : 0;
+
+	for(const auto& file: log_files_) {
+		auto data = external_data_.find(const_cast<std::ofstream*>(&file.second));
+		if(data != external_data_.end()) {
+			binary_signals_.push_back({file.first, data->second->size});
+			binary_channels_.push_back({nullptr, data->second.get(), data->second->size});
+		}
+	}
+
+	binary_row_size_ = 1;
+	for(const auto& channel: binary_channels_) {
+		binary_row_size_ += channel.size;
+	}
+	channels_collected_ = true;
+}
+
+void DataLogger::updateChannels() {
+	auto previous_signals = std::move(binary_signals_);
+	collectChannels();
+	if(binary_signals_ == previous_signals) {
+		return;
+	}
+
+	// The logged data has changed: the binary log continues in a new file, started on the next logged cycle,
+	// and the black box history is restarted. The previous file is closed by a background thread.
+	if(binary_writer_) {
+		waitBinaryWriterClosing();
+		binary_writer_closing_ = std::thread(
+			[writer = std::move(binary_writer_)]() {
+				writer->close();
+			});
+		++binary_file_index_;
+	}
+	black_box_.rows.resize(black_box_capacity_ * binary_row_size_);
+	black_box_.count = 0;
+	black_box_.next = 0;
+}
+
+void DataLogger::fillRow(double* row) const {
+	*row++ = *time_;
+	for(const auto& channel: binary_channels_) {
+		if(channel.external != nullptr) {
+			channel.external->copyTo(row);
+		}
+		else {
+			std::copy_n(channel.data, channel.size, row);
+		}
+		row += channel.size;
+	}
+}
+
+void DataLogger::startBinaryLog() {
+	auto file = binary_file_index_ == 0 ? std::string("log_data.bin") : "log_data_" + std::to_string(binary_file_index_) + ".bin";
+	binary_writer_ = std::make_unique<BinaryLogWriter>(
+		directory_ + file,
+		binary_signals_,
+		binary_buffer_cycles_,
+		binary_chunk_rows_,
+		binary_append_ and binary_file_index_ == 0);
+}
+
+void DataLogger::waitBinaryWriterClosing() {
+	if(binary_writer_closing_.joinable()) {
+		binary_writer_closing_.join();
+	}
+}
+
+void DataLogger::processBinary() {
+	if(not binary_writer_) {
+		startBinaryLog();
+	}
+
+	double* row = binary_writer_->beginRow();
+	if(row != nullptr) {
+		fillRow(row);
+		binary_writer_->commitRow();
+	}
+}
+
+void DataLogger::recordBlackBox() {
+	if(black_box_.rows.empty()) {
+		black_box_.rows.resize(black_box_capacity_ * binary_row_size_);
+	}
+	if(black_box_spare_.rows.empty() and not black_box_writing_) {
+		black_box_spare_.rows.resize(black_box_capacity_ * binary_row_size_);
+	}
+	fillRow(black_box_.rows.data() + black_box_.next * binary_row_size_);
+	black_box_.next = (black_box_.next + 1) % black_box_capacity_;
+	black_box_.count = std::min(black_box_.count + 1, black_box_capacity_);
+}
+
+void DataLogger::flushBlackBox() {
+	// Skip this flush if the previous one is still being written
+	if(black_box_writing_) {
+		return;
+	}
+	waitBlackBoxWriter();
+
+	// The recorded history is handed over to the writer thread and the recording continues in the spare buffer.
+	// The spare buffer only needs to be resized if the logged data has changed since the previous flush.
+	std::swap(black_box_, black_box_spare_);
+	black_box_.rows.resize(black_box_capacity_ * binary_row_size_);
+	black_box_.count = 0;
+	black_box_.next = 0;
+
+	// The signals are copied since they can change before the history is written
+	auto file = directory_ + "log_blackbox_" + std::to_string(black_box_flushes_++) + ".bin";
+	black_box_writing_ = true;
+	black_box_writer_ = std::thread(
+		[this, file, signals = binary_signals_, row_size = binary_row_size_]() {
+			const auto& history = black_box_spare_;
+			BinaryLogWriter writer(file, signals);
+			for (size_t i = 0; i < history.count; ++i) {
+				size_t index = (history.next + black_box_capacity_ - history.count + i) % black_box_capacity_;
+				const double* recorded_row = history.rows.data() + index * row_size;
+				std::copy_n(recorded_row, row_size, writer.waitRow());
+				writer.commitRow();
+			}
+			writer.close();
+			black_box_writing_ = false;
+		});
+}
+
+void DataLogger::waitBlackBoxWriter() {
+	if(black_box_writer_.joinable()) {
+		black_box_writer_.join();
+	}
 }
@@ -0,0 +1,109 @@
+/*      File: joint_limits.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/joint_limits.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <limits>
+
+using namespace phri;
+
+JointLimits::JointLimits(size_t joint_count) :
+	limits_(joint_count, 4)
+{
+	constexpr double inf = std::numeric_limits<double>::infinity();
+	lowerPositions().setConstant(-inf);
+	upperPositions().setConstant(inf);
+	velocities().setConstant(inf);
+	forces().setConstant(inf);
+}
+
+JointLimits::JointLimits(
+	const VectorXd& lower_positions,
+	const VectorXd& upper_positions,
+	const VectorXd& velocities,
+	const VectorXd& forces) :
+	limits_(lower_positions.size(), 4)
+{
+	if(upper_positions.size() != limits_.rows() or velocities.size() != limits_.rows() or forces.size() != limits_.rows()) {
+		throw std::length_error(OPEN_PHRI_ERROR("All the limits must have the same size"));
+	}
+	lowerPositions() = lower_positions;
+	upperPositions() = upper_positions;
+	this->velocities() = velocities;
+	this->forces() = forces;
+}
+
+size_t JointLimits::jointCount() const {
+	return limits_.rows();
+}
+
+JointLimits::ConstLimit JointLimits::lowerPositions() const {
+	return limits_.col(LowerPosition);
+}
+JointLimits::ConstLimit JointLimits::upperPositions() const {
+	return limits_.col(UpperPosition);
+}
+JointLimits::ConstLimit JointLimits::velocities() const {
+	return limits_.col(Velocity);
+}
+JointLimits::ConstLimit JointLimits::forces() const {
+	return limits_.col(Force);
+}
+
+JointLimits::Limit JointLimits::lowerPositions() {
+	return limits_.col(LowerPosition);
+}
+JointLimits::Limit JointLimits::upperPositions() {
+	return limits_.col(UpperPosition);
+}
+JointLimits::Limit JointLimits::velocities() {
+	return limits_.col(Velocity);
+}
+JointLimits::Limit JointLimits::forces() {
+	return limits_.col(Force);
+}
+
+void JointLimits::clampPosition(VectorXd& position) const {
+	position = position.cwiseMax(lowerPositions()).cwiseMin(upperPositions());
+}
+
+void JointLimits::clampVelocity(VectorXd& velocity) const {
+	velocity = velocity.cwiseMax(-velocities()).cwiseMin(velocities());
+}
+
+void JointLimits::distanceToLowerLimits(const VectorXd& position, VectorXd& distance) const {
+	distance = position - lowerPositions();
+}
+
+void JointLimits::distanceToUpperLimits(const VectorXd& position, VectorXd& distance) const {
+	distance = upperPositions() - position;
+}
+
+void JointLimits::distanceToLimits(const VectorXd& position, VectorXd& distance) const {
+	distance = (position - lowerPositions()).cwiseMin(upperPositions() - position);
+}
+
+bool JointLimits::isInsidePositionLimits(const VectorXd& position) const {
+	return (position.array() >= lowerPositions().array()).all() and (position.array() <= upperPositions().array()).all();
+}
+
+bool JointLimits::isInsideVelocityLimits(const VectorXd& velocity) const {
+	return (velocity.cwiseAbs().array() <= velocities().array()).all();
+}
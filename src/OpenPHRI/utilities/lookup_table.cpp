@@ -0,0 +1,76 @@
+/*      File: lookup_table.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/lookup_table.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace phri;
+
+LookupTable::LookupTable() :
+	min_input_(0.),
+	max_input_(0.),
+	inverse_step_(0.),
+	values_(1, 0.)
+{
+}
+
+LookupTable::LookupTable(const std::function<double(double)>& function, double min_input, double max_input, size_t size) :
+	min_input_(min_input),
+	max_input_(max_input)
+{
+	if(size < 2 or not (max_input > min_input)) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("A lookup table needs at least two samples and a non-empty input range"));
+	}
+
+	const double step = (max_input - min_input) / (size - 1);
+	inverse_step_ = 1. / step;
+	values_.resize(size);
+	for (size_t i = 0; i < size; ++i) {
+		values_[i] = function(i < size - 1 ? min_input + i * step : max_input);
+	}
+}
+
+double LookupTable::operator()(double input) const {
+	if(not (input > min_input_)) {
+		return values_.front();
+	}
+	if(input >= max_input_) {
+		return values_.back();
+	}
+	const double position = (input - min_input_) * inverse_step_;
+	const size_t index = std::min(static_cast<size_t>(position), values_.size() - 2);
+	const double ratio = position - index;
+	return values_[index] + ratio * (values_[index+1] - values_[index]);
+}
+
+double LookupTable::minInput() const {
+	return min_input_;
+}
+
+double LookupTable::maxInput() const {
+	return max_input_;
+}
+
+size_t LookupTable::size() const {
+	return values_.size();
+}
@@ -0,0 +1,271 @@
+/*      File: loop_runner.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/loop_runner.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+using namespace phri;
+
+namespace {
+
+constexpr int64_t nanoseconds_per_second = 1000000000;
+
+int64_t toNanoseconds(const timespec& time) {
+	return static_cast<int64_t>(time.tv_sec) * nanoseconds_per_second + time.tv_nsec;
+}
+
+timespec toTimespec(int64_t time) {
+	timespec ts;
+	ts.tv_sec = time / nanoseconds_per_second;
+	ts.tv_nsec = time % nanoseconds_per_second;
+	return ts;
+}
+
+int64_t now() {
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return toNanoseconds(time);
+}
+
+void warning(const std::string& message) {
+	std::cerr << "[phri::LoopRunner] " << message << ": " << std::strerror(errno) << std::endl;
+}
+
+// Saves the scheduling configuration of the calling thread and restores it on destruction
+class ThreadConfigurationGuard {
+public:
+	ThreadConfigurationGuard() {
+		saved_scheduling_ = pthread_getschedparam(pthread_self(), &policy_, &param_) == 0;
+		saved_affinity_ = pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_), &cpu_set_) == 0;
+	}
+
+	~ThreadConfigurationGuard() {
+		if(saved_scheduling_) {
+			pthread_setschedparam(pthread_self(), policy_, &param_);
+		}
+		if(saved_affinity_) {
+			pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_), &cpu_set_);
+		}
+	}
+
+private:
+	bool saved_scheduling_;
+	bool saved_affinity_;
+	int policy_;
+	sched_param param_;
+	cpu_set_t cpu_set_;
+};
+
+}
+
+LoopRunner::LoopRunner(double period) :
+	LoopRunner(period, Options())
+{
+}
+
+LoopRunner::LoopRunner(double period, const Options& options) :
+	period_(period),
+	options_(options),
+	stop_requested_(false),
+	statistics_sequence_(0),
+	reset_requested_(false),
+	jitter_sum_(0.)
+{
+	if(period_ <= 0.) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The loop period must be strictly positive"));
+	}
+	if(options_.histogram_bins == 0 or options_.histogram_resolution <= 0.) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("The jitter histogram must have at least one bin and a strictly positive resolution"));
+	}
+	statistics_.jitter_histogram.resize(options_.histogram_bins, 0);
+}
+
+bool LoopRunner::run(const std::function<bool(void)>& cycle, uint64_t max_cycles) {
+	ThreadConfigurationGuard thread_configuration;
+
+	if(options_.lock_memory and mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+		warning("Can't lock the process memory");
+	}
+	if(options_.cpu >= 0) {
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		CPU_SET(options_.cpu, &cpu_set);
+		if((errno = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set)) != 0) {
+			warning("Can't set the thread affinity to CPU " + std::to_string(options_.cpu));
+		}
+	}
+	if(options_.priority > 0) {
+		sched_param param;
+		param.sched_priority = options_.priority;
+		if((errno = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param)) != 0) {
+			warning("Can't set the SCHED_FIFO scheduling policy with priority " + std::to_string(options_.priority));
+		}
+	}
+
+	const int64_t period = static_cast<int64_t>(period_ * 1e9);
+	int64_t deadline = now();
+	uint64_t cycles = 0;
+	bool ok = true;
+
+	// Apply a reset requested while the loop wasn't running
+	if(reset_requested_.exchange(false)) {
+		clearStatistics();
+	}
+
+	while(not stop_requested_ and (max_cycles == 0 or cycles < max_cycles)) {
+		const int64_t cycle_start = now();
+		const double jitter = std::max<int64_t>(cycle_start - deadline, 0) * 1e-9;
+
+		if(not cycle()) {
+			ok = false;
+			break;
+		}
+		++cycles;
+
+		const int64_t cycle_end = now();
+		const double cycle_duration = (cycle_end - cycle_start) * 1e-9;
+		if(not options_.pace) {
+			updateStatistics(0., cycle_duration, false, 0);
+			continue;
+		}
+
+		deadline += period;
+		// On overrun, skip the already elapsed deadlines instead of running several cycles back to back
+		uint64_t missed_periods = 0;
+		if(cycle_end > deadline) {
+			missed_periods = (cycle_end - deadline) / period + 1;
+			deadline += missed_periods * period;
+		}
+
+		updateStatistics(jitter, cycle_duration, cycle_duration > period_, missed_periods);
+
+		auto next_wake_up = toTimespec(deadline);
+		while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_wake_up, nullptr) == EINTR) {
+			continue;
+		}
+	}
+
+	if(options_.lock_memory) {
+		munlockall();
+	}
+
+	return ok;
+}
+
+void LoopRunner::stop() {
+	stop_requested_ = true;
+}
+
+void LoopRunner::reset() {
+	stop_requested_ = false;
+}
+
+LoopRunner::Statistics LoopRunner::getStatistics() const {
+	Statistics statistics;
+	statistics.jitter_histogram.resize(options_.histogram_bins, 0);
+	// The reset will be applied by the loop thread
+	if(reset_requested_) {
+		return statistics;
+	}
+
+	while(true) {
+		auto sequence = statistics_sequence_.load(std::memory_order_acquire);
+		if(sequence & 1) {
+			std::this_thread::yield();
+			continue;
+		}
+		statistics.cycles = statistics_.cycles;
+		statistics.overruns = statistics_.overruns;
+		statistics.missed_periods = statistics_.missed_periods;
+		statistics.last_cycle_duration = statistics_.last_cycle_duration;
+		statistics.max_cycle_duration = statistics_.max_cycle_duration;
+		statistics.mean_jitter = statistics_.mean_jitter;
+		statistics.max_jitter = statistics_.max_jitter;
+		// The histogram is never resized after construction
+		std::copy(statistics_.jitter_histogram.begin(), statistics_.jitter_histogram.end(), statistics.jitter_histogram.begin());
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if(statistics_sequence_.load(std::memory_order_relaxed) == sequence) {
+			return statistics;
+		}
+	}
+}
+
+void LoopRunner::resetStatistics() {
+	reset_requested_ = true;
+}
+
+double LoopRunner::getPeriod() const {
+	return period_;
+}
+
+void LoopRunner::updateStatistics(double jitter, double cycle_duration, bool overrun, uint64_t missed_periods) {
+	if(reset_requested_.exchange(false)) {
+		clearStatistics();
+	}
+
+	// Only the loop thread writes the sequence so a relaxed load is enough
+	auto sequence = statistics_sequence_.load(std::memory_order_relaxed);
+	statistics_sequence_.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	++statistics_.cycles;
+	if(overrun) {
+		++statistics_.overruns;
+	}
+	statistics_.missed_periods += missed_periods;
+	statistics_.last_cycle_duration = cycle_duration;
+	statistics_.max_cycle_duration = std::max(statistics_.max_cycle_duration, cycle_duration);
+
+	jitter_sum_ += jitter;
+	statistics_.mean_jitter = jitter_sum_ / statistics_.cycles;
+	statistics_.max_jitter = std::max(statistics_.max_jitter, jitter);
+	auto bin = std::min(static_cast<size_t>(jitter / options_.histogram_resolution), statistics_.jitter_histogram.size() - 1);
+	++statistics_.jitter_histogram[bin];
+
+	statistics_sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+// Clears the statistics in place, so that the histogram is not reallocated by the loop thread
+void LoopRunner::clearStatistics() {
+	auto sequence = statistics_sequence_.load(std::memory_order_relaxed);
+	statistics_sequence_.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	statistics_.cycles = 0;
+	statistics_.overruns = 0;
+	statistics_.missed_periods = 0;
+	statistics_.last_cycle_duration = 0.;
+	statistics_.max_cycle_duration = 0.;
+	statistics_.mean_jitter = 0.;
+	statistics_.max_jitter = 0.;
+	std::fill(statistics_.jitter_histogram.begin(), statistics_.jitter_histogram.end(), 0);
+	jitter_sum_ = 0.;
+
+	statistics_sequence_.store(sequence + 2, std::memory_order_release);
+}
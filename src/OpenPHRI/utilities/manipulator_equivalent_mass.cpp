@@ -19,6 +19,11 @@
 
 #include <OpenPHRI/utilities/manipulator_equivalent_mass.h>
 
+#include <Eigen/Eigenvalues>
+
+#include <cmath>
+#include <limits>
+
 using namespace phri;
 
 ManipulatorEquivalentMass::ManipulatorEquivalentMass(
@@ -34,9 +39,17 @@ ManipulatorEquivalentMass::ManipulatorEquivalentMass(
 	Vector6dConstPtr robot_position) :
 	inertia_matrix_(inertia_matrix),
 	jacobian_matrix_(jacobian_matrix),
-	robot_position_(robot_position)
+	robot_position_(robot_position),
+	inertia_decomposition_(inertia_matrix->rows()),
+	decomposition_valid_(false)
 {
 	mass_ = std::make_shared<double>(0.);
+
+	const auto joint_count = inertia_matrix->rows();
+	decomposed_inertia_.resize(joint_count, joint_count);
+	projected_jacobian_.resize(joint_count);
+	solution_.resize(joint_count);
+	jacobian_solution_.resize(joint_count, 3);
 }
 
 doubleConstPtr ManipulatorEquivalentMass::getEquivalentMass() const {
@@ -44,34 +57,60 @@ doubleConstPtr ManipulatorEquivalentMass::getEquivalentMass() const {
 }
 
 double ManipulatorEquivalentMass::compute() {
-	MatrixXd jac = *jacobian_matrix_;
-	MatrixXd inertia = *inertia_matrix_;
-	Vector3d direction = closestObjectDirection();
-
-	Matrix6d mass_inv = jac * inertia.inverse() * jac.transpose();
+	if(not updateDecomposition()) {
+		*mass_ = std::numeric_limits<double>::infinity();
+		return *mass_;
+	}
 
-	*mass_ = 1. / (direction.transpose() * mass_inv.block<3,3>(0,0) * direction);
+	const auto& jacobian = jacobian_matrix_->topRows<3>();
+	Vector3d direction;
+	if(closestObjectDirection(direction)) {
+		// m^-1 = u^T J M^-1 J^T u, with M^-1 J^T u = solution
+		projected_jacobian_.noalias() = jacobian.transpose() * direction;
+		solution_ = inertia_decomposition_.solve(projected_jacobian_);
+		*mass_ = 1. / projected_jacobian_.dot(solution_);
+	}
+	else {
+		// Largest equivalent mass: inverse of the smallest eigenvalue of J M^-1 J^T
+		jacobian_solution_ = inertia_decomposition_.solve(jacobian.transpose());
+		Matrix3d mass_inv;
+		mass_inv.noalias() = jacobian * jacobian_solution_;
+		Eigen::SelfAdjointEigenSolver<Matrix3d> eigen_solver;
+		eigen_solver.computeDirect(mass_inv, Eigen::EigenvaluesOnly);
+		*mass_ = 1. / eigen_solver.eigenvalues()(0);
+	}
 
 	return *mass_;
 }
 
-Vector3d ManipulatorEquivalentMass::closestObjectDirection() {
-	Vector3d direction = Vector3d::Zero();
-	const Vector3d& rob_pos = robot_position_->block<3,1>(0,0);
+bool ManipulatorEquivalentMass::updateDecomposition() {
+	const auto& inertia = *inertia_matrix_;
+	const bool same_size = inertia.rows() == decomposed_inertia_.rows() and inertia.cols() == decomposed_inertia_.cols();
+	if(decomposition_valid_ and same_size and inertia == decomposed_inertia_) {
+		return true;
+	}
+
+	decomposed_inertia_ = inertia;
+	inertia_decomposition_.compute(decomposed_inertia_);
+	decomposition_valid_ = inertia_decomposition_.info() == Eigen::Success;
+	return decomposition_valid_;
+}
+
+bool ManipulatorEquivalentMass::closestObjectDirection(Vector3d& direction) const {
+	const Vector3d rob_pos = robot_position_->block<3,1>(0,0);
 
 	double min_dist = std::numeric_limits<double>::infinity();
 	for(const auto& item : items_) {
-		Vector6d obj_pos = *item.second;
-		Vector3d obj_rob_vec = obj_pos.block<3,1>(0,0) - rob_pos;
+		const Vector3d obj_rob_vec = item.second->block<3,1>(0,0) - rob_pos;
 
-		double dist =  obj_rob_vec.norm();
-		min_dist = std::min(min_dist, dist);
-		if(min_dist == dist) {
-			direction = obj_rob_vec.normalized();
+		const double dist = obj_rob_vec.norm();
+		if(dist < min_dist and dist > 0.) {
+			min_dist = dist;
+			direction = obj_rob_vec / dist;
 		}
 	}
 
-	return direction;
+	return std::isfinite(min_dist);
 }
 
 double ManipulatorEquivalentMass::operator()() {
@@ -0,0 +1,74 @@
+/*      File: parameter_block.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/parameter_block.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <stdexcept>
+
+using namespace phri;
+
+ParameterBlock::ParameterBlock(size_t capacity) :
+	storage_(std::make_shared<std::vector<double>>(capacity, 0.)),
+	size_(0)
+{
+}
+
+doublePtr ParameterBlock::add(double value) {
+	if(size_ == storage_->size()) {
+		throw std::length_error(OPEN_PHRI_ERROR("The parameter block is full (" + std::to_string(storage_->size()) + " parameters)"));
+	}
+	auto& parameter = (*storage_)[size_++];
+	parameter = value;
+	// Aliasing constructor: the parameter shares the ownership of the whole storage
+	return doublePtr(storage_, &parameter);
+}
+
+doublePtr ParameterBlock::add(const std::string& name, double value) {
+	if(has(name)) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("A parameter called " + name + " already exists"));
+	}
+	auto parameter = add(value);
+	names_[name] = size_ - 1;
+	return parameter;
+}
+
+doublePtr ParameterBlock::get(const std::string& name) const {
+	auto parameter = names_.find(name);
+	if(parameter == names_.end()) {
+		throw std::domain_error(OPEN_PHRI_ERROR("No parameter called " + name));
+	}
+	return doublePtr(storage_, storage_->data() + parameter->second);
+}
+
+bool ParameterBlock::has(const std::string& name) const {
+	return names_.find(name) != names_.end();
+}
+
+size_t ParameterBlock::size() const {
+	return size_;
+}
+
+size_t ParameterBlock::capacity() const {
+	return storage_->size();
+}
+
+const double* ParameterBlock::data() const {
+	return storage_->data();
+}
@@ -0,0 +1,126 @@
+/*      File: point_cloud.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/point_cloud.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace phri;
+
+namespace {
+
+constexpr double min_distance = 1e-3;
+
+// Voxel coordinates are packed on 21 bits each in the voxel keys
+constexpr int64_t voxel_coordinate_offset = int64_t(1) << 20;
+constexpr int64_t voxel_coordinate_max = (int64_t(1) << 21) - 1;
+
+uint64_t voxelCoordinate(double value, double voxel_size) {
+	double coordinate = std::floor(value / voxel_size) + voxel_coordinate_offset;
+	// Points out of range (or NaN) end up in the border voxels
+	coordinate = std::max(0., std::min(static_cast<double>(voxel_coordinate_max), coordinate));
+	return static_cast<uint64_t>(coordinate);
+}
+
+}
+
+PointCloud::PointCloud(double voxel_size) :
+	voxel_size_(voxel_size),
+	points_(3, 0)
+{
+}
+
+void PointCloud::update(Matrix3Xd& points) {
+	points_.swap(points);
+	if(voxel_size_ > 0.) {
+		downsample();
+	}
+}
+
+void PointCloud::setVoxelSize(double voxel_size) {
+	voxel_size_ = voxel_size;
+}
+
+double PointCloud::voxelSize() const {
+	return voxel_size_;
+}
+
+const Matrix3Xd& PointCloud::points() const {
+	return points_;
+}
+
+size_t PointCloud::size() const {
+	return points_.cols();
+}
+
+double PointCloud::closestDistance(const Vector3d& point) const {
+	if(points_.cols() == 0) {
+		return std::numeric_limits<double>::infinity();
+	}
+	return std::sqrt((points_.colwise() - point).colwise().squaredNorm().minCoeff());
+}
+
+Vector3d PointCloud::repulsiveForce(const Vector3d& point, double gain, double threshold_distance) const {
+	if(points_.cols() == 0) {
+		return Vector3d::Zero();
+	}
+
+	distances_.resize(points_.cols());
+	distances_ = (points_.colwise() - point).colwise().norm();
+
+	// Per point scale factor of the force, zero for the points out of range. The force is then sum(scale_i * (p_i - point))
+	auto safe_distances = distances_.array().max(min_distance);
+	distances_ = (distances_.array() > min_distance and distances_.array() < threshold_distance).select(
+		gain * (1./threshold_distance - safe_distances.inverse()) * safe_distances.inverse(),
+		0.);
+
+	return points_ * distances_.transpose() - point * distances_.sum();
+}
+
+void PointCloud::downsample() {
+	const Eigen::Index count = points_.cols();
+
+	// Sort the points by voxel, then average the points of each voxel
+	voxels_.resize(count);
+	for (Eigen::Index i = 0; i < count; ++i) {
+		voxels_[i].first =
+			voxelCoordinate(points_(0,i), voxel_size_) << 42 |
+			voxelCoordinate(points_(1,i), voxel_size_) << 21 |
+			voxelCoordinate(points_(2,i), voxel_size_);
+		voxels_[i].second = i;
+	}
+	std::sort(voxels_.begin(), voxels_.end());
+
+	downsampled_points_.resize(3, count);
+	Eigen::Index voxel_count = 0;
+	for (Eigen::Index i = 0; i < count;) {
+		Vector3d centroid = Vector3d::Zero();
+		Eigen::Index j = i;
+		for (; j < count and voxels_[j].first == voxels_[i].first; ++j) {
+			centroid += points_.col(voxels_[j].second);
+		}
+		downsampled_points_.col(voxel_count++) = centroid / (j - i);
+		i = j;
+	}
+
+	downsampled_points_.conservativeResize(3, voxel_count);
+	points_.swap(downsampled_points_);
+}
@@ -0,0 +1,109 @@
+/*      File: robot_geometry.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/robot_geometry.h>
+#include <OpenPHRI/utilities/exceptions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace phri;
+
+RobotGeometry::RobotGeometry(Matrix3XdConstPtr link_positions) :
+	link_positions_(link_positions),
+	closest_capsule_(0)
+{
+}
+
+void RobotGeometry::addCapsule(size_t start_link, size_t end_link, double radius) {
+	const size_t link_count = link_positions_->cols();
+	if(start_link >= link_count or end_link >= link_count) {
+		throw std::out_of_range(OPEN_PHRI_ERROR("Invalid link index, there are only " + std::to_string(link_count) + " links"));
+	}
+	capsules_.push_back({start_link, end_link, radius});
+}
+
+void RobotGeometry::addSphere(size_t link, double radius) {
+	addCapsule(link, link, radius);
+}
+
+size_t RobotGeometry::size() const {
+	return capsules_.size();
+}
+
+double RobotGeometry::distance(const Matrix3Xd& points, double bound) {
+	if(capsules_.empty() or points.cols() == 0) {
+		return bound;
+	}
+
+	const Vector3d points_min = points.rowwise().minCoeff();
+	const Vector3d points_max = points.rowwise().maxCoeff();
+
+	// The capsule closest during the previous computation is likely to still be the closest one and gives a tight bound to skip the others
+	double min_distance = std::min(bound, capsuleDistance(capsules_[closest_capsule_], points));
+	for (size_t i = 0; i < capsules_.size(); ++i) {
+		if(i == closest_capsule_) {
+			continue;
+		}
+
+		// Lower bound of the distance using the bounding boxes of the capsule and of the points
+		const auto& capsule = capsules_[i];
+		const auto& start = link_positions_->col(capsule.start_link);
+		const auto& end = link_positions_->col(capsule.end_link);
+		const Vector3d capsule_min = start.cwiseMin(end);
+		const Vector3d capsule_max = start.cwiseMax(end);
+		const double lower_bound = (capsule_min - points_max).cwiseMax(points_min - capsule_max).cwiseMax(0.).norm() - capsule.radius;
+		if(lower_bound >= min_distance) {
+			continue;
+		}
+
+		const double capsule_distance = capsuleDistance(capsule, points);
+		if(capsule_distance < min_distance) {
+			min_distance = capsule_distance;
+			closest_capsule_ = i;
+		}
+	}
+
+	return min_distance;
+}
+
+size_t RobotGeometry::closestCapsule() const {
+	return closest_capsule_;
+}
+
+double RobotGeometry::capsuleDistance(const Capsule& capsule, const Matrix3Xd& points) {
+	const Vector3d start = link_positions_->col(capsule.start_link);
+	const Vector3d segment = link_positions_->col(capsule.end_link) - start;
+	const double squared_length = segment.squaredNorm();
+	const double inv_squared_length = squared_length > 0. ? 1. / squared_length : 0.;
+
+	// For each point p: s = (p - start).segment and the closest point on the segment is start + t*segment, with t = clamp(s/|segment|^2, 0, 1)
+	// so the squared distance is |p - start|^2 - 2*t*s + t^2*|segment|^2
+	projections_.resize(points.cols());
+	squared_distances_.resize(points.cols());
+	projections_.noalias() = segment.transpose() * points;
+	projections_.array() -= segment.dot(start);
+	squared_distances_ = (points.colwise() - start).colwise().squaredNorm();
+
+	auto t = (projections_.array() * inv_squared_length).max(0.).min(1.);
+	squared_distances_.array() -= t * (2. * projections_.array() - t * squared_length);
+
+	return std::max(0., std::sqrt(std::max(0., squared_distances_.minCoeff())) - capsule.radius);
+}
@@ -1,10 +1,12 @@
 #include <OpenPHRI/utilities/robot_model.h>
 #include <OpenPHRI/utilities/exceptions.h>
+#include "robot_model_cache.h"
 
 // RBDyn
 #include <RBDyn/Body.h>
 #include <RBDyn/FK.h>
 #include <RBDyn/FV.h>
+#include <RBDyn/FD.h>
 #include <RBDyn/Joint.h>
 #include <RBDyn/Jacobian.h>
 #include <RBDyn/MultiBody.h>
@@ -23,10 +25,53 @@ using namespace phri;
 struct RobotModel::pImpl {
 	pImpl(RobotPtr robot,
 	      const std::string& model_path,
-	      const std::string& control_point) :
+	      const std::string& control_point,
+	      const std::string& cache_directory) :
 		robot(robot)
 	{
 		auto file = PID_PATH(model_path);
+		std::unique_ptr<RobotModelCache> cache;
+		if(not cache_directory.empty()) {
+			cache = std::make_unique<RobotModelCache>(file, cache_directory);
+		}
+
+		joint_limits = std::make_shared<JointLimits>(0);
+		if(not (cache and cache->load(mb, name, *joint_limits))) {
+			parseModel(file);
+			if(cache and not cache->save(mb, name, *joint_limits)) {
+				std::cerr << "Failed to write the robot model cache file " << cache->path() << std::endl;
+			}
+		}
+		mbc = rbd::MultiBodyConfig(mb);
+		mbc.zero(mb);
+
+		auto joint_count = joint_limits->jointCount();
+
+		lower_limit = std::make_shared<VectorXd>(joint_limits->lowerPositions());
+		upper_limit = std::make_shared<VectorXd>(joint_limits->upperPositions());
+		velocity_limit = std::make_shared<VectorXd>(joint_limits->velocities());
+		force_limit = std::make_shared<VectorXd>(joint_limits->forces());
+
+		link_positions = std::make_shared<Matrix3Xd>(Matrix3Xd::Zero(3, mb.nrBodies()));
+		for (int i = 0; i < mb.nrBodies(); ++i) {
+			link_transforms.push_back(std::make_shared<AffineTransform>(AffineTransform::Identity()));
+		}
+
+		jacobian = rbd::Jacobian(mb, control_point);
+		control_point_body_index = mb.bodyIndexByName(control_point);
+
+		mbc.gravity = Eigen::Vector3d(0., 0., 9.81);
+		forward_dynamics = rbd::ForwardDynamics(mb);
+		inertia_matrix = std::make_shared<MatrixXd>(MatrixXd::Zero(joint_count, joint_count));
+		coriolis_forces = std::make_shared<VectorXd>(VectorXd::Zero(joint_count));
+		gravity_forces = std::make_shared<VectorXd>(VectorXd::Zero(joint_count));
+		bias_forces = std::make_shared<VectorXd>(VectorXd::Zero(joint_count));
+		// NaNs so that the first comparison always fails
+		dynamics_joint_position = VectorXd::Constant(joint_count, std::nan(""));
+		zero_joint_velocity = VectorXd::Zero(joint_count);
+	}
+
+	void parseModel(const std::string& file) {
 		auto extension_pos = file.rfind('.');
 		auto extension = file.substr(extension_pos+1);
 		rbd::ParserResult parser_result;
@@ -40,9 +85,9 @@ struct RobotModel::pImpl {
 			throw std::runtime_error(OPEN_PHRI_ERROR("Unkown robot model extension '" + extension + "'. Please provide a yaml, yml or urdf file."));
 		}
 		mb = parser_result.mb;
-		mbc = parser_result.mbc;
 		mbg = parser_result.mbg;
 		name = parser_result.name;
+		const auto& mbc = parser_result.mbc;
 		auto indexes = mb.jointIndexByName();
 		size_t rbd_joint_count = mbc.q.size() - 1;
 		size_t joint_count = 0;
@@ -56,11 +101,6 @@ struct RobotModel::pImpl {
 		std::vector<double> rbd_velocity_limit(rbd_joint_count);
 		std::vector<double> rbd_force_limit(rbd_joint_count);
 
-		lower_limit = std::make_shared<VectorXd>(joint_count);
-		upper_limit = std::make_shared<VectorXd>(joint_count);
-		velocity_limit = std::make_shared<VectorXd>(joint_count);
-		force_limit = std::make_shared<VectorXd>(joint_count);
-
 		for(const auto& index: indexes) {
 			if(index.second == 0) {
 				// skip root joint
@@ -70,29 +110,28 @@ struct RobotModel::pImpl {
 			auto dof_count = parser_result.limits.lower[index.first].size();
 			if(dof_count > 0) {
 				rbd_lower_limit[index.second - 1] = parser_result.limits.lower[index.first][0];
-				rbd_lower_limit[index.second - 1] = parser_result.limits.upper[index.first][0];
-				rbd_lower_limit[index.second - 1] = parser_result.limits.velocity[index.first][0];
-				rbd_lower_limit[index.second - 1] = parser_result.limits.torque[index.first][0];
+				rbd_upper_limit[index.second - 1] = parser_result.limits.upper[index.first][0];
+				rbd_velocity_limit[index.second - 1] = parser_result.limits.velocity[index.first][0];
+				rbd_force_limit[index.second - 1] = parser_result.limits.torque[index.first][0];
 			}
 			else {
 				rbd_lower_limit[index.second - 1] = std::nan("");
-				rbd_lower_limit[index.second - 1] = std::nan("");
-				rbd_lower_limit[index.second - 1] = std::nan("");
-				rbd_lower_limit[index.second - 1] = std::nan("");
+				rbd_upper_limit[index.second - 1] = std::nan("");
+				rbd_velocity_limit[index.second - 1] = std::nan("");
+				rbd_force_limit[index.second - 1] = std::nan("");
 			}
 		}
+
+		joint_limits = std::make_shared<JointLimits>(joint_count);
 		for (size_t rbd_idx = 0, idx = 0; rbd_idx < rbd_joint_count; ++rbd_idx) {
 			if(not std::isnan(rbd_lower_limit[rbd_idx])) {
-				(*lower_limit)(idx) = rbd_lower_limit[rbd_idx];
-				(*upper_limit)(idx) = rbd_upper_limit[rbd_idx];
-				(*velocity_limit)(idx) = rbd_velocity_limit[rbd_idx];
-				(*force_limit)(idx) = rbd_force_limit[rbd_idx];
+				joint_limits->lowerPositions()(idx) = rbd_lower_limit[rbd_idx];
+				joint_limits->upperPositions()(idx) = rbd_upper_limit[rbd_idx];
+				joint_limits->velocities()(idx) = rbd_velocity_limit[rbd_idx];
+				joint_limits->forces()(idx) = rbd_force_limit[rbd_idx];
 				++idx;
 			}
 		}
-
-		jacobian = rbd::Jacobian(mb, control_point);
-		control_point_body_index = mb.bodyIndexByName(control_point);
 	}
 
 	void updateJointPositions() {
@@ -105,6 +144,15 @@ struct RobotModel::pImpl {
 		}
 	}
 
+	void updateJointVelocities(const VectorXd& joint_vel) {
+		for (size_t idx = 0, rbd_idx = 1; idx < joint_vel.size(); ++rbd_idx) {
+			if(mbc.alpha[rbd_idx].size() > 0) {
+				mbc.alpha[rbd_idx][0] = joint_vel(idx);
+				++idx;
+			}
+		}
+	}
+
 	void updateSpatialTransformation() {
 		auto& mat = *robot->spatialTransformationMatrix();
 		const auto& rot_mat = robot->transformationMatrix()->block<3,3>(0,0);
@@ -126,17 +174,49 @@ struct RobotModel::pImpl {
 		robot->transformationMatrix()->block<3,3>(0,0) = tcp_pose.rotation().transpose();
 		updateSpatialTransformation();
 
+		for (int i = 0; i < mb.nrBodies(); ++i) {
+			const auto& body_pose = mbc.bodyPosW[i];
+			link_positions->col(i) = body_pose.translation();
+			link_transforms[i]->linear() = body_pose.rotation().transpose();
+			link_transforms[i]->translation() = body_pose.translation();
+		}
+
 		auto joint_count = robot->jointCount();
 		Eigen::MatrixXd jac_mat = jacobian.jacobian(mb, mbc);
 		robot->jacobian()->block(0, 0, 3, joint_count) = jac_mat.block(3, 0, 3, joint_count);
 		robot->jacobian()->block(3, 0, 3, joint_count) = jac_mat.block(0, 0, 3, joint_count);
 	}
 
+	void updateDynamics() {
+		const auto& joint_pos = *robot->jointCurrentPosition();
+		if(joint_pos != dynamics_joint_position) {
+			updateJointPositions();
+			rbd::forwardKinematics(mb, mbc);
+			forward_dynamics.computeH(mb, mbc);
+			*inertia_matrix = forward_dynamics.H();
+
+			// The gravity forces are the bias forces at zero velocity
+			updateJointVelocities(zero_joint_velocity);
+			rbd::forwardVelocity(mb, mbc);
+			forward_dynamics.computeC(mb, mbc);
+			*gravity_forces = forward_dynamics.C();
+
+			dynamics_joint_position = joint_pos;
+		}
+
+		updateJointVelocities(*robot->jointVelocity());
+		rbd::forwardVelocity(mb, mbc);
+		forward_dynamics.computeC(mb, mbc);
+		*bias_forces = forward_dynamics.C();
+		*coriolis_forces = *bias_forces - *gravity_forces;
+	}
+
 
 	rbd::MultiBody mb;
 	rbd::MultiBodyConfig mbc;
 	rbd::MultiBodyGraph mbg;
 	rbd::Jacobian jacobian;
+	rbd::ForwardDynamics forward_dynamics;
 	std::string name;
 
 	RobotPtr robot;
@@ -145,13 +225,24 @@ struct RobotModel::pImpl {
 	VectorXdPtr upper_limit;
 	VectorXdPtr velocity_limit;
 	VectorXdPtr force_limit;
+	JointLimitsPtr joint_limits;
+	Matrix3XdPtr link_positions;
+	std::vector<AffineTransformPtr> link_transforms;
+
+	MatrixXdPtr inertia_matrix;
+	VectorXdPtr coriolis_forces;
+	VectorXdPtr gravity_forces;
+	VectorXdPtr bias_forces;
+	VectorXd dynamics_joint_position;
+	VectorXd zero_joint_velocity;
 };
 
 RobotModel::RobotModel(
 	RobotPtr robot,
 	const std::string& model_path,
-	const std::string& control_point) :
-	impl_(std::make_unique<RobotModel::pImpl>(robot, model_path, control_point))
+	const std::string& control_point,
+	const std::string& cache_directory) :
+	impl_(std::make_unique<RobotModel::pImpl>(robot, model_path, control_point, cache_directory))
 {
 
 }
@@ -174,7 +265,9 @@ RobotModel::RobotModel(RobotPtr robot, const YAML::Node& configuration) {
 			throw std::runtime_error(OPEN_PHRI_ERROR("You must provide a 'control_point' field in the model configuration."));
 		}
 
-		impl_= std::make_unique<RobotModel::pImpl>(robot, path, control_point);
+		auto cache_directory = model["cache_directory"].as<std::string>("");
+
+		impl_= std::make_unique<RobotModel::pImpl>(robot, path, control_point, cache_directory);
 	}
 	else {
 		throw std::runtime_error(OPEN_PHRI_ERROR("The configuration file doesn't include a 'model' field."));
@@ -187,6 +280,10 @@ void RobotModel::forwardKinematics() const {
 	impl_->forwardKinematics();
 }
 
+void RobotModel::updateDynamics() const {
+	impl_->updateDynamics();
+}
+
 VectorXdConstPtr RobotModel::getLowerLimits() const {
 	return impl_->lower_limit;
 }
@@ -199,6 +296,36 @@ VectorXdConstPtr RobotModel::getVelocityLimits() const {
 VectorXdConstPtr RobotModel::getForceLimits() const {
 	return impl_->force_limit;
 }
+JointLimitsConstPtr RobotModel::getJointLimits() const {
+	return impl_->joint_limits;
+}
+Matrix3XdConstPtr RobotModel::getLinkPositions() const {
+	return impl_->link_positions;
+}
+AffineTransformConstPtr RobotModel::getLinkTransform(size_t link) const {
+	return impl_->link_transforms.at(link);
+}
+size_t RobotModel::linkIndex(const std::string& name) const {
+	const auto& bodies = impl_->mb.bodies();
+	for (size_t i = 0; i < bodies.size(); ++i) {
+		if(bodies[i].name() == name) {
+			return i;
+		}
+	}
+	throw std::runtime_error(OPEN_PHRI_ERROR("The robot model has no link called " + name));
+}
+MatrixXdConstPtr RobotModel::getInertiaMatrix() const {
+	return impl_->inertia_matrix;
+}
+VectorXdConstPtr RobotModel::getCoriolisForces() const {
+	return impl_->coriolis_forces;
+}
+VectorXdConstPtr RobotModel::getGravityForces() const {
+	return impl_->gravity_forces;
+}
+VectorXdConstPtr RobotModel::getBiasForces() const {
+	return impl_->bias_forces;
+}
 size_t RobotModel::jointCount() const {
 	return impl_->lower_limit->size();
 }
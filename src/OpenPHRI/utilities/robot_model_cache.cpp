@@ -0,0 +1,373 @@
+/*      File: robot_model_cache.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "robot_model_cache.h"
+
+#include <RBDyn/Body.h>
+#include <RBDyn/Joint.h>
+
+#include <sys/stat.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+using namespace phri;
+
+namespace {
+
+constexpr char cache_magic[8] = {'O', 'P', 'H', 'R', 'I', 'M', 'D', 'L'};
+constexpr uint32_t cache_format_version = 1;
+// Upper bound on any count or string length read from a cache file, to reject corrupted files before allocating
+constexpr uint64_t cache_max_count = 1 << 16;
+
+using MotionSubspace = Eigen::Matrix<double, 6, Eigen::Dynamic>;
+
+class CacheWriter {
+public:
+	explicit CacheWriter(std::ostream& stream) :
+		stream_(stream)
+	{
+	}
+
+	template<typename T>
+	void write(const T& value) {
+		stream_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	void writeString(const std::string& str) {
+		write<uint64_t>(str.size());
+		stream_.write(str.data(), str.size());
+	}
+
+	template<typename Derived>
+	void writeMatrix(const Eigen::MatrixBase<Derived>& mat) {
+		for (Eigen::Index col = 0; col < mat.cols(); ++col) {
+			for (Eigen::Index row = 0; row < mat.rows(); ++row) {
+				write<double>(mat(row, col));
+			}
+		}
+	}
+
+	void writeIndexes(const std::vector<int>& vec) {
+		write<uint64_t>(vec.size());
+		for(auto value: vec) {
+			write<int32_t>(value);
+		}
+	}
+
+private:
+	std::ostream& stream_;
+};
+
+class CacheReader {
+public:
+	explicit CacheReader(std::istream& stream) :
+		stream_(stream)
+	{
+	}
+
+	template<typename T>
+	T read() {
+		T value;
+		stream_.read(reinterpret_cast<char*>(&value), sizeof(T));
+		check();
+		return value;
+	}
+
+	uint64_t readCount() {
+		auto count = read<uint64_t>();
+		if(count > cache_max_count) {
+			throw std::length_error("invalid count");
+		}
+		return count;
+	}
+
+	std::string readString() {
+		std::string str(readCount(), '\0');
+		stream_.read(&str[0], str.size());
+		check();
+		return str;
+	}
+
+	// Taken by const reference to also accept temporary blocks, as advised by the Eigen documentation
+	template<typename Derived>
+	void readMatrix(const Eigen::MatrixBase<Derived>& const_mat) {
+		auto& mat = const_cast<Eigen::MatrixBase<Derived>&>(const_mat);
+		for (Eigen::Index col = 0; col < mat.cols(); ++col) {
+			for (Eigen::Index row = 0; row < mat.rows(); ++row) {
+				mat(row, col) = read<double>();
+			}
+		}
+	}
+
+	std::vector<int> readIndexes() {
+		std::vector<int> vec(readCount());
+		for(auto& value: vec) {
+			value = read<int32_t>();
+		}
+		return vec;
+	}
+
+private:
+	void check() {
+		if(not stream_) {
+			throw std::runtime_error("truncated cache file");
+		}
+	}
+
+	std::istream& stream_;
+};
+
+rbd::Joint makeJoint(rbd::Joint::Type type, bool forward, const std::string& name, const MotionSubspace& motion_subspace) {
+	switch(type) {
+	case rbd::Joint::Rev:
+	case rbd::Joint::Cylindrical:
+		return rbd::Joint(type, motion_subspace.block<3,1>(0,0), forward, name);
+	case rbd::Joint::Prism:
+		return rbd::Joint(type, motion_subspace.block<3,1>(3,0), forward, name);
+	default:
+		return rbd::Joint(type, forward, name);
+	}
+}
+
+}
+
+RobotModelCache::RobotModelCache(const std::string& model_file, const std::string& cache_directory) :
+	cache_directory_(cache_directory),
+	source_hash_(hashFile(model_file))
+{
+	if(cache_directory_.empty() or cache_directory_.back() != '/') {
+		cache_directory_.push_back('/');
+	}
+
+	auto name_pos = model_file.rfind('/');
+	auto model_name = name_pos == std::string::npos ? model_file : model_file.substr(name_pos+1);
+	std::ostringstream cache_file;
+	cache_file << cache_directory_ << model_name << '.' << std::hex << std::setw(16) << std::setfill('0') << source_hash_ << ".cache";
+	cache_file_ = cache_file.str();
+}
+
+bool RobotModelCache::load(rbd::MultiBody& mb, std::string& name, JointLimits& limits) const {
+	if(source_hash_ == 0) {
+		return false;
+	}
+
+	std::ifstream file(cache_file_, std::ios::binary);
+	if(not file.is_open()) {
+		return false;
+	}
+
+	try {
+		CacheReader reader(file);
+
+		char magic[sizeof(cache_magic)];
+		for(auto& c: magic) {
+			c = reader.read<char>();
+		}
+		if(not std::equal(magic, magic+sizeof(magic), cache_magic) or
+		   reader.read<uint32_t>() != cache_format_version or
+		   reader.read<uint64_t>() != source_hash_)
+		{
+			return false;
+		}
+
+		auto cached_name = reader.readString();
+
+		std::vector<rbd::Body> bodies(reader.readCount());
+		for(auto& body: bodies) {
+			auto body_name = reader.readString();
+			auto mass = reader.read<double>();
+			Vector3d momentum;
+			Matrix3d inertia;
+			reader.readMatrix(momentum);
+			reader.readMatrix(inertia);
+			body = rbd::Body(sva::RBInertiad(mass, momentum, inertia), body_name);
+		}
+
+		std::vector<rbd::Joint> joints(reader.readCount());
+		for(auto& joint: joints) {
+			auto joint_name = reader.readString();
+			auto type = static_cast<rbd::Joint::Type>(reader.read<int32_t>());
+			auto forward = reader.read<uint8_t>() != 0;
+			MotionSubspace motion_subspace(6, reader.readCount());
+			reader.readMatrix(motion_subspace);
+			joint = makeJoint(type, forward, joint_name, motion_subspace);
+			// Reject the cache if the joint cannot be reconstructed identically
+			if(joint.motionSubspace().cols() != motion_subspace.cols() or not joint.motionSubspace().isApprox(motion_subspace)) {
+				return false;
+			}
+		}
+
+		auto predecessors = reader.readIndexes();
+		auto successors = reader.readIndexes();
+		auto parents = reader.readIndexes();
+
+		std::vector<sva::PTransformd> transforms(reader.readCount());
+		for(auto& transform: transforms) {
+			Matrix3d rotation;
+			Vector3d translation;
+			reader.readMatrix(rotation);
+			reader.readMatrix(translation);
+			transform = sva::PTransformd(rotation, translation);
+		}
+
+		JointLimits cached_limits(reader.readCount());
+		reader.readMatrix(cached_limits.lowerPositions());
+		reader.readMatrix(cached_limits.upperPositions());
+		reader.readMatrix(cached_limits.velocities());
+		reader.readMatrix(cached_limits.forces());
+
+		for(auto c: cache_magic) {
+			if(reader.read<char>() != c) {
+				return false;
+			}
+		}
+
+		if(joints.size() != bodies.size() or predecessors.size() != joints.size() or successors.size() != joints.size() or parents.size() != bodies.size() or transforms.size() != joints.size()) {
+			return false;
+		}
+
+		// Reject out of range indexes before rbd::MultiBody dereferences them
+		const auto body_count = static_cast<int>(bodies.size());
+		auto in_range = [body_count](const std::vector<int>& indexes, int min) {
+			return std::all_of(indexes.begin(), indexes.end(), [body_count, min](int index) { return index >= min and index < body_count; });
+		};
+		if(not in_range(predecessors, -1) or not in_range(successors, 0) or not in_range(parents, -1)) {
+			return false;
+		}
+
+		rbd::MultiBody cached_mb(bodies, joints, predecessors, successors, parents, transforms);
+		// The limits are stored per configuration parameter, as in RobotModel
+		if(cached_limits.jointCount() != static_cast<size_t>(cached_mb.nrParams())) {
+			return false;
+		}
+
+		mb = std::move(cached_mb);
+		name = cached_name;
+		limits = cached_limits;
+	}
+	catch(...) {
+		return false;
+	}
+
+	return true;
+}
+
+bool RobotModelCache::save(const rbd::MultiBody& mb, const std::string& name, const JointLimits& limits) const {
+	if(source_hash_ == 0) {
+		return false;
+	}
+
+	if(mkdir(cache_directory_.c_str(), 0755) != 0 and errno != EEXIST) {
+		return false;
+	}
+
+	// Write to a temporary file and rename it so that a partially written cache is never used
+	auto tmp_file_name = cache_file_ + ".tmp";
+	{
+		std::ofstream file(tmp_file_name, std::ios::binary | std::ios::trunc);
+		if(not file.is_open()) {
+			return false;
+		}
+
+		CacheWriter writer(file);
+
+		for(auto c: cache_magic) {
+			writer.write(c);
+		}
+		writer.write(cache_format_version);
+		writer.write(source_hash_);
+
+		writer.writeString(name);
+
+		writer.write<uint64_t>(mb.bodies().size());
+		for(const auto& body: mb.bodies()) {
+			writer.writeString(body.name());
+			writer.write(body.inertia().mass());
+			writer.writeMatrix(body.inertia().momentum());
+			writer.writeMatrix(body.inertia().inertia());
+		}
+
+		writer.write<uint64_t>(mb.joints().size());
+		for(const auto& joint: mb.joints()) {
+			writer.writeString(joint.name());
+			writer.write<int32_t>(joint.type());
+			writer.write<uint8_t>(joint.forward());
+			writer.write<uint64_t>(joint.motionSubspace().cols());
+			writer.writeMatrix(joint.motionSubspace());
+		}
+
+		writer.writeIndexes(mb.predecessors());
+		writer.writeIndexes(mb.successors());
+		writer.writeIndexes(mb.parents());
+
+		writer.write<uint64_t>(mb.transforms().size());
+		for(const auto& transform: mb.transforms()) {
+			writer.writeMatrix(transform.rotation());
+			writer.writeMatrix(transform.translation());
+		}
+
+		writer.write<uint64_t>(limits.jointCount());
+		writer.writeMatrix(limits.lowerPositions());
+		writer.writeMatrix(limits.upperPositions());
+		writer.writeMatrix(limits.velocities());
+		writer.writeMatrix(limits.forces());
+
+		for(auto c: cache_magic) {
+			writer.write(c);
+		}
+
+		if(not file) {
+			std::remove(tmp_file_name.c_str());
+			return false;
+		}
+	}
+
+	return std::rename(tmp_file_name.c_str(), cache_file_.c_str()) == 0;
+}
+
+const std::string& RobotModelCache::path() const {
+	return cache_file_;
+}
+
+uint64_t RobotModelCache::hashFile(const std::string& file) {
+	// 64-bit FNV-1a
+	constexpr uint64_t fnv_offset_basis = 0xcbf29ce484222325ULL;
+	constexpr uint64_t fnv_prime = 0x100000001b3ULL;
+
+	std::ifstream stream(file, std::ios::binary);
+	if(not stream.is_open()) {
+		return 0;
+	}
+
+	uint64_t hash = fnv_offset_basis;
+	char buffer[4096];
+	while(stream) {
+		stream.read(buffer, sizeof(buffer));
+		for (std::streamsize i = 0; i < stream.gcount(); ++i) {
+			hash ^= static_cast<unsigned char>(buffer[i]);
+			hash *= fnv_prime;
+		}
+	}
+	return hash;
+}
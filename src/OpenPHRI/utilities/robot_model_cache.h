@@ -0,0 +1,86 @@
+/*      File: robot_model_cache.h
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file robot_model_cache.h
+ * @author Benjamin Navarro
+ * @brief Definition of the RobotModelCache class
+ * @date October 2026
+ * @ingroup OpenPHRI
+ */
+
+#pragma once
+
+#include <OpenPHRI/utilities/joint_limits.h>
+
+#include <RBDyn/MultiBody.h>
+
+#include <cstdint>
+#include <string>
+
+namespace phri {
+
+/** @brief Binary cache of a parsed robot model, used to skip the URDF/YAML parsing on subsequent loadings.
+ *  @details The cache file is keyed by a hash of the model file content so that any modification of the model invalidates it.
+ *  It is checked on load (header, hash, sizes, reconstructed joints) and rejected on any mismatch.
+ */
+class RobotModelCache {
+public:
+	/**
+	 * @brief Construct a cache for the given model file.
+	 * @param model_file Path to the robot model file (URDF or YAML).
+	 * @param cache_directory Directory in which the cache files are stored. Created if needed.
+	 */
+	RobotModelCache(const std::string& model_file, const std::string& cache_directory);
+	~RobotModelCache() = default;
+
+	/**
+	 * @brief Try to load the model from the cache.
+	 * @param mb [out] The multibody.
+	 * @param name [out] The robot name.
+	 * @param limits [out] The joint limits.
+	 * @return True if a valid cache has been found and loaded, false otherwise (outputs are left untouched).
+	 */
+	bool load(rbd::MultiBody& mb, std::string& name, JointLimits& limits) const;
+
+	/**
+	 * @brief Write the model to the cache.
+	 * @param mb The multibody.
+	 * @param name The robot name.
+	 * @param limits The joint limits.
+	 * @return True on success, false otherwise.
+	 */
+	bool save(const rbd::MultiBody& mb, const std::string& name, const JointLimits& limits) const;
+
+	/**
+	 * @brief The path of the cache file associated with the model.
+	 * @return The path.
+	 */
+	const std::string& path() const;
+
+private:
+	static uint64_t hashFile(const std::string& file);
+
+	std::string cache_directory_;
+	std::string cache_file_;
+	uint64_t source_hash_;
+};
+
+} // namespace phri
@@ -0,0 +1,158 @@
+/*      File: state_snapshot.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/state_snapshot.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+using namespace phri;
+
+namespace {
+
+constexpr char snapshot_magic[8] = {'O', 'P', 'H', 'R', 'I', 'S', 'N', 'P'};
+constexpr uint32_t snapshot_version = 1;
+
+uint64_t hashData(const std::vector<char>& data) {
+	// 64-bit FNV-1a
+	constexpr uint64_t fnv_offset_basis = 0xcbf29ce484222325ULL;
+	constexpr uint64_t fnv_prime = 0x100000001b3ULL;
+
+	uint64_t hash = fnv_offset_basis;
+	for(auto c: data) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= fnv_prime;
+	}
+	return hash;
+}
+
+}
+
+/***			StateWriter			***/
+
+void StateWriter::writeBlock(const std::function<void(StateWriter&)>& content) {
+	const size_t size_offset = buffer_.size();
+	write<uint64_t>(0);
+	content(*this);
+	uint64_t size = buffer_.size() - size_offset - sizeof(uint64_t);
+	std::memcpy(buffer_.data() + size_offset, &size, sizeof(size));
+}
+
+/***			StateReader			***/
+
+void StateReader::readBlock(const std::function<void(StateReader&)>& content) {
+	auto size = read<uint64_t>();
+	StateReader block(take(size), size);
+	content(block);
+	if(block.remaining() != 0) {
+		throw std::length_error(OPEN_PHRI_ERROR("The stored state is larger than the state of the object being restored"));
+	}
+}
+
+void StateReader::skipBlock() {
+	take(read<uint64_t>());
+}
+
+/***			StateSnapshot			***/
+
+StateWriter StateSnapshot::writer() {
+	data_.clear();
+	return StateWriter(data_);
+}
+
+StateReader StateSnapshot::reader() const {
+	return StateReader(data_.data(), data_.size());
+}
+
+bool StateSnapshot::save(const std::string& file) const {
+	auto tmp_file_name = file + ".tmp";
+	{
+		std::ofstream stream(tmp_file_name, std::ios::binary | std::ios::trunc);
+		if(not stream.is_open()) {
+			return false;
+		}
+
+		std::vector<char> header;
+		StateWriter writer(header);
+		for(auto c: snapshot_magic) {
+			writer.write(c);
+		}
+		writer.write(snapshot_version);
+		writer.write<uint32_t>(0);
+		writer.write<uint64_t>(data_.size());
+		writer.write(hashData(data_));
+
+		stream.write(header.data(), header.size());
+		stream.write(data_.data(), data_.size());
+		if(not stream) {
+			std::remove(tmp_file_name.c_str());
+			return false;
+		}
+	}
+	return std::rename(tmp_file_name.c_str(), file.c_str()) == 0;
+}
+
+bool StateSnapshot::load(const std::string& file) {
+	std::ifstream stream(file, std::ios::binary);
+	if(not stream.is_open()) {
+		return false;
+	}
+
+	constexpr size_t header_size = sizeof(snapshot_magic) + 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+	char header[header_size];
+	stream.read(header, header_size);
+	if(not stream) {
+		return false;
+	}
+
+	StateReader reader(header, header_size);
+	for(auto c: snapshot_magic) {
+		if(reader.read<char>() != c) {
+			return false;
+		}
+	}
+	if(reader.read<uint32_t>() != snapshot_version) {
+		return false;
+	}
+	reader.read<uint32_t>();
+	auto size = reader.read<uint64_t>();
+	auto hash = reader.read<uint64_t>();
+
+	// Check the size against the file size before allocating, in case the file is corrupted
+	auto data_start = stream.tellg();
+	stream.seekg(0, std::ios::end);
+	if(static_cast<uint64_t>(stream.tellg() - data_start) != size) {
+		return false;
+	}
+	stream.seekg(data_start);
+
+	std::vector<char> data(size);
+	stream.read(data.data(), size);
+	if(not stream or hashData(data) != hash) {
+		return false;
+	}
+
+	data_ = std::move(data);
+	return true;
+}
+
+const std::vector<char>& StateSnapshot::data() const {
+	return data_;
+}
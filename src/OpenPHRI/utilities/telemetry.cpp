@@ -0,0 +1,373 @@
+/*      File: telemetry.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/telemetry.h>
+#include <OpenPHRI/safety_controller.h>
+#include <OpenPHRI/utilities/exceptions.h>
+#include <OpenPHRI/constraints/constraint.h>
+#include <OpenPHRI/force_generators/force_generator.h>
+#include <OpenPHRI/torque_generators/torque_generator.h>
+#include <OpenPHRI/velocity_generators/velocity_generator.h>
+#include <OpenPHRI/joint_velocity_generators/joint_velocity_generator.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+using namespace phri;
+
+namespace {
+
+template<typename T>
+const double* valueData(const T& value) {
+	return value.data();
+}
+
+const double* valueData(const double& value) {
+	return &value;
+}
+
+template<typename T>
+size_t valueSize(const T& value) {
+	return value.size();
+}
+
+size_t valueSize(const double& value) {
+	return 1;
+}
+
+size_t valueSize(const Twist& value) {
+	return 6;
+}
+
+template<typename ItT, typename ChannelT>
+void addControllerChannels(ItT begin, ItT end, std::vector<ChannelT>& channels) {
+	for(auto it=begin; it!=end; ++it) {
+		const auto& value = it->second.last_value;
+		channels.push_back({it->first, valueData(value), valueSize(value)});
+	}
+}
+
+}
+
+/***			TelemetryPublisher			***/
+
+TelemetryPublisher::TelemetryPublisher(const std::string& name, doubleConstPtr time) :
+	name_(name),
+	time_(time),
+	controller_(nullptr),
+	controller_items_(0),
+	controller_version_(0),
+	header_(nullptr),
+	data_(nullptr),
+	segment_size_(0),
+	publish_count_(0)
+{
+	if(name_.empty() or name_[0] != '/') {
+		name_.insert(name_.begin(), '/');
+	}
+}
+
+TelemetryPublisher::~TelemetryPublisher() {
+	if(header_ != nullptr) {
+		munmap(header_, segment_size_);
+		shm_unlink(name_.c_str());
+	}
+}
+
+void TelemetryPublisher::publishSafetyControllerData(SafetyController* controller) {
+	controller_ = controller;
+}
+
+void TelemetryPublisher::publishRobotData(RobotConstPtr robot) {
+	size_t joint_vec_size = robot->jointCount();
+
+	publishExternalData("jointVelocity", robot->jointVelocity()->data(), joint_vec_size);
+	publishExternalData("jointVelocityCommand", robot->jointVelocityCommand()->data(), joint_vec_size);
+	publishExternalData("jointTotalVelocity", robot->jointTotalVelocity()->data(), joint_vec_size);
+	publishExternalData("jointTotalTorque", robot->jointTotalTorque()->data(), joint_vec_size);
+	publishExternalData("jointCurrentPosition", robot->jointCurrentPosition()->data(), joint_vec_size);
+	publishExternalData("jointTargetPosition", robot->jointTargetPosition()->data(), joint_vec_size);
+	publishExternalData("jointExternalTorque", robot->jointExternalTorque()->data(), joint_vec_size);
+
+	publishExternalData("controlPointVelocity", robot->controlPointVelocity()->data(), 6);
+	publishExternalData("controlPointVelocityCommand", robot->controlPointVelocityCommand()->data(), 6);
+	publishExternalData("controlPointTotalVelocity", robot->controlPointTotalVelocity()->data(), 6);
+	publishExternalData("controlPointTotalForce", robot->controlPointTotalForce()->data(), 6);
+	publishExternalData("controlPointCurrentPosition", robot->controlPointCurrentPose()->translation().data(), 3);
+	publishExternalData("controlPointCurrentOrientation", robot->controlPointCurrentPose()->orientation().coeffs().data(), 4);
+	publishExternalData("controlPointTargetPosition", robot->controlPointTargetPose()->translation().data(), 3);
+	publishExternalData("controlPointTargetOrientation", robot->controlPointTargetPose()->orientation().coeffs().data(), 4);
+	publishExternalData("controlPointCurrentVelocity", robot->controlPointCurrentVelocity()->data(), 6);
+	publishExternalData("controlPointExternalForce", robot->controlPointExternalForce()->data(), 6);
+
+	publishExternalData("scalingFactor", robot->scalingFactor().get(), 1);
+
+	robot_ = robot;
+}
+
+void TelemetryPublisher::publishExternalData(const std::string& name, const double* data, size_t size) {
+	if(header_ != nullptr) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Data can't be added once the telemetry segment has been created"));
+	}
+	if(name.size() >= sizeof(TelemetrySignalDescriptor::name)) {
+		throw std::length_error(OPEN_PHRI_ERROR("The telemetry signal name '" + name + "' is too long"));
+	}
+	external_channels_.push_back({name, data, size});
+}
+
+void TelemetryPublisher::publish() {
+	if(header_ == nullptr) {
+		collectChannels();
+		createSegment();
+	}
+	// The stored pointers would be dangling if items were removed from the controller or if it was reconfigured
+	else if(controllerItemCount() != controller_items_ or (controller_ != nullptr and controller_->configurationVersion() != controller_version_)) {
+		updateChannels();
+	}
+
+	// Only the control thread writes the sequence so a relaxed load is enough
+	auto sequence = header_->sequence.load(std::memory_order_relaxed);
+	header_->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	double* row = data_;
+	*row++ = *time_;
+	for(const auto& channel: channels_) {
+		row = std::copy_n(channel.data, channel.size, row);
+	}
+
+	header_->sequence.store(sequence + 2, std::memory_order_release);
+	++publish_count_;
+}
+
+const std::vector<TelemetrySignal>& TelemetryPublisher::signals() const {
+	return signals_;
+}
+
+uint64_t TelemetryPublisher::publishCount() const {
+	return publish_count_;
+}
+
+void TelemetryPublisher::collectChannels() {
+	channels_.clear();
+	if(controller_ != nullptr) {
+		addControllerChannels(controller_->constraints_begin(), controller_->constraints_end(), channels_);
+		addControllerChannels(controller_->force_generators_begin(), controller_->force_generators_end(), channels_);
+		addControllerChannels(controller_->torque_generators_begin(), controller_->torque_generators_end(), channels_);
+		addControllerChannels(controller_->velocity_generators_begin(), controller_->velocity_generators_end(), channels_);
+		addControllerChannels(controller_->joint_velocity_generators_begin(), controller_->joint_velocity_generators_end(), channels_);
+	}
+	controller_items_ = controllerItemCount();
+	controller_version_ = controller_ != nullptr ? controller_->configurationVersion() : 0;
+	channels_.insert(channels_.end(), external_channels_.begin(), external_channels_.end());
+}
+
+void TelemetryPublisher::updateChannels() {
+	collectChannels();
+
+	// Keep the segment if the layout is the same, only the data pointers have changed
+	bool same_layout = channels_.size() == signals_.size();
+	for (size_t i = 0; same_layout and i < channels_.size(); ++i) {
+		same_layout = channels_[i].name.substr(0, sizeof(TelemetrySignalDescriptor::name) - 1) == signals_[i].name and channels_[i].size == signals_[i].size;
+	}
+	if(same_layout) {
+		return;
+	}
+
+	// Tell the current readers to reopen the segment before it is unlinked and replaced
+	header_->replaced.store(1, std::memory_order_release);
+	munmap(header_, segment_size_);
+	header_ = nullptr;
+	createSegment();
+}
+
+void TelemetryPublisher::createSegment() {
+	signals_.clear();
+	size_t row_size = 1;
+	for(const auto& channel: channels_) {
+		signals_.push_back({channel.name.substr(0, sizeof(TelemetrySignalDescriptor::name) - 1), row_size, channel.size});
+		row_size += channel.size;
+	}
+
+	const size_t data_offset = sizeof(TelemetryHeader) + signals_.size() * sizeof(TelemetrySignalDescriptor);
+	segment_size_ = data_offset + row_size * sizeof(double);
+
+	// Remove a segment left by a crashed process so that its readers don't get a mix of the two layouts
+	shm_unlink(name_.c_str());
+	int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+	if(fd < 0) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Unable to create the shared memory segment " + name_ + ": " + std::string(std::strerror(errno))));
+	}
+	if(ftruncate(fd, segment_size_) != 0) {
+		close(fd);
+		shm_unlink(name_.c_str());
+		throw std::runtime_error(OPEN_PHRI_ERROR("Unable to resize the shared memory segment " + name_ + ": " + std::string(std::strerror(errno))));
+	}
+	void* segment = mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if(segment == MAP_FAILED) {
+		shm_unlink(name_.c_str());
+		throw std::runtime_error(OPEN_PHRI_ERROR("Unable to map the shared memory segment " + name_ + ": " + std::string(std::strerror(errno))));
+	}
+
+	// The segment is zero-filled so the magic is written last, once the layout is complete
+	header_ = new (segment) TelemetryHeader;
+	header_->version = telemetry_version;
+	header_->signal_count = signals_.size();
+	header_->row_size = row_size;
+	header_->data_offset = data_offset;
+	header_->sequence.store(0, std::memory_order_relaxed);
+	header_->replaced.store(0, std::memory_order_relaxed);
+
+	auto descriptors = reinterpret_cast<TelemetrySignalDescriptor*>(static_cast<char*>(segment) + sizeof(TelemetryHeader));
+	for (size_t i = 0; i < signals_.size(); ++i) {
+		std::strncpy(descriptors[i].name, signals_[i].name.c_str(), sizeof(descriptors[i].name));
+		descriptors[i].offset = signals_[i].offset;
+		descriptors[i].size = signals_[i].size;
+	}
+	data_ = reinterpret_cast<double*>(static_cast<char*>(segment) + data_offset);
+
+	std::atomic_thread_fence(std::memory_order_release);
+	std::memcpy(header_->magic, telemetry_magic, sizeof(telemetry_magic));
+}
+
+size_t TelemetryPublisher::controllerItemCount() const {
+	if(controller_ == nullptr) {
+		return 0;
+	}
+	return
+		std::distance(controller_->constraints_begin(), controller_->constraints_end()) +
+		std::distance(controller_->force_generators_begin(), controller_->force_generators_end()) +
+		std::distance(controller_->torque_generators_begin(), controller_->torque_generators_end()) +
+		std::distance(controller_->velocity_generators_begin(), controller_->velocity_generators_end()) +
+		std::distance(controller_->joint_velocity_generators_begin(), controller_->joint_velocity_generators_end());
+}
+
+/***			TelemetryReader			***/
+
+TelemetryReader::TelemetryReader(const std::string& name) :
+	header_(nullptr),
+	data_(nullptr),
+	segment_size_(0),
+	row_size_(0)
+{
+	auto segment_name = name;
+	if(segment_name.empty() or segment_name[0] != '/') {
+		segment_name.insert(segment_name.begin(), '/');
+	}
+
+	int fd = shm_open(segment_name.c_str(), O_RDONLY, 0);
+	if(fd < 0) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Unable to open the shared memory segment " + segment_name + ": " + std::string(std::strerror(errno))));
+	}
+	struct stat segment_stat;
+	fstat(fd, &segment_stat);
+	segment_size_ = segment_stat.st_size;
+	if(segment_size_ < sizeof(TelemetryHeader)) {
+		close(fd);
+		throw std::invalid_argument(OPEN_PHRI_ERROR(segment_name + " is not a telemetry segment or is not initialized yet"));
+	}
+
+	void* segment = mmap(nullptr, segment_size_, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if(segment == MAP_FAILED) {
+		throw std::runtime_error(OPEN_PHRI_ERROR("Unable to map the shared memory segment " + segment_name + ": " + std::string(std::strerror(errno))));
+	}
+	header_ = static_cast<const TelemetryHeader*>(segment);
+
+	bool valid = std::equal(telemetry_magic, telemetry_magic + sizeof(telemetry_magic), header_->magic);
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const size_t descriptors_end = sizeof(TelemetryHeader) + header_->signal_count * sizeof(TelemetrySignalDescriptor);
+	valid = valid and header_->version == telemetry_version and
+		descriptors_end <= header_->data_offset and header_->data_offset + header_->row_size * sizeof(double) <= segment_size_;
+	if(not valid) {
+		munmap(const_cast<TelemetryHeader*>(header_), segment_size_);
+		throw std::invalid_argument(OPEN_PHRI_ERROR(segment_name + " is not a telemetry segment, is not initialized yet or has an unsupported version"));
+	}
+
+	row_size_ = header_->row_size;
+	auto descriptors = reinterpret_cast<const TelemetrySignalDescriptor*>(reinterpret_cast<const char*>(header_) + sizeof(TelemetryHeader));
+	for (size_t i = 0; i < header_->signal_count; ++i) {
+		const auto& descriptor = descriptors[i];
+		if(descriptor.offset + descriptor.size > row_size_) {
+			break;
+		}
+		signals_.push_back({std::string(descriptor.name, strnlen(descriptor.name, sizeof(descriptor.name))), descriptor.offset, descriptor.size});
+	}
+	data_ = reinterpret_cast<const double*>(reinterpret_cast<const char*>(header_) + header_->data_offset);
+}
+
+TelemetryReader::~TelemetryReader() {
+	munmap(const_cast<TelemetryHeader*>(header_), segment_size_);
+}
+
+const std::vector<TelemetrySignal>& TelemetryReader::signals() const {
+	return signals_;
+}
+
+int TelemetryReader::signalIndex(const std::string& name) const {
+	for (size_t i = 0; i < signals_.size(); ++i) {
+		if(signals_[i].name == name) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+size_t TelemetryReader::rowSize() const {
+	return row_size_;
+}
+
+uint64_t TelemetryReader::read(std::vector<double>& row, double timeout) const {
+	row.resize(row_size_);
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
+	while(true) {
+		auto sequence = header_->sequence.load(std::memory_order_acquire);
+		if(sequence & 1) {
+			// A publisher that died while writing leaves the sequence odd forever
+			if(std::chrono::steady_clock::now() > deadline) {
+				throw std::runtime_error(OPEN_PHRI_ERROR("The telemetry publisher has been writing for more than " + std::to_string(timeout) + "s, it may have stopped"));
+			}
+			std::this_thread::yield();
+			continue;
+		}
+		std::memcpy(row.data(), data_, row_size_ * sizeof(double));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if(header_->sequence.load(std::memory_order_relaxed) == sequence) {
+			return sequence / 2;
+		}
+	}
+}
+
+Eigen::Map<const VectorXd> TelemetryReader::signal(const std::vector<double>& row, size_t signal) const {
+	const auto& info = signals_.at(signal);
+	return Eigen::Map<const VectorXd>(row.data() + info.offset, info.size);
+}
+
+bool TelemetryReader::isReplaced() const {
+	return header_->replaced.load(std::memory_order_acquire) != 0;
+}
@@ -0,0 +1,103 @@
+/*      File: uniform_grid.cpp
+*       This file is part of the program open-phri
+*       Program description : OpenPHRI: a generic framework to easily and safely control robots in interactions with humans
+*       Copyright (C) 2017 -  Benjamin Navarro (LIRMM). All Right reserved.
+*
+*       This software is free software: you can redistribute it and/or modify
+*       it under the terms of the LGPL license as published by
+*       the Free Software Foundation, either version 3
+*       of the License, or (at your option) any later version.
+*       This software is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*       LGPL License for more details.
+*
+*       You should have received a copy of the GNU Lesser General Public License version 3 and the
+*       General Public License version 3 along with this program.
+*       If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <OpenPHRI/utilities/uniform_grid.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace phri;
+
+UniformGrid::UniformGrid() :
+	cell_size_(1.),
+	bucket_mask_(0)
+{
+}
+
+void UniformGrid::build(const double* x, const double* y, const double* z, size_t count, double cell_size) {
+	assert(cell_size > 0. and std::isfinite(cell_size));
+	cell_size_ = cell_size;
+
+	// Power of two number of buckets, at least twice the number of points to limit the collisions
+	size_t bucket_count = 64;
+	while(bucket_count < 2*count) {
+		bucket_count *= 2;
+	}
+	bucket_mask_ = bucket_count - 1;
+
+	// Counting sort of the points by bucket
+	bucket_start_.assign(bucket_count + 1, 0);
+	object_buckets_.resize(count);
+	bucket_objects_.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		object_buckets_[i] = bucket(cellCoordinate(x[i]), cellCoordinate(y[i]), cellCoordinate(z[i]));
+		++bucket_start_[object_buckets_[i] + 1];
+	}
+	for (size_t i = 0; i < bucket_count; ++i) {
+		bucket_start_[i + 1] += bucket_start_[i];
+	}
+	for (size_t i = 0; i < count; ++i) {
+		// bucket_start_[b] is used as the insertion position and then restored below
+		bucket_objects_[bucket_start_[object_buckets_[i]]++] = i;
+	}
+	for (size_t i = bucket_count; i > 0; --i) {
+		bucket_start_[i] = bucket_start_[i - 1];
+	}
+	bucket_start_[0] = 0;
+}
+
+double UniformGrid::cellSize() const {
+	return cell_size_;
+}
+
+size_t UniformGrid::size() const {
+	return bucket_objects_.size();
+}
+
+int64_t UniformGrid::cellCoordinate(double value) const {
+	// Clamped to stay representable, far away points just end up in the same border cells
+	constexpr double max_coordinate = 1e15;
+	return static_cast<int64_t>(std::floor(std::max(-max_coordinate, std::min(max_coordinate, value / cell_size_))));
+}
+
+size_t UniformGrid::bucket(int64_t cx, int64_t cy, int64_t cz) const {
+	auto hash =
+		static_cast<uint64_t>(cx) * 73856093ULL ^
+		static_cast<uint64_t>(cy) * 19349663ULL ^
+		static_cast<uint64_t>(cz) * 83492791ULL;
+	return hash & bucket_mask_;
+}
+
+size_t UniformGrid::neighborBuckets(double x, double y, double z, std::array<size_t, 27>& buckets) const {
+	auto cx = cellCoordinate(x);
+	auto cy = cellCoordinate(y);
+	auto cz = cellCoordinate(z);
+	size_t count = 0;
+	for (int64_t i = -1; i <= 1; ++i) {
+		for (int64_t j = -1; j <= 1; ++j) {
+			for (int64_t k = -1; k <= 1; ++k) {
+				buckets[count++] = bucket(cx + i, cy + j, cz + k);
+			}
+		}
+	}
+	// Several cells can share a bucket, visit it only once
+	std::sort(buckets.begin(), buckets.end());
+	return std::unique(buckets.begin(), buckets.end()) - buckets.begin();
+}
@@ -18,6 +18,7 @@
 */
 
 #include <OpenPHRI/velocity_generators/force_control.h>
+#include <OpenPHRI/utilities/state_snapshot.h>
 #include <iostream>
 
 using namespace phri;
@@ -88,3 +89,11 @@ void ForceControl::applySelection(Vector6d& vec) const {
 		}
 	}
 }
+
+void ForceControl::saveState(StateWriter& writer) const {
+	writer.writeMatrix(prev_error_);
+}
+
+void ForceControl::restoreState(StateReader& reader) {
+	reader.readMatrix(prev_error_);
+}
@@ -41,3 +41,9 @@ Twist VelocityGenerator::transform(const Twist& velocity) {
 Twist VelocityGenerator::operator()() {
 	return compute();
 }
+
+void VelocityGenerator::saveState(StateWriter& writer) const {
+}
+
+void VelocityGenerator::restoreState(StateReader& reader) {
+}
@@ -23,6 +23,7 @@
 #include <yaml-cpp/yaml.h>
 
 #include <stdexcept>
+#include <cstring>
 #include <sstream>
 #include <iostream>
 #include <vector>
@@ -47,6 +48,8 @@ VREPDriver::VREPDriver(
 	phri::Driver(robot,
 	             sample_time),
 	sync_mode_(true),
+	packed_joint_data_(false),
+	read_kinematics_(false),
 	suffix_(suffix)
 {
 	sample_time_ = sample_time;
@@ -60,6 +63,8 @@ VREPDriver::VREPDriver(
 	const std::string& suffix) :
 	phri::Driver(robot, sample_time),
 	sync_mode_(true),
+	packed_joint_data_(false),
+	read_kinematics_(false),
 	suffix_(suffix)
 {
 	init(client_id);
@@ -81,6 +86,8 @@ VREPDriver::VREPDriver(
 		}
 		suffix_ = vrep["suffix"].as<std::string>("");
 		sync_mode_ = vrep["synchronous"].as<bool>(true);
+		packed_joint_data_ = vrep["packed_joint_data"].as<bool>(false);
+		read_kinematics_ = vrep["read_kinematics"].as<bool>(false);
 		auto mode = vrep["mode"].as<std::string>("TCP");
 		if(mode == "TCP") {
 			std::string ip = vrep["ip"].as<std::string>("127.0.0.1");
@@ -132,6 +139,17 @@ void VREPDriver::init(int client_id) {
 	assert_msg("In VREPDriver::init: invalid client id", client_id >= 0);
 	client_id_ = client_id;
 
+	jacobian_signal_ = "JacobianData-" + robot_->name();
+	jacobian_text_signal_ = "Jacobian-" + robot_->name();
+	transformation_signal_ = "RotMatData-" + robot_->name();
+	transformation_text_signal_ = "RotMat-" + robot_->name();
+	packed_state_signal_ = "JointState-" + robot_->name() + suffix_;
+	packed_command_signal_ = "JointTargetPositions-" + robot_->name() + suffix_;
+	// joint positions + TCP twist + TCP wrench + wrench validity
+	packed_state_.resize(robot_->jointCount() + 13);
+	packed_command_.resize(robot_->jointCount());
+	joint_data_.resize(robot_->jointCount());
+
 	getObjectHandles();
 	startStreaming();
 }
@@ -185,7 +203,7 @@ bool VREPDriver::readTCPPose(phri::PosePtr pose, phri::ReferenceFrame frame) con
 	bool all_ok = true;
 	float data[6];
 
-	int object_handle = object_handles_.at(robot_->name() + "_tcp" + suffix_);
+	int object_handle = tcp_handle_;
 	int frame_id = getFrameHandle(frame);
 	all_ok &= (simxGetObjectPosition    (client_id_, object_handle, frame_id, data,    simx_opmode_buffer) == simx_return_ok);
 	all_ok &= (simxGetObjectOrientation (client_id_, object_handle, frame_id, data+3,  simx_opmode_buffer) == simx_return_ok);
@@ -207,7 +225,7 @@ bool VREPDriver::readTCPVelocity(phri::TwistPtr velocity, phri::ReferenceFrame f
 	bool all_ok = true;
 	float data[6], angles[3];
 
-	int object_handle = object_handles_.at(robot_->name() + "_tcp" + suffix_);
+	int object_handle = tcp_handle_;
 	int frame_id = getFrameHandle(frame);
 	all_ok &= (simxGetObjectOrientation (client_id_, frame_id, -1, angles,  simx_opmode_buffer) == simx_return_ok);
 	all_ok &= (simxGetObjectVelocity(client_id_, object_handle, data, data+3, simx_opmode_buffer) == simx_return_ok);
@@ -235,9 +253,8 @@ bool VREPDriver::readTCPWrench(phri::Vector6dPtr wrench) const {
 	bool all_ok = true;
 	float data[6];
 	uint8_t ft_state;
-	string obj_name = robot_->name() + "_force_sensor" + suffix_;
 
-	all_ok &= (simxReadForceSensor(client_id_, object_handles_.at(obj_name), &ft_state, data, data+3, simx_opmode_buffer) == simx_return_ok);
+	all_ok &= (simxReadForceSensor(client_id_, force_sensor_handle_, &ft_state, data, data+3, simx_opmode_buffer) == simx_return_ok);
 	all_ok &= ft_state == 0b01; // ft not broken + data available
 
 	if(all_ok) {
@@ -255,7 +272,20 @@ bool VREPDriver::readJacobian(phri::MatrixXdPtr jacobian) const {
 
 	simxUChar* jacobian_buf;
 	simxInt sLength;
-	int ret = simxReadStringStream(client_id_, ("Jacobian-"+robot_->name()).c_str(), &jacobian_buf, &sLength, simx_opmode_buffer);
+	if(simxReadStringStream(client_id_, jacobian_signal_.c_str(), &jacobian_buf, &sLength, simx_opmode_buffer) == simx_return_ok and static_cast<size_t>(sLength) >= 2*sizeof(int32_t)) {
+		int32_t size[2];
+		std::memcpy(size, jacobian_buf, sizeof(size));
+		const int32_t rows = size[0], cols = size[1];
+		if(rows > 0 and cols > 0 and static_cast<size_t>(sLength) == sizeof(size) + rows*cols*sizeof(float)) {
+			// Jacobians in V-REP are row major, transposed compared to the standard form and with joints in the tip-to-base order.
+			// Mapping the row major data as a column major matrix gives the transpose for free, the reverse fixes the joints order
+			Eigen::Map<const Eigen::MatrixXf> jac(reinterpret_cast<const float*>(jacobian_buf + sizeof(size)), cols, rows);
+			*jacobian = jac.rowwise().reverse().cast<double>();
+			return true;
+		}
+	}
+
+	int ret = simxReadStringStream(client_id_, jacobian_text_signal_.c_str(), &jacobian_buf, &sLength, simx_opmode_buffer);
 	if (ret == simx_return_ok) {
 		if(sLength == 0) {
 			return false;
@@ -289,11 +319,17 @@ bool VREPDriver::readTransformationMatrix(phri::Matrix4dPtr matrix) const {
 
 	simxUChar* matrix_buf;
 	simxInt sLength;
-	if (simxReadStringStream(client_id_, ("RotMat-"+robot_->name()).c_str(), &matrix_buf, &sLength, simx_opmode_buffer) == simx_return_ok) {
+	auto& mat = *matrix;
+	if(simxReadStringStream(client_id_, transformation_signal_.c_str(), &matrix_buf, &sLength, simx_opmode_buffer) == simx_return_ok and static_cast<size_t>(sLength) == 12*sizeof(float)) {
+		mat.block<3,4>(0,0) = Eigen::Map<const Eigen::Matrix<float,3,4,Eigen::RowMajor>>(reinterpret_cast<const float*>(matrix_buf)).cast<double>();
+		mat.row(3) << 0., 0., 0., 1.;
+		return true;
+	}
+
+	if (simxReadStringStream(client_id_, transformation_text_signal_.c_str(), &matrix_buf, &sLength, simx_opmode_buffer) == simx_return_ok) {
 		std::string matrix_str = std::string((char*)(matrix_buf));
 		std::istringstream iss(matrix_str);
 
-		auto& mat = *matrix;
 		mat.setIdentity();
 		for (size_t row = 0; row < 3; ++row) {
 			for (size_t col = 0; col < 4; ++col) {
@@ -384,18 +420,22 @@ bool VREPDriver::updateLaserScanners() {
 	return all_ok;
 }
 
+void VREPDriver::enablePackedJointData(bool state) {
+	packed_joint_data_ = state;
+}
+
+void VREPDriver::enableKinematicsReading(bool state) {
+	read_kinematics_ = state;
+}
+
 bool VREPDriver::readJointPosition(phri::VectorXdPtr position) const {
 	bool all_ok = true;
 
-	float positions[robot_->jointCount()];
-
-	for (size_t i = 0; i < robot_->jointCount(); ++i) {
-		int joint_handle = object_handles_.at(robot_->name() + "_joint" + std::to_string(i+1) + suffix_);
-		all_ok &= (simxGetJointPosition(client_id_, joint_handle, positions+i, simx_opmode_buffer) != -1);
+	for (size_t i = 0; i < joint_handles_.size(); ++i) {
+		all_ok &= (simxGetJointPosition(client_id_, joint_handles_[i], joint_data_.data()+i, simx_opmode_buffer) != -1);
 	}
-	double* position_data = position->data();
-	for (size_t i = 0; all_ok and i < robot_->jointCount(); ++i) {
-		position_data[i] = positions[i];
+	if(all_ok) {
+		*position = Eigen::Map<const Eigen::VectorXf>(joint_data_.data(), joint_data_.size()).cast<double>();
 	}
 
 	return all_ok;
@@ -405,14 +445,49 @@ bool VREPDriver::sendJointTargetPosition(phri::VectorXdConstPtr position) const
 	bool all_ok = true;
 
 	const auto& position_data = *position;
-	for (size_t i = 0; i < robot_->jointCount(); ++i) {
-		int joint_handle = object_handles_.at(robot_->name() + "_joint" + std::to_string(i+1) + suffix_);
-		all_ok &= (simxSetJointTargetPosition(client_id_, joint_handle, position_data(i), simx_opmode_oneshot) != -1);
+	for (size_t i = 0; i < joint_handles_.size(); ++i) {
+		all_ok &= (simxSetJointTargetPosition(client_id_, joint_handles_[i], position_data(i), simx_opmode_oneshot) != -1);
 	}
 
 	return all_ok;
 }
 
+bool VREPDriver::readPackedState() {
+	simxUChar* state_buf;
+	simxInt sLength;
+	if(simxReadStringStream(client_id_, packed_state_signal_.c_str(), &state_buf, &sLength, simx_opmode_buffer) != simx_return_ok) {
+		return false;
+	}
+
+	// The stream can contain several states if the simulation ran faster than us, the last one is the most recent
+	const size_t state_size = packed_state_.size() * sizeof(float);
+	const size_t stream_size = sLength;
+	if(stream_size < state_size or stream_size % state_size != 0) {
+		return false;
+	}
+	std::memcpy(packed_state_.data(), state_buf + stream_size - state_size, state_size);
+
+	const size_t joint_count = robot_->jointCount();
+	*robot_->jointCurrentPosition() = Eigen::Map<const Eigen::VectorXf>(packed_state_.data(), joint_count).cast<double>();
+	static_cast<phri::Vector6d&>(*robot_->controlPointCurrentVelocity()) = Eigen::Map<const Eigen::Matrix<float,6,1>>(packed_state_.data() + joint_count).cast<double>();
+	bool wrench_ok = packed_state_[joint_count + 12] > 0.f;
+	if(wrench_ok) {
+		*robot_->controlPointExternalForce() = Eigen::Map<const Eigen::Matrix<float,6,1>>(packed_state_.data() + joint_count + 6).cast<double>();
+	}
+
+	return wrench_ok;
+}
+
+bool VREPDriver::sendPackedJointTargetPosition() {
+	Eigen::Map<Eigen::VectorXf>(packed_command_.data(), packed_command_.size()) = robot_->jointTargetPosition()->cast<float>();
+	return simxWriteStringStream(
+		client_id_,
+		packed_command_signal_.c_str(),
+		reinterpret_cast<const simxUChar*>(packed_command_.data()),
+		packed_command_.size() * sizeof(float),
+		simx_opmode_oneshot) != -1;
+}
+
 bool VREPDriver::sendJointTargetVelocity(phri::VectorXdConstPtr velocity) const {
 	bool all_ok = true;
 
@@ -430,22 +505,23 @@ bool VREPDriver::getObjectHandles() {
 	bool all_ok = true;
 
 	auto getHandle =
-		[this](const std::string& name) -> bool {
+		[this](const std::string& name, int& handle) -> bool {
 			string obj_name = robot_->name() + "_" + name + suffix_;
-			bool ok = simxGetObjectHandle(client_id_, obj_name.c_str(), &object_handles_[obj_name], simx_opmode_oneshot_wait) == simx_return_ok;
+			bool ok = simxGetObjectHandle(client_id_, obj_name.c_str(), &handle, simx_opmode_oneshot_wait) == simx_return_ok;
 			if(not ok) {
 				throw std::runtime_error(OPEN_PHRI_ERROR("Can't get the handle of object " + obj_name));
 			}
 			return ok;
 		};
 
-	all_ok &= getHandle("tcp");
-	all_ok &= getHandle("base_frame");
-	all_ok &= getHandle("world_frame");
-	all_ok &= getHandle("force_sensor");
+	all_ok &= getHandle("tcp", tcp_handle_);
+	all_ok &= getHandle("base_frame", base_frame_handle_);
+	all_ok &= getHandle("world_frame", world_frame_handle_);
+	all_ok &= getHandle("force_sensor", force_sensor_handle_);
 
-	for (size_t i = 1; i <= robot_->jointCount(); ++i) {
-		all_ok &= getHandle("joint" + std::to_string(i));
+	joint_handles_.resize(robot_->jointCount());
+	for (size_t i = 0; i < robot_->jointCount(); ++i) {
+		all_ok &= getHandle("joint" + std::to_string(i+1), joint_handles_[i]);
 	}
 
 	return all_ok;
@@ -455,10 +531,9 @@ void VREPDriver::startStreaming() const {
 	float data[6];
 
 	phri::ReferenceFrame frames[] = {phri::ReferenceFrame::TCP, phri::ReferenceFrame::Base, phri::ReferenceFrame::World};
-	string objects[] = {"_tcp"};
+	int objects[] = {tcp_handle_};
 
-	for(auto& object : objects) {
-		int obj_handle = object_handles_.at(robot_->name() + object + suffix_);
+	for(auto obj_handle : objects) {
 		for(auto frame : frames) {
 			int frame_id = getFrameHandle(frame);
 			simxGetObjectPosition    (client_id_, obj_handle, frame_id, data,    simx_opmode_streaming);
@@ -472,31 +547,32 @@ void VREPDriver::startStreaming() const {
 		simxGetObjectOrientation (client_id_, frame_id, -1, data,  simx_opmode_streaming);
 	}
 
-	for (size_t i = 1; i <= robot_->jointCount(); ++i) {
-		int joint_handle = object_handles_.at(robot_->name() + "_joint" + std::to_string(i) + suffix_);
+	for(auto joint_handle : joint_handles_) {
 		simxGetJointPosition(client_id_, joint_handle, data, simx_opmode_streaming);
 	}
 
 	uint8_t ft_state;
-	int obj_handle = object_handles_.at(robot_->name() + "_force_sensor" + suffix_);
-	simxReadForceSensor(client_id_, obj_handle, &ft_state, data, data+3, simx_opmode_streaming);
+	simxReadForceSensor(client_id_, force_sensor_handle_, &ft_state, data, data+3, simx_opmode_streaming);
 
 	simxUChar* jacobian_str;
 	simxInt sLength;
-	simxReadStringStream(client_id_, ("Jacobian-"+robot_->name()).c_str(), &jacobian_str, &sLength, simx_opmode_streaming);
-	simxReadStringStream(client_id_, ("RotMat-"+robot_->name()).c_str(), &jacobian_str, &sLength, simx_opmode_streaming);
+	simxReadStringStream(client_id_, jacobian_signal_.c_str(), &jacobian_str, &sLength, simx_opmode_streaming);
+	simxReadStringStream(client_id_, jacobian_text_signal_.c_str(), &jacobian_str, &sLength, simx_opmode_streaming);
+	simxReadStringStream(client_id_, transformation_signal_.c_str(), &jacobian_str, &sLength, simx_opmode_streaming);
+	simxReadStringStream(client_id_, transformation_text_signal_.c_str(), &jacobian_str, &sLength, simx_opmode_streaming);
+	simxReadStringStream(client_id_, packed_state_signal_.c_str(), &jacobian_str, &sLength, simx_opmode_streaming);
 }
 
 int VREPDriver::getFrameHandle(phri::ReferenceFrame frame) const {
 	switch(frame) {
 	case phri::ReferenceFrame::TCP:
-		return object_handles_.at(robot_->name() + "_tcp" + suffix_);
+		return tcp_handle_;
 		break;
 	case phri::ReferenceFrame::Base:
-		return object_handles_.at(robot_->name() + "_base_frame" + suffix_);
+		return base_frame_handle_;
 		break;
 	case phri::ReferenceFrame::World:
-		return object_handles_.at(robot_->name() + "_world_frame" + suffix_);
+		return world_frame_handle_;
 		break;
 	}
 	return -1;
@@ -511,9 +587,24 @@ bool VREPDriver::read() {
 		std::this_thread::sleep_for(std::chrono::milliseconds(int(sample_time_ * 1000.)));
 	}
 
-	all_ok &= readTCPVelocity(robot_->controlPointCurrentVelocity(), phri::ReferenceFrame::Base);
-	all_ok &= readTCPWrench(robot_->controlPointExternalForce());
-	all_ok &= readJointPosition(robot_->jointCurrentPosition());
+	if(packed_joint_data_) {
+		all_ok &= readPackedState();
+	}
+	else {
+		all_ok &= readTCPVelocity(robot_->controlPointCurrentVelocity(), phri::ReferenceFrame::Base);
+		all_ok &= readTCPWrench(robot_->controlPointExternalForce());
+		all_ok &= readJointPosition(robot_->jointCurrentPosition());
+	}
+	if(read_kinematics_) {
+		const auto& matrix = *robot_->transformationMatrix();
+		all_ok &= readJacobian(robot_->jacobian());
+		all_ok &= readTransformationMatrix(robot_->transformationMatrix());
+		*robot_->controlPointCurrentPose() = phri::Pose(phri::AffineTransform(matrix));
+		auto& spatial_matrix = *robot_->spatialTransformationMatrix();
+		spatial_matrix.setZero();
+		spatial_matrix.block<3,3>(0,0) = matrix.block<3,3>(0,0);
+		spatial_matrix.block<3,3>(3,3) = matrix.block<3,3>(0,0);
+	}
 	all_ok &= updateTrackedObjectsPosition();
 	all_ok &= updateLaserScanners();
 
@@ -526,13 +617,30 @@ bool VREPDriver::send() {
 	// Make sure all commands are sent at the same time
 	simxPauseCommunication(client_id_, true);
 
-	all_ok &= sendJointTargetVelocity(robot_->jointVelocity());
+	if(packed_joint_data_) {
+		*robot_->jointTargetPosition() += *robot_->jointVelocity()*sample_time_;
+		all_ok &= sendPackedJointTargetPosition();
+	}
+	else {
+		all_ok &= sendJointTargetVelocity(robot_->jointVelocity());
+	}
 
 	simxPauseCommunication(client_id_, false);
 
 	return all_ok;
 }
 
+phri::DriverCapabilities VREPDriver::capabilities() const {
+	phri::DriverCapabilities capabilities;
+	capabilities.external_force = true;
+	capabilities.control_point_velocity = true;
+	capabilities.kinematics = read_kinematics_;
+	capabilities.synchronous = sync_mode_;
+	// read() steps the simulation in synchronous mode and sleeps a sample time otherwise
+	capabilities.self_paced = true;
+	return capabilities;
+}
+
 bool VREPDriver::isRegisteredInFactory() {
 	return registered_in_factory;
 }
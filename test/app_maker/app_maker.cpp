@@ -0,0 +1,46 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+
+	AppMaker app("configuration_examples/dummy_kuka_lwr4.yaml");
+	auto clock = app.getClock();
+	const double sample_time = clock->getSampleTime();
+	const double pause = 50. * sample_time;
+
+	// Step #1 : the time spent between the construction, the initialization and the first cycle is not measured as a cycle
+	this_thread::sleep_for(chrono::duration<double>(pause));
+	assert_msg("Step #1", app.init());
+	this_thread::sleep_for(chrono::duration<double>(pause));
+	assert_msg("Step #1", app.run());
+	assert_msg("Step #1", clock->getStatistics().cycles == 1);
+	assert_msg("Step #1", clock->getStatistics().missed_cycles == 0);
+	assert_msg("Step #1", *clock->getMeasuredTime() < pause);
+	assert_msg("Step #1", std::abs(*clock->getNominalTime() - sample_time) < 1e-12);
+
+	// Step #2 : the following cycles are measured normally
+	for (size_t i = 0; i < 9; ++i) {
+		assert_msg("Step #2", app.run());
+	}
+	assert_msg("Step #2", clock->getStatistics().cycles == 10);
+	assert_msg("Step #2", clock->getStatistics().max_cycle_time < pause);
+
+	// Step #3 : a new initialization restarts the clock
+	assert_msg("Step #3", app.init());
+	this_thread::sleep_for(chrono::duration<double>(pause));
+	assert_msg("Step #3", app.run());
+	assert_msg("Step #3", clock->getStatistics().cycles == 1);
+	assert_msg("Step #3", *clock->getMeasuredTime() < pause);
+
+	// Step #4 : shutdown
+	assert_msg("Step #4", app.stop());
+
+	return 0;
+}
@@ -0,0 +1,130 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+#include <OpenPHRI/drivers/async_driver.h>
+#include <OpenPHRI/drivers/dummy_driver.h>
+
+using namespace phri;
+using namespace std;
+
+// Driver stepping in read() and integrating the commands into the target position, like VREPDriver in synchronous mode
+class SelfPacedDriver : public DummyDriver {
+public:
+	SelfPacedDriver(RobotPtr robot, double sample_time) :
+		Driver(robot, sample_time),
+		DummyDriver(robot, sample_time),
+		steps(0),
+		syncs(0)
+	{
+	}
+
+	virtual bool sync() override {
+		++syncs;
+		return DummyDriver::sync();
+	}
+
+	virtual bool read() override {
+		++steps;
+		return DummyDriver::sync();
+	}
+
+	virtual bool send() override {
+		*robot_->jointTargetPosition() += *robot_->jointVelocity() * getSampleTime();
+		return DummyDriver::send();
+	}
+
+	virtual DriverCapabilities capabilities() const override {
+		DriverCapabilities capabilities;
+		capabilities.self_paced = true;
+		return capabilities;
+	}
+
+	std::atomic<size_t> steps;
+	std::atomic<size_t> syncs;
+};
+
+int main(int argc, char const *argv[]) {
+
+	// Step #1 : queue filling and ordering
+	SPSCQueue<int> queue(2);
+	int value = 0;
+	assert_msg("Step #1", queue.empty() and not queue.pop(value));
+	assert_msg("Step #1", queue.push(1) and queue.push(2) and not queue.push(3));
+	assert_msg("Step #1", queue.pop(value) and value == 1);
+	assert_msg("Step #1", queue.push(3));
+	assert_msg("Step #1", queue.pop(value) and value == 2);
+	assert_msg("Step #1", queue.pop(value) and value == 3);
+	assert_msg("Step #1", queue.empty());
+
+	auto robot = make_shared<Robot>(
+		"rob",  // Robot's name
+		3);     // Robot's joint count
+
+	auto driver_robot = make_shared<Robot>(
+		"rob",
+		3);
+
+	constexpr double sample_time = 0.001;
+
+	auto dummy_driver = make_shared<DummyDriver>(driver_robot, sample_time);
+	AsyncDriver driver(robot, dummy_driver, driver_robot);
+
+	auto safety_controller = SafetyController(robot);
+	safety_controller.setVerbose(true);
+
+	auto constant_vel = make_shared<VectorXd>(3);
+	*constant_vel << 1., 2., 3.;
+	safety_controller.add("vel proxy", make_shared<JointVelocityProxy>(constant_vel));
+
+	// Step #2 : initialization
+	assert_msg("Step #2", driver.start());
+	assert_msg("Step #2", driver.init());
+	assert_msg("Step #2", robot->jointCurrentPosition()->isZero());
+
+	// Step #3 : the positions are updated by the dummy driver from the commands sent by the control loop
+	for (size_t i = 0; i < 50; ++i) {
+		assert_msg("Step #3", driver.read());
+		safety_controller.compute();
+		assert_msg("Step #3", driver.send());
+	}
+	const auto& joint_pos = *robot->jointCurrentPosition();
+	assert_msg("Step #3", joint_pos(0) > 0. and joint_pos(1) > joint_pos(0) and joint_pos(2) > joint_pos(1));
+	assert_msg("Step #3", driver.driverErrors() == 0);
+
+	// Step #4 : stopping the I/O thread makes read fail
+	assert_msg("Step #4", driver.stop());
+	while(driver.read()) {
+		continue;
+	}
+	assert_msg("Step #4", not driver.read());
+
+	// Step #5 : self paced drivers are stepped once per I/O cycle, by read() only
+	auto self_paced_driver = make_shared<SelfPacedDriver>(driver_robot, sample_time);
+	AsyncDriver self_paced_async_driver(robot, self_paced_driver, driver_robot);
+	assert_msg("Step #5", self_paced_async_driver.start());
+	assert_msg("Step #5", self_paced_async_driver.init());
+	const VectorXd initial_target = *robot->jointTargetPosition();
+	for (size_t i = 0; i < 20; ++i) {
+		assert_msg("Step #5", self_paced_async_driver.read());
+		safety_controller.compute();
+		assert_msg("Step #5", self_paced_async_driver.send());
+	}
+	assert_msg("Step #5", self_paced_driver->syncs == 0 and self_paced_driver->steps > 0);
+	assert_msg("Step #5", self_paced_async_driver.driverErrors() == 0);
+
+	// Step #6 : the target position integrated by the wrapped driver is copied back with the measurements
+	assert_msg("Step #6", ((*robot->jointTargetPosition() - initial_target).array() > 0.).all());
+	assert_msg("Step #6", self_paced_async_driver.commandAge() >= 0.);
+
+	// Step #7 : initializing a running driver restarts its I/O thread
+	assert_msg("Step #7", self_paced_async_driver.init());
+	for (size_t i = 0; i < 20; ++i) {
+		assert_msg("Step #7", self_paced_async_driver.read());
+		safety_controller.compute();
+		assert_msg("Step #7", self_paced_async_driver.send());
+	}
+	assert_msg("Step #7", self_paced_async_driver.stop());
+	assert_msg("Step #7", self_paced_async_driver.driverErrors() == 0);
+
+	return 0;
+}
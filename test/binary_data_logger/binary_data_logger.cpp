@@ -0,0 +1,150 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+
+	constexpr size_t signal_count = 50;
+	constexpr size_t cycles = 5000;
+	constexpr size_t chunk_rows = 1024;
+
+	auto time = make_shared<double>(0.);
+	vector<Vector6d> signals(signal_count, Vector6d::Zero());
+
+	{
+		DataLogger logger("/tmp", time);
+		logger.enableBinaryMode(cycles, chunk_rows);
+		for (size_t i = 0; i < signal_count; ++i) {
+			logger.logExternalData("signal" + to_string(i), signals[i].data(), 6);
+		}
+
+		// Step #1 : no cycle is dropped when the buffer can hold all of them
+		for (size_t cycle = 0; cycle < cycles; ++cycle) {
+			*time = cycle * 0.001;
+			for (size_t i = 0; i < signal_count; ++i) {
+				signals[i].setConstant(cycle + i);
+			}
+			logger.process();
+		}
+		assert_msg("Step #1", logger.droppedCycles() == 0);
+	}
+
+	// Step #2 : the file contains the schema and all the rows in columnar chunks
+	ifstream file("/tmp/log_data.bin", ios::binary);
+	assert_msg("Step #2", file.is_open());
+	vector<char> content((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+	assert_msg("Step #2", std::equal(binary_log_magic, binary_log_magic+8, content.data()));
+	uint32_t header[4];
+	std::memcpy(header, content.data() + 8, sizeof(header));
+	assert_msg("Step #2", header[0] == binary_log_version);
+	assert_msg("Step #2", header[2] == signal_count);
+	const size_t row_size = 1 + 6 * signal_count;
+
+	size_t offset = header[1];
+	size_t rows = 0;
+	while(offset < content.size()) {
+		BinaryLogChunkHeader chunk;
+		std::memcpy(&chunk, content.data() + offset, sizeof(chunk));
+		assert_msg("Step #2", chunk.magic == binary_log_chunk_magic);
+		const double* columns = reinterpret_cast<const double*>(content.data() + offset + sizeof(chunk));
+		for (size_t row = 0; row < chunk.row_count; ++row) {
+			size_t cycle = rows + row;
+			assert_msg("Step #2", columns[row] == cycle * 0.001);
+			// first value of the first signal (signal0)
+			assert_msg("Step #2", columns[chunk.row_count + row] == cycle);
+		}
+		rows += chunk.row_count;
+		offset += sizeof(chunk) + row_size * chunk.row_count * sizeof(double);
+	}
+	assert_msg("Step #2", offset == content.size());
+	assert_msg("Step #2", rows == cycles);
+	file.close();
+
+	// Step #3 : memory mapped reading and seeking by time
+	size_t last_chunk_rows;
+	{
+		BinaryLogReader reader("/tmp/log_data.bin");
+		assert_msg("Step #3", reader.rowCount() == cycles and not reader.isTruncated());
+		int signal = reader.signalIndex("signal42");
+		assert_msg("Step #3", signal >= 0);
+		auto row = reader.findRow(1.2345);
+		assert_msg("Step #3", row == 1235);
+		assert_msg("Step #3", reader.signal(row, signal).isApprox(Vector6d::Constant(row + 42)));
+		assert_msg("Step #3", reader.findRow(100.) == reader.rowCount());
+		last_chunk_rows = reader.chunks().back().row_count;
+	}
+
+	// Step #4 : recovery of a file with an incomplete trailing chunk
+	truncate("/tmp/log_data.bin", content.size() - 100);
+	{
+		BinaryLogReader reader("/tmp/log_data.bin");
+		assert_msg("Step #4", reader.isTruncated());
+		assert_msg("Step #4", reader.rowCount() == cycles - last_chunk_rows);
+	}
+	assert_msg("Step #4", BinaryLogReader::recover("/tmp/log_data.bin"));
+	assert_msg("Step #4", not BinaryLogReader::recover("/tmp/log_data.bin"));
+
+	// Step #5 : appending to an existing file
+	size_t recovered_rows = BinaryLogReader("/tmp/log_data.bin").rowCount();
+	{
+		DataLogger logger("/tmp", time);
+		logger.enableBinaryMode(cycles, chunk_rows, true);
+		for (size_t i = 0; i < signal_count; ++i) {
+			logger.logExternalData("signal" + to_string(i), signals[i].data(), 6);
+		}
+		for (size_t cycle = 0; cycle < 10; ++cycle) {
+			*time = 10. + cycle * 0.001;
+			logger.process();
+		}
+	}
+	{
+		BinaryLogReader reader("/tmp/log_data.bin");
+		assert_msg("Step #5", reader.rowCount() == recovered_rows + 10);
+		assert_msg("Step #5", reader.findRow(10.) == recovered_rows);
+	}
+
+	// Step #6 : an item removed and added back under the same name is logged from its new storage
+	{
+		auto robot = make_shared<Robot>("rob", 7);
+		SafetyController controller(robot);
+		auto first_velocity = make_shared<Twist>();
+		first_velocity->translation().x() = 0.1;
+		auto second_velocity = make_shared<Twist>();
+		second_velocity->translation().x() = 0.2;
+		controller.add("vel proxy", make_shared<VelocityProxy>(first_velocity));
+
+		DataLogger logger("/tmp", time);
+		logger.enableBinaryMode();
+		logger.logSafetyControllerData(&controller);
+		*time = 0.;
+		controller.compute();
+		logger.process();
+
+		// The item count is the same before and after
+		controller.removeVelocityGenerator("vel proxy");
+		controller.add("other proxy", make_shared<VelocityProxy>(first_velocity));
+		controller.add("vel proxy", make_shared<VelocityProxy>(second_velocity));
+		controller.removeVelocityGenerator("other proxy");
+		*time = 1.;
+		controller.compute();
+		logger.process();
+	}
+	{
+		BinaryLogReader reader("/tmp/log_data.bin");
+		int signal = reader.signalIndex("vel proxy");
+		assert_msg("Step #6", signal >= 0 and reader.rowCount() == 2);
+		assert_msg("Step #6", reader.signal(0, signal)(0) == 0.1);
+		assert_msg("Step #6", reader.signal(1, signal)(0) == 0.2);
+	}
+
+	return 0;
+}
@@ -0,0 +1,66 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+
+	constexpr size_t cycles = 3000;
+
+	// Record a text log
+	auto time = make_shared<double>(0.);
+	Vector6d force;
+	VectorXd position(3);
+	{
+		DataLogger logger("/tmp/", time);
+		logger.logExternalData("force", force.data(), 6);
+		logger.logExternalData("position", position.data(), 3);
+		for (size_t cycle = 0; cycle < cycles; ++cycle) {
+			*time = cycle * 0.001;
+			force.setConstant(cycle);
+			position << cycle, -double(cycle), 0.5 * cycle;
+			logger.process();
+		}
+	}
+
+	// Step #1 : conversion of the text logs
+	auto rows = BinaryDataReplayer::convertTextLogs(
+		{{"force", "/tmp/log_force.txt"}, {"position", "/tmp/log_position.txt"}},
+		"/tmp/replay_data.bin");
+	assert_msg("Step #1", rows == cycles);
+
+	// Step #2 : lockstep replay of all the signals
+	BinaryDataReplayer replayer("/tmp/replay_data.bin");
+	auto replayed_force = make_shared<Vector6d>();
+	auto replayed_position = make_shared<VectorXd>(3);
+	replayer.replay("force", replayed_force);
+	replayer.replay("position", replayed_position);
+
+	size_t row = 0;
+	while(replayer.process()) {
+		assert_msg("Step #2", replayed_force->isApprox(Vector6d::Constant(row)));
+		assert_msg("Step #2", (*replayed_position)(1) == -double(row));
+		assert_msg("Step #2", replayer.get("position")(2) == 0.5 * row);
+		++row;
+	}
+	assert_msg("Step #2", row == cycles);
+
+	// Step #3 : seeking by time
+	assert_msg("Step #3", replayer.seek(1.5));
+	assert_msg("Step #3", replayer.process());
+	assert_msg("Step #3", replayer.row() == 1500 and std::abs(replayer.time() - 1.5) < 1e-9);
+	assert_msg("Step #3", not replayer.seek(10.));
+
+	// Step #4 : following a clock ten times faster than real time
+	replayer.rewind();
+	for (size_t i = 1; i <= 10; ++i) {
+		replayer.processUntil(i * 0.01);
+		assert_msg("Step #4", replayer.row() == i * 10);
+	}
+	assert_msg("Step #4", not replayer.processUntil(100.));
+	assert_msg("Step #4", replayer.row() == cycles - 1);
+
+	return 0;
+}
@@ -0,0 +1,53 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+
+	constexpr double sample_time = 0.005;
+	Clock clock(sample_time);
+
+	size_t notifications = 0;
+	auto id = clock.subscribe(
+		[&notifications](const Clock&) {
+			++notifications;
+		});
+
+	// Step #1 : nominal time advances by the sample time, measured time follows the steady clock
+	for (size_t i = 0; i < 10; ++i) {
+		this_thread::sleep_for(chrono::milliseconds(5));
+		clock.update();
+	}
+	assert_msg("Step #1", std::abs(*clock.getNominalTime() - 10 * sample_time) < 1e-12);
+	assert_msg("Step #1", *clock.getMeasuredTime() >= 10 * sample_time);
+	assert_msg("Step #1", clock.getStatistics().cycles == 10);
+	assert_msg("Step #1", clock.getStatistics().min_cycle_time >= sample_time);
+	assert_msg("Step #1", notifications == 10);
+
+	// Step #2 : slipped cycles are detected and reconciled
+	clock.reset();
+	clock.setReconciliation(true);
+	this_thread::sleep_for(chrono::milliseconds(20));
+	clock.update();
+	assert_msg("Step #2", clock.getStatistics().missed_cycles >= 2);
+	assert_msg("Step #2", std::abs(clock.getDrift()) < sample_time);
+
+	// Step #3 : unsubscribed functions are no longer called
+	clock.unsubscribe(id);
+	clock.update();
+	assert_msg("Step #3", notifications == 11);
+
+	// Step #4 : without a sample time the nominal time is the measured one
+	Clock free_clock;
+	this_thread::sleep_for(chrono::milliseconds(1));
+	free_clock.update();
+	assert_msg("Step #4", *free_clock.getTime() > 0. and *free_clock.getTime() == *free_clock.getMeasuredTime());
+
+	return 0;
+}
@@ -0,0 +1,120 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+#include <iostream>
+
+using namespace phri;
+using namespace std;
+
+bool isClose(double v1, double v2, double eps = 1e-3) {
+	return std::abs(v1-v2) < eps;
+}
+
+int main(int argc, char const *argv[]) {
+
+	auto robot = make_shared<Robot>(
+		"rob",  // Robot's name
+		7);     // Robot's joint count
+
+	auto safety_controller = SafetyController(robot);
+
+	auto separation_distance = make_shared<double>(2.);
+	auto robot_mass = make_shared<double>(10.);
+	auto collaborative_constraint = make_shared<CollaborativeModeConstraint>(
+		CollaborativeMode::SafetyRatedMonitoredStop,
+		separation_distance,
+		robot_mass);
+
+	auto constant_vel = make_shared<Twist>();
+	auto constant_velocity_generator = make_shared<VelocityProxy>(constant_vel);
+
+	safety_controller.add("collaborative constraint", collaborative_constraint);
+	safety_controller.add("vel proxy", constant_velocity_generator);
+
+	const auto params = collaborative_constraint->getParameters();
+	auto cp_velocity_norm = [&robot]() {
+		return robot->controlPointVelocity()->translation().norm();
+	};
+
+	// Step #1 : safety-rated monitored stop
+	constant_vel->translation().x() = 2.;
+	safety_controller.compute();
+	assert_msg("Step #1", cp_velocity_norm() == 0.);
+
+	// Step #2 : hand guiding
+	collaborative_constraint->setMode(CollaborativeMode::HandGuiding);
+	safety_controller.compute();
+	assert_msg("Step #2", isClose(cp_velocity_norm(), params.hand_guiding_velocity));
+
+	// Step #3 : speed and separation monitoring, the table never exceeds the exact velocity
+	collaborative_constraint->setMode(CollaborativeMode::SpeedAndSeparationMonitoring);
+	for (double distance = 0.; distance < 6.; distance += 0.0137) {
+		*separation_distance = distance;
+		collaborative_constraint->compute();
+		double exact = CollaborativeModeConstraint::separationVelocity(params, std::min(distance, params.maximum_separation_distance));
+		double velocity = *collaborative_constraint->getMaximumVelocity();
+		assert_msg("Step #3", velocity <= exact + 1e-12 and velocity > exact - 1e-2);
+	}
+	*separation_distance = 0.5;
+	safety_controller.compute();
+	assert_msg("Step #3", cp_velocity_norm() == 0.);
+	*separation_distance = 1.5;
+	safety_controller.compute();
+	assert_msg("Step #3", isClose(cp_velocity_norm(), CollaborativeModeConstraint::separationVelocity(params, 1.5)));
+
+	// Step #4 : power and force limiting, hands only
+	auto hand_params = params;
+	hand_params.body_regions = {BodyRegion::Hand};
+	collaborative_constraint->setParameters(hand_params);
+	collaborative_constraint->setMode(CollaborativeMode::PowerAndForceLimiting);
+	safety_controller.compute();
+	// 2*140N / sqrt(mu * 75e3 N/m), mu = (1/0.6 + 1/10)^-1
+	double expected = 2. * 140. / std::sqrt(75e3 / (1./0.6 + 1./10.));
+	assert_msg("Step #4", isClose(*collaborative_constraint->getMaximumVelocity(), expected) and *collaborative_constraint->getMaximumVelocity() <= expected);
+	assert_msg("Step #4", isClose(cp_velocity_norm(), expected));
+
+	// Step #5 : all body regions, the most restrictive one is used
+	auto all_params = params;
+	collaborative_constraint->setParameters(all_params);
+	for (double mass = 0.5; mass < 100.; mass *= 1.1) {
+		*robot_mass = mass;
+		collaborative_constraint->compute();
+		double exact = std::numeric_limits<double>::infinity();
+		for (int region = 0; region <= static_cast<int>(BodyRegion::LowerLeg); ++region) {
+			exact = std::min(exact, CollaborativeModeConstraint::contactVelocity(CollaborativeModeConstraint::bodyRegionLimits(static_cast<BodyRegion>(region)), mass, 2.));
+		}
+		double velocity = *collaborative_constraint->getMaximumVelocity();
+		assert_msg("Step #5", velocity <= exact + 1e-12 and velocity > exact - 1e-2);
+	}
+
+	// Step #6 : missing input
+	auto no_mass_constraint = make_shared<CollaborativeModeConstraint>(CollaborativeMode::HandGuiding, separation_distance, nullptr);
+	try {
+		no_mass_constraint->setMode(CollaborativeMode::PowerAndForceLimiting);
+		assert_msg("Step #6", false);
+	}
+	catch(std::runtime_error& err) {
+		std::cerr << "Expected exception: " << err.what() << std::endl;
+	}
+	assert_msg("Step #6", no_mass_constraint->getMode() == CollaborativeMode::HandGuiding);
+
+	// Step #7 : declarative configuration
+	auto configuration = YAML::Load(
+		"controller:\n"
+		"  shared_parameters:\n"
+		"    distance: 1.5\n"
+		"  constraints:\n"
+		"    - name: iso\n"
+		"      type: collaborative_mode\n"
+		"      mode: speed_and_separation\n"
+		"      separation_distance: distance\n"
+		"      body_regions: [hand, lower_arm]\n");
+	SafetyController configured_controller(robot);
+	auto parameters = ControllerFactory::build(configured_controller, robot, configuration, 0.001);
+	auto iso_constraint = std::dynamic_pointer_cast<CollaborativeModeConstraint>(configured_controller.getConstraint("iso"));
+	assert_msg("Step #7", iso_constraint and iso_constraint->getMode() == CollaborativeMode::SpeedAndSeparationMonitoring and iso_constraint->getParameters().body_regions.size() == 2);
+	iso_constraint->compute();
+	assert_msg("Step #7", isClose(*iso_constraint->getMaximumVelocity(), CollaborativeModeConstraint::separationVelocity(params, 1.5)));
+
+	return 0;
+}
@@ -0,0 +1,120 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+#include <iostream>
+#include <random>
+
+using namespace phri;
+using namespace std;
+
+AffineTransformPtr makeFrame(const Vector3d& translation, const Eigen::Quaterniond& rotation = Eigen::Quaterniond::Identity()) {
+	auto frame = make_shared<AffineTransform>(AffineTransform::Identity());
+	frame->translation() = translation;
+	frame->linear() = rotation.toRotationMatrix();
+	return frame;
+}
+
+// Analytic distance between a sphere and a box
+double sphereBoxDistance(const AffineTransform& sphere, double radius, const AffineTransform& box, const Vector3d& size) {
+	Vector3d center = box.inverse() * sphere.translation();
+	Vector3d closest = center.cwiseMax(-size / 2.).cwiseMin(size / 2.);
+	return std::max(0., (center - closest).norm() - radius);
+}
+
+int main(int argc, char const *argv[]) {
+
+	// Step #1 : sphere - sphere, distance and witness points
+	{
+		CollisionScene scene;
+		scene.addRobotBody("sphere", make_shared<SphereShape>(0.1), makeFrame(Vector3d(0., 0., 0.)));
+		scene.addObstacleBody("sphere", make_shared<SphereShape>(0.2), makeFrame(Vector3d(1., 0., 0.)));
+		scene.update();
+		const auto& closest = scene.closest();
+		assert_msg("Step #1", std::abs(closest.distance - 0.7) < 1e-9);
+		assert_msg("Step #1", closest.robot_point.isApprox(Vector3d(0.1, 0., 0.)) and closest.obstacle_point.isApprox(Vector3d(0.8, 0., 0.)));
+	}
+
+	// Step #2 : box - capsule, box - convex hull and intersection
+	{
+		CollisionScene scene;
+		auto box_frame = makeFrame(Vector3d(0., 0., 0.));
+		scene.addRobotBody("box", make_shared<BoxShape>(Vector3d(0.2, 0.2, 0.2)), box_frame);
+		auto capsule_frame = makeFrame(Vector3d(0., 0., 1.));
+		scene.addObstacleBody("capsule", make_shared<CapsuleShape>(0.05, 0.5), capsule_frame);
+		scene.update();
+		assert_msg("Step #2", std::abs(scene.closest().distance - (1. - 0.25 - 0.05 - 0.1)) < 1e-9);
+
+		Matrix3Xd cube(3, 8);
+		cube <<
+		    -1, 1, -1, 1, -1, 1, -1, 1,
+		    -1, -1, 1, 1, -1, -1, 1, 1,
+		    -1, -1, -1, -1, 1, 1, 1, 1;
+		cube *= 0.1;
+		scene.addObstacleBody("hull", make_shared<ConvexHullShape>(cube), makeFrame(Vector3d(0.5, 0.3, 0.)));
+		scene.update();
+		assert_msg("Step #2", std::abs(scene.closest().distance - std::sqrt(0.3*0.3 + 0.1*0.1)) < 1e-9 and scene.closest().obstacle_body == 1);
+
+		capsule_frame->translation() << 0.1, 0.1, 0.3;
+		scene.update();
+		assert_msg("Step #2", scene.closest().distance == 0. and scene.closest().obstacle_body == 0);
+	}
+
+	// Step #3 : random sphere - rotated box configurations, compared to the analytic distance
+	{
+		std::mt19937 generator(42);
+		std::uniform_real_distribution<double> uniform(-1., 1.);
+		CollisionScene scene;
+		const Vector3d box_size(0.3, 0.2, 0.5);
+		auto sphere_frame = makeFrame(Vector3d::Zero());
+		auto box_frame = makeFrame(Vector3d::Zero());
+		scene.addRobotBody("sphere", make_shared<SphereShape>(0.05), sphere_frame);
+		scene.addObstacleBody("box", make_shared<BoxShape>(box_size), box_frame);
+		for (size_t i = 0; i < 200; ++i) {
+			sphere_frame->translation() << uniform(generator), uniform(generator), uniform(generator);
+			Eigen::Quaterniond rotation(uniform(generator), uniform(generator), uniform(generator), uniform(generator));
+			box_frame->linear() = rotation.normalized().toRotationMatrix();
+			box_frame->translation() << 0.1 * uniform(generator), 0.1 * uniform(generator), 0.1 * uniform(generator);
+			scene.update();
+			double expected = sphereBoxDistance(*sphere_frame, 0.05, *box_frame, box_size);
+			assert_msg("Step #3", std::abs(scene.closest().distance - expected) < 1e-6);
+		}
+	}
+
+	// Step #4 : many obstacles, broad phase and maximum distance
+	{
+		std::mt19937 generator(7);
+		std::uniform_real_distribution<double> uniform(-2., 2.);
+		const double maximum_distance = 0.5;
+		CollisionScene scene(maximum_distance);
+		std::vector<AffineTransformPtr> robot_frames, obstacle_frames;
+		for (size_t i = 0; i < 10; ++i) {
+			robot_frames.push_back(makeFrame(Vector3d(0.1 * i, 0., 0.5)));
+			scene.addRobotBody("link" + std::to_string(i), make_shared<SphereShape>(0.05), robot_frames.back());
+		}
+		for (size_t i = 0; i < 50; ++i) {
+			obstacle_frames.push_back(makeFrame(Vector3d(uniform(generator), uniform(generator), uniform(generator))));
+			scene.addObstacleBody("obstacle" + std::to_string(i), make_shared<SphereShape>(0.1), obstacle_frames.back());
+		}
+
+		for (size_t cycle = 0; cycle < 10; ++cycle) {
+			for(auto& frame: obstacle_frames) {
+				frame->translation() *= 0.9;
+			}
+			scene.update();
+			for (size_t r = 0; r < robot_frames.size(); ++r) {
+				double expected = std::numeric_limits<double>::infinity();
+				for(const auto& frame: obstacle_frames) {
+					double distance = std::max(0., (frame->translation() - robot_frames[r]->translation()).norm() - 0.15);
+					if(distance < maximum_distance) {
+						expected = std::min(expected, distance);
+					}
+				}
+				const auto& result = scene.robotBodyDistances()[r];
+				assert_msg("Step #4", (std::isinf(expected) and std::isinf(result.distance)) or std::abs(result.distance - expected) < 1e-9);
+			}
+			assert_msg("Step #4", scene.narrowPhaseCount() < robot_frames.size() * obstacle_frames.size());
+		}
+	}
+
+	return 0;
+}
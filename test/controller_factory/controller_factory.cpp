@@ -0,0 +1,116 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+
+#include <yaml-cpp/yaml.h>
+
+using namespace phri;
+using namespace std;
+
+bool isClose(double v1, double v2, double eps = 1e-9) {
+	return std::abs(v1-v2) < eps;
+}
+
+template<typename T>
+bool throws(T&& function) {
+	try {
+		function();
+	}
+	catch(std::runtime_error&) {
+		return true;
+	}
+	return false;
+}
+
+int main(int argc, char const *argv[]) {
+
+	auto robot = make_shared<Robot>("rob", 7);
+	const Vector6d& cp_velocity = *robot->controlPointVelocity();
+
+	auto configuration = YAML::Load(R"(
+controller:
+  shared_parameters:
+    max_velocity: 0.1
+    stop_threshold: 25
+  constraints:
+    - name: velocity
+      type: velocity
+      maximum_velocity: max_velocity
+    - name: stop
+      type: emergency_stop
+      activation_force_threshold: stop_threshold
+      deactivation_force_threshold: 5
+    - name: separation
+      type: separation_distance
+      interpolator: {type: linear, from: [0.1, 0.], to: [0.5, 0.2], saturation: true}
+      constraint: {type: velocity, maximum_velocity: separation}
+      objects:
+        - {name: obstacle, position: [2, 0, 0]}
+  force_generators:
+    - name: force proxy
+      type: force_proxy
+  velocity_generators:
+    - name: velocity proxy
+      type: velocity_proxy
+      velocity: [0.5, 0, 0, 0, 0, 0]
+  joint_velocity_generators:
+    - name: null space
+      type: null_space_motion
+      velocity: 0
+)");
+
+	// Step #1 : all the objects are created
+	auto controller = SafetyController(robot, configuration);
+	auto parameters = ControllerFactory::build(controller, robot, configuration, 1e-3);
+
+	assert_msg("Step #1", controller.get<VelocityConstraint>("velocity") != nullptr);
+	assert_msg("Step #1", controller.get<EmergencyStopConstraint>("stop") != nullptr);
+	assert_msg("Step #1", controller.get<SeparationDistanceConstraint>("separation") != nullptr);
+	assert_msg("Step #1", dynamic_pointer_cast<ForceProxy>(controller.getForceGenerator("force proxy")) != nullptr);
+	assert_msg("Step #1", dynamic_pointer_cast<VelocityProxy>(controller.getVelocityGenerator("velocity proxy")) != nullptr);
+	assert_msg("Step #1", dynamic_pointer_cast<NullSpaceMotion>(controller.getJointVelocityGenerator("null space")) != nullptr);
+
+	// Step #2 : the velocity is limited by the smallest constraint (the object is far away, so the separation distance constraint allows 0.2m/s)
+	controller.compute();
+	assert_msg("Step #2", isClose(cp_velocity.x(), 0.1));
+
+	// Step #3 : the shared parameters are stored contiguously and can be modified at runtime
+	assert_msg("Step #3", parameters->size() <= parameters->capacity());
+	assert_msg("Step #3", parameters->get("max_velocity").get() == parameters->data());
+	assert_msg("Step #3", parameters->get("stop_threshold").get() == parameters->data() + 1);
+	*parameters->get("max_velocity") = 0.05;
+	controller.compute();
+	assert_msg("Step #3", isClose(cp_velocity.x(), 0.05));
+
+	// Step #4 : invalid configurations are rejected
+	auto build = [&robot](const std::string& yaml) {
+		auto controller = SafetyController(robot);
+		ControllerFactory::build(controller, robot, YAML::Load(yaml), 1e-3);
+	};
+	assert_msg("Step #4", throws([&]{ build("{controller: {constraints: [{name: c, type: unknown}]}}"); }));
+	assert_msg("Step #4", throws([&]{ build("{controller: {constraints: [{name: c, type: velocity, maximum_velocity: unknown}]}}"); }));
+	assert_msg("Step #4", throws([&]{ build("{controller: {constraints: [{name: c, type: velocity}]}}"); }));
+	assert_msg("Step #4", throws([&]{ build("{controller: {velocity_generators: [{name: v, type: velocity_proxy, velocity: [1, 2]}]}}"); }));
+	assert_msg("Step #4", throws([&]{ build("{controller: {velocity_generators: [{name: v, type: velocity_proxy}, {name: v, type: velocity_proxy}]}}"); }));
+	assert_msg("Step #4", not throws([&]{ build("{driver: {type: dummy}}"); }));
+
+	// Step #5 : user defined types can be registered
+	bool registered = ConstraintFactory::add("half_velocity",
+		[](const YAML::Node& conf, FactoryContext& context) -> ConstraintPtr {
+			auto max_velocity = context.parameter(conf, "maximum_velocity");
+			*max_velocity /= 2.;
+			return make_shared<VelocityConstraint>(max_velocity);
+		});
+	assert_msg("Step #5", registered);
+	assert_msg("Step #5", not ConstraintFactory::add("velocity", ConstraintFactory::create_method_t()));
+
+	auto other_controller = SafetyController(robot);
+	auto velocity = make_shared<Twist>();
+	velocity->translation().x() = 1.;
+	other_controller.add("velocity proxy", VelocityProxy(velocity));
+	ControllerFactory::build(other_controller, robot, YAML::Load("{controller: {constraints: [{name: c, type: half_velocity, maximum_velocity: 0.2}]}}"), 1e-3);
+	other_controller.compute();
+	assert_msg("Step #5", isClose(cp_velocity.x(), 0.1));
+
+	return 0;
+}
@@ -0,0 +1,189 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+
+	auto robot = make_shared<Robot>("rob", 7);
+	auto controller = make_shared<SafetyController>(robot);
+
+	auto velocity = make_shared<Twist>();
+	velocity->translation().x() = 0.1;
+	controller->add("vel proxy", make_shared<VelocityProxy>(velocity));
+
+	const Vector6d& cp_velocity = *robot->controlPointVelocity();
+
+	auto initial_parameters = make_shared<ParameterBlock>(1);
+	ControllerReconfigurator reconfigurator(controller, robot, initial_parameters);
+	reconfigurator.setBuilder(
+		[velocity](SafetyController& staged, const YAML::Node& configuration) {
+			auto parameters = make_shared<ParameterBlock>(2);
+			auto max_velocity = parameters->add("max_velocity", configuration["max_velocity"].as<double>());
+			staged.add("vel proxy", make_shared<VelocityProxy>(velocity));
+			staged.add("vel constraint", make_shared<VelocityConstraint>(max_velocity));
+			if(configuration["max_power"]) {
+				staged.add("power constraint", make_shared<PowerConstraint>(parameters->add(configuration["max_power"].as<double>())));
+			}
+			return parameters;
+		});
+
+	// Step #1 : nothing happens until a configuration is requested
+	controller->compute();
+	assert_msg("Step #1", not reconfigurator.update());
+	assert_msg("Step #1", cp_velocity.x() == 0.1);
+	assert_msg("Step #1", reconfigurator.parameters() == initial_parameters);
+	const auto initial_version = controller->configurationVersion();
+
+	// Step #2 : the new configuration is swapped in by update()
+	auto configuration = YAML::Load("{max_velocity: 0.05, controller: {lambda_max: 0.1}}");
+	reconfigurator.reconfigure(configuration);
+	reconfigurator.waitUntilBuilt();
+	controller->compute();
+	assert_msg("Step #2", cp_velocity.x() == 0.1);
+	assert_msg("Step #2", reconfigurator.update());
+	controller->compute();
+	assert_msg("Step #2", std::abs(cp_velocity.x() - 0.05) < 1e-9);
+	assert_msg("Step #2", controller->get<VelocityConstraint>("vel constraint") != nullptr);
+	assert_msg("Step #2", reconfigurator.reconfigurationCount() == 1);
+	assert_msg("Step #2", controller->configurationVersion() == initial_version + 1);
+
+	// Step #3 : the parameter block of the new configuration is published with it and can be used to tune the live controller
+	auto parameters = reconfigurator.parameters();
+	assert_msg("Step #3", parameters != initial_parameters and *parameters->get("max_velocity") == 0.05);
+	*parameters->get("max_velocity") = 0.06;
+	controller->compute();
+	assert_msg("Step #3", std::abs(cp_velocity.x() - 0.06) < 1e-9);
+	*parameters->get("max_velocity") = 0.05;
+	controller->compute();
+
+	// Step #4 : invalid configurations are rejected and the current one is kept
+	reconfigurator.reconfigure(YAML::Load("{controller: {}}"));
+	reconfigurator.waitUntilBuilt();
+	assert_msg("Step #4", not reconfigurator.update());
+	assert_msg("Step #4", not reconfigurator.lastError().empty());
+	controller->compute();
+	assert_msg("Step #4", std::abs(cp_velocity.x() - 0.05) < 1e-9);
+
+	// Step #5 : configuration file, applied while the control loop is running
+	const std::string file = "controller_reconfiguration_test.yaml";
+	{
+		std::ofstream stream(file);
+		stream << "max_velocity: 0.02\n";
+	}
+	std::atomic<bool> stop(false);
+	std::atomic<bool> reconfigured(false);
+	std::thread loop(
+		[&]() {
+			while(not stop) {
+				if(reconfigurator.update()) {
+					reconfigured = true;
+				}
+				controller->compute();
+			}
+		});
+	reconfigurator.reconfigureFromFile(file);
+	reconfigurator.waitUntilBuilt();
+	while(not reconfigured) {
+		std::this_thread::yield();
+	}
+	stop = true;
+	loop.join();
+	std::remove(file.c_str());
+
+	assert_msg("Step #5", std::abs(cp_velocity.x() - 0.02) < 1e-9);
+	assert_msg("Step #5", reconfigurator.reconfigurationCount() == 2);
+
+	// Step #6 : only the last requested configuration is applied
+	reconfigurator.reconfigure(YAML::Load("{max_velocity: 0.03}"));
+	reconfigurator.waitUntilBuilt();
+	reconfigurator.reconfigure(YAML::Load("{max_velocity: 0.04}"));
+	reconfigurator.waitUntilBuilt();
+	// Let the background thread destroy the previous configuration
+	while(not reconfigurator.update()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	controller->compute();
+	assert_msg("Step #6", std::abs(cp_velocity.x() - 0.04) < 1e-9);
+	reconfigurator.waitUntilBuilt();
+	assert_msg("Step #6", not reconfigurator.update());
+
+	// Step #7 : the telemetry and the binary logs follow the reconfigurations
+	std::remove("/tmp/log_data.bin");
+	std::remove("/tmp/log_data_1.bin");
+	std::remove("/tmp/log_blackbox_0.bin");
+	auto time = make_shared<double>(0.);
+	bool trigger = false;
+	{
+		DataLogger logger("/tmp", time);
+		logger.enableBinaryMode();
+		logger.enableBlackBox(1., 0.1);
+		logger.addTrigger("test", [&trigger]{return trigger;});
+		logger.logSafetyControllerData(controller.get());
+		TelemetryPublisher publisher("/openphri_reconfiguration_test", time);
+		publisher.publishSafetyControllerData(controller.get());
+
+		size_t reconfiguration_count = reconfigurator.reconfigurationCount();
+		auto cycle =
+			[&]() {
+				reconfigurator.update();
+				controller->compute();
+				*time += 0.1;
+				logger.process();
+				publisher.publish();
+			};
+		auto reconfigure =
+			[&](const std::string& configuration) {
+				reconfigurator.reconfigure(YAML::Load(configuration));
+				reconfigurator.waitUntilBuilt();
+				while(reconfigurator.reconfigurationCount() == reconfiguration_count) {
+					cycle();
+				}
+				++reconfiguration_count;
+			};
+
+		cycle();
+		TelemetryReader reader("openphri_reconfiguration_test");
+		vector<double> row;
+
+		// Same items: the segment is kept and shows the new values
+		reconfigure("{max_velocity: 0.01}");
+		cycle();
+		reader.read(row);
+		assert_msg("Step #7", not reader.isReplaced());
+		assert_msg("Step #7", std::abs(reader.signal(row, reader.signalIndex("vel constraint"))(0) - 0.1) < 1e-9);
+
+		// New item: the segment is replaced and the binary log continues in a new file
+		reconfigure("{max_velocity: 0.01, max_power: 10}");
+		cycle();
+		assert_msg("Step #7", reader.isReplaced());
+		TelemetryReader new_reader("openphri_reconfiguration_test");
+		assert_msg("Step #7", new_reader.signalIndex("power constraint") >= 0);
+		new_reader.read(row);
+		assert_msg("Step #7", new_reader.signal(row, new_reader.signalIndex("power constraint"))(0) > 0.);
+
+		trigger = true;
+		cycle();
+		assert_msg("Step #7", logger.blackBoxFlushes() == 1);
+	}
+	{
+		BinaryLogReader first_log("/tmp/log_data.bin");
+		BinaryLogReader second_log("/tmp/log_data_1.bin");
+		BinaryLogReader black_box("/tmp/log_blackbox_0.bin");
+		assert_msg("Step #7", first_log.signalIndex("power constraint") < 0 and first_log.rowCount() > 0);
+		assert_msg("Step #7", second_log.signalIndex("power constraint") >= 0 and second_log.rowCount() == 3);
+		assert_msg("Step #7", black_box.signalIndex("power constraint") >= 0 and black_box.rowCount() == 3);
+	}
+
+	return 0;
+}
@@ -0,0 +1,87 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sys/stat.h>
+
+using namespace phri;
+using namespace std;
+
+size_t lineCount(const string& file_name) {
+	ifstream file(file_name);
+	return count(istreambuf_iterator<char>(file), istreambuf_iterator<char>(), '\n');
+}
+
+int main(int argc, char const *argv[]) {
+
+	const string folder = "/tmp/phri_data_logger_triggers/";
+	mkdir(folder.c_str(), 0755);
+
+	constexpr double sample_time = 0.001;
+	auto time = make_shared<double>(0.);
+	double fast = 0., slow = 0., disabled = 0.;
+	bool fault = false;
+
+	{
+		DataLogger logger(folder, time);
+		logger.logExternalData("fast", &fast, 1);
+		logger.logExternalData("slow", &slow, 1);
+		logger.logExternalData("disabled", &disabled, 1);
+		logger.setDecimation("slow", 10);
+		logger.setDecimation("disabled", 0);
+		logger.addTrigger("fault", [&fault](){ return fault; });
+		logger.enableBlackBox(0.05, sample_time);
+
+		for (size_t cycle = 0; cycle < 200; ++cycle) {
+			*time = cycle * sample_time;
+			fast = slow = disabled = cycle;
+			// Fault between cycles 100 and 109
+			fault = cycle >= 100 and cycle < 110;
+			logger.process();
+			// Step #1 : the trigger state follows its condition
+			assert_msg("Step #1", logger.isTriggered() == fault);
+		}
+		assert_msg("Step #1", logger.blackBoxFlushes() == 1);
+	}
+
+	// Step #2 : decimated data is logged once every factor cycles, and at full rate while triggered
+	assert_msg("Step #2", lineCount(folder + "log_fast.txt") == 200);
+	assert_msg("Step #2", lineCount(folder + "log_slow.txt") == 20 + 9);
+	assert_msg("Step #2", lineCount(folder + "log_disabled.txt") == 10);
+
+	// Step #3 : the black box holds the history preceding the trigger, in chronological order
+	{
+		BinaryLogReader reader(folder + "log_blackbox_0.bin");
+		assert_msg("Step #3", reader.rowCount() == 50);
+		assert_msg("Step #3", reader.signals().size() == 3);
+		int signal = reader.signalIndex("fast");
+		assert_msg("Step #3", signal >= 0);
+		for (size_t row = 0; row < reader.rowCount(); ++row) {
+			assert_msg("Step #3", reader.signal(row, signal)(0) == 51 + row);
+			assert_msg("Step #3", std::abs(reader.time(row) - (51 + row) * sample_time) < 1e-9);
+		}
+	}
+
+	// Step #4 : in binary mode, the rows are decimated unless triggered
+	{
+		DataLogger logger(folder, time);
+		logger.enableBinaryMode();
+		logger.logExternalData("fast", &fast, 1);
+		logger.setDefaultDecimation(5);
+		logger.addTrigger("fault", [&fault](){ return fault; });
+		for (size_t cycle = 0; cycle < 100; ++cycle) {
+			*time = cycle * sample_time;
+			fault = cycle >= 50 and cycle < 60;
+			logger.process();
+		}
+	}
+	{
+		BinaryLogReader reader(folder + "log_data.bin");
+		assert_msg("Step #4", reader.rowCount() == 20 + 8);
+	}
+
+	return 0;
+}
@@ -0,0 +1,84 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+
+	auto robot = make_shared<Robot>(
+		"rob",  // Robot's name
+		3);     // Robot's joint count
+
+	auto safety_controller = SafetyController(robot);
+	safety_controller.setVerbose(true);
+
+	constexpr double sample_time = 0.1;
+
+	auto limits = make_shared<JointLimits>(3);
+	limits->lowerPositions() << -1., -2., -3.;
+	limits->upperPositions() << 1., 2., 3.;
+	auto position_constraint = make_shared<JointPositionConstraint>(limits, sample_time);
+
+	auto constant_vel = make_shared<VectorXd>(3);
+	*constant_vel << 0., 0., 0.;
+	auto constant_velocity_generator = make_shared<JointVelocityProxy>(constant_vel);
+
+	safety_controller.add("position constraint", position_constraint);
+	safety_controller.add("vel proxy", constant_velocity_generator);
+
+	auto& joint_pos = *robot->jointCurrentPosition();
+	auto next_position = [&]() -> VectorXd {
+				 return joint_pos + *robot->jointVelocity() * sample_time;
+			 };
+
+	// Step #1 : no velocity
+	safety_controller.compute();
+
+	assert_msg("Step #1", robot->jointVelocity()->isZero());
+
+	// Step #2 : velocity 1 axis, far from the limits
+	(*constant_vel)(0) = 0.5;
+	safety_controller.compute();
+
+	assert_msg("Step #2", robot->jointVelocity()->isApprox(*robot->jointTotalVelocity()));
+
+	// Step #3 : velocity 1 axis, next position above the upper limit
+	joint_pos(0) = 0.99;
+	safety_controller.compute();
+
+	assert_msg("Step #3", limits->isInsidePositionLimits(next_position()) and (*robot->jointVelocity())(0) > 0.);
+
+	// Step #4 : velocity 1 axis, moving away from the upper limit
+	(*constant_vel)(0) = -0.5;
+	safety_controller.compute();
+
+	assert_msg("Step #4", robot->jointVelocity()->isApprox(*robot->jointTotalVelocity()));
+
+	// Step #5 : velocity 3 axes, next position below the lower limits
+	joint_pos << -0.99, -1.99, -2.99;
+	*constant_vel << -1., -1., -1.;
+	safety_controller.compute();
+
+	assert_msg("Step #5", limits->isInsidePositionLimits(next_position()));
+
+	// Step #6 : on the limit, moving outside
+	joint_pos << 1., 0., 0.;
+	*constant_vel << 1., 0., 0.;
+	safety_controller.compute();
+
+	assert_msg("Step #6", robot->jointVelocity()->isZero());
+
+	// Step #7 : clamping and distance queries
+	VectorXd position(3), distance(3);
+	position << 2., 0., -4.;
+	limits->clampPosition(position);
+	assert_msg("Step #7", position.isApprox(Vector3d(1., 0., -3.)));
+
+	position << 0.5, 0., -2.;
+	limits->distanceToLimits(position, distance);
+	assert_msg("Step #7", distance.isApprox(Vector3d(0.5, 2., 1.)));
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+
+	constexpr double period = 0.005;
+	LoopRunner loop(period);
+
+	// Step #1 : the period doesn't drift with the computation time
+	auto t_start = chrono::steady_clock::now();
+	bool ok = loop.run(
+		[]() {
+			this_thread::sleep_for(chrono::milliseconds(1));
+			return true;
+		},
+		50);
+	double duration = chrono::duration<double>(chrono::steady_clock::now() - t_start).count();
+	auto statistics = loop.getStatistics();
+	assert_msg("Step #1", ok);
+	assert_msg("Step #1", statistics.cycles == 50);
+	// A drifting loop would take 50 * (period + 1ms)
+	assert_msg("Step #1", duration < 50 * (period + 0.0005) + statistics.missed_periods * period);
+
+	// Step #2 : overruns and missed periods are counted
+	loop.resetStatistics();
+	loop.run(
+		[]() {
+			this_thread::sleep_for(chrono::milliseconds(12));
+			return true;
+		},
+		5);
+	statistics = loop.getStatistics();
+	assert_msg("Step #2", statistics.overruns == 5);
+	assert_msg("Step #2", statistics.missed_periods >= 10);
+	assert_msg("Step #2", statistics.max_cycle_duration >= 0.012);
+
+	// Step #3 : the jitter histogram accounts for all the cycles
+	uint64_t histogram_count = 0;
+	for(auto count: statistics.jitter_histogram) {
+		histogram_count += count;
+	}
+	assert_msg("Step #3", histogram_count == statistics.cycles);
+
+	// Step #4 : stop from the loop and from another thread
+	size_t cycles = 0;
+	ok = loop.run(
+		[&cycles]() {
+			return ++cycles < 10;
+		});
+	assert_msg("Step #4", not ok and cycles == 10);
+
+	std::thread stopper(
+		[&loop]() {
+			this_thread::sleep_for(chrono::milliseconds(20));
+			loop.stop();
+		});
+	ok = loop.run([]{return true;});
+	stopper.join();
+	assert_msg("Step #4", ok);
+
+	// Step #5 : a stop requested before running is not lost, until reset
+	loop.resetStatistics();
+	ok = loop.run([]{return true;});
+	assert_msg("Step #5", ok and loop.getStatistics().cycles == 0);
+	loop.reset();
+	ok = loop.run([]{return true;}, 3);
+	assert_msg("Step #5", ok and loop.getStatistics().cycles == 3);
+
+	// Step #6 : consistent statistics can be read while the loop runs
+	std::atomic<bool> reading(true);
+	bool consistent = true;
+	std::thread reader(
+		[&loop, &reading, &consistent]() {
+			while(reading) {
+				auto statistics = loop.getStatistics();
+				uint64_t count = 0;
+				for(auto bin: statistics.jitter_histogram) {
+					count += bin;
+				}
+				consistent &= count == statistics.cycles;
+			}
+		});
+	loop.resetStatistics();
+	loop.run([]{return true;}, 20);
+	reading = false;
+	reader.join();
+	assert_msg("Step #6", consistent and loop.getStatistics().cycles == 20);
+
+	// Step #7 : unpaced loops don't sleep and track no overrun
+	LoopRunner::Options options;
+	options.pace = false;
+	LoopRunner unpaced_loop(period, options);
+	t_start = chrono::steady_clock::now();
+	ok = unpaced_loop.run(
+		[]() {
+			this_thread::sleep_for(chrono::milliseconds(1));
+			return true;
+		},
+		10);
+	duration = chrono::duration<double>(chrono::steady_clock::now() - t_start).count();
+	statistics = unpaced_loop.getStatistics();
+	assert_msg("Step #7", ok and statistics.cycles == 10);
+	assert_msg("Step #7", duration < 10 * period);
+	assert_msg("Step #7", statistics.overruns == 0 and statistics.missed_periods == 0);
+
+	return 0;
+}
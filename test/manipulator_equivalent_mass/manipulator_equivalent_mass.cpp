@@ -0,0 +1,59 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+#include <iostream>
+
+using namespace phri;
+using namespace std;
+
+bool isClose(double v1, double v2, double eps = 1e-9) {
+	return std::abs(v1-v2) < eps * std::max(1., std::abs(v2));
+}
+
+double expectedMass(const MatrixXd& inertia, const MatrixXd& jacobian, const Vector3d& direction) {
+	Matrix3d mass_inv = jacobian.topRows<3>() * inertia.inverse() * jacobian.topRows<3>().transpose();
+	return 1. / (direction.transpose() * mass_inv * direction);
+}
+
+int main(int argc, char const *argv[]) {
+
+	std::srand(42);
+	MatrixXd random = MatrixXd::Random(7, 7);
+	auto inertia = make_shared<MatrixXd>(random * random.transpose() + MatrixXd::Identity(7, 7));
+	auto jacobian = make_shared<MatrixXd>(MatrixXd::Random(6, 7));
+	auto robot_position = make_shared<Vector6d>(Vector6d::Zero());
+
+	ManipulatorEquivalentMass mass_eq(inertia, jacobian, robot_position);
+
+	// Step #1 : no object, largest equivalent mass over all directions
+	mass_eq.compute();
+	Matrix3d mass_inv = jacobian->topRows<3>() * inertia->inverse() * jacobian->topRows<3>().transpose();
+	double largest_mass = 1. / Eigen::SelfAdjointEigenSolver<Matrix3d>(mass_inv).eigenvalues()(0);
+	assert_msg("Step #1", isClose(*mass_eq.getEquivalentMass(), largest_mass, 1e-6));
+
+	// Step #2 : closest object direction
+	auto object1 = make_shared<Vector6d>(Vector6d::Zero());
+	auto object2 = make_shared<Vector6d>(Vector6d::Zero());
+	object1->x() = 1.;
+	object2->y() = 0.5;
+	object2->z() = 0.5;
+	mass_eq.add("object1", object1);
+	mass_eq.add("object2", object2);
+	assert_msg("Step #2", isClose(mass_eq.compute(), expectedMass(*inertia, *jacobian, object2->head<3>().normalized())));
+	assert_msg("Step #2", mass_eq.compute() <= largest_mass * (1. + 1e-9));
+
+	// Step #3 : moving robot
+	robot_position->head<3>() << 0.4, 0.5, 0.5;
+	assert_msg("Step #3", isClose(mass_eq(), expectedMass(*inertia, *jacobian, (object2->head<3>() - robot_position->head<3>()).normalized())));
+
+	// Step #4 : updated inertia and Jacobian
+	*inertia *= 2.;
+	jacobian->setRandom();
+	assert_msg("Step #4", isClose(mass_eq(), expectedMass(*inertia, *jacobian, (object2->head<3>() - robot_position->head<3>()).normalized())));
+
+	// Step #5 : non positive definite inertia
+	*inertia = -MatrixXd::Identity(7, 7);
+	assert_msg("Step #5", std::isinf(mass_eq()));
+
+	return 0;
+}
@@ -0,0 +1,71 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+#include <iostream>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+
+	auto robot = make_shared<Robot>(
+		"rob",  // Robot's name
+		7);     // Robot's joint count
+
+	auto safety_controller = SafetyController(robot);
+
+	auto cloud = make_shared<PointCloud>();
+
+	// Step #1 : empty cloud
+	assert_msg("Step #1", cloud->size() == 0 and std::isinf(cloud->closestDistance(Vector3d::Zero())) and cloud->repulsiveForce(Vector3d::Zero(), 1., 1.).isZero());
+
+	// Step #2 : update swaps the buffers
+	Matrix3Xd points(3, 1000);
+	for (Eigen::Index i = 0; i < points.cols(); ++i) {
+		points.col(i) << 0.1 + 0.001 * (i % 10), 0.2 + 0.001 * ((i / 10) % 10), 0.3 + 0.001 * (i / 100);
+	}
+	Matrix3Xd reference = points;
+	cloud->update(points);
+	assert_msg("Step #2", cloud->size() == 1000 and points.cols() == 0 and cloud->points() == reference);
+
+	// Step #3 : closest distance
+	double expected_distance = reference.colwise().norm().minCoeff();
+	assert_msg("Step #3", std::abs(cloud->closestDistance(Vector3d::Zero()) - expected_distance) < 1e-12);
+
+	// Step #4 : repulsive force, compared to the potential field objects formula
+	Vector3d expected_force = Vector3d::Zero();
+	const double gain = 2., threshold = 0.375;
+	for (Eigen::Index i = 0; i < reference.cols(); ++i) {
+		double distance = reference.col(i).norm();
+		if(distance < threshold) {
+			expected_force += gain * (1./threshold - 1./distance) * reference.col(i) / distance;
+		}
+	}
+	assert_msg("Step #4", (cloud->repulsiveForce(Vector3d::Zero(), gain, threshold) - expected_force).norm() < 1e-9 and not expected_force.isZero());
+
+	// Step #5 : voxel downsampling, the 1000 points fit in 8 voxels
+	cloud->setVoxelSize(0.005);
+	points = reference;
+	cloud->update(points);
+	assert_msg("Step #5", cloud->size() == 8);
+	assert_msg("Step #5", std::abs(cloud->closestDistance(Vector3d::Zero()) - expected_distance) < std::sqrt(3.) * 0.005);
+
+	// Step #6 : potential field generator
+	auto potential_field_generator = make_shared<PotentialFieldGenerator>();
+	safety_controller.add("potential field", potential_field_generator);
+	potential_field_generator->setPointCloud(cloud, make_shared<double>(gain), make_shared<double>(0.5));
+	Vector6d force = potential_field_generator->compute();
+	assert_msg("Step #6", force.segment<3>(0).isApprox(cloud->repulsiveForce(Vector3d::Zero(), gain, 0.5)) and force.segment<3>(0).dot(reference.col(0)) < 0.);
+
+	// Step #7 : separation distance constraint
+	auto constant_vel = make_shared<double>(0.1);
+	auto separation_constraint = make_shared<SeparationDistanceConstraint>(
+		make_shared<VelocityConstraint>(constant_vel),
+		make_shared<LinearInterpolator>(make_shared<LinearPoint>(0.1, 0.), make_shared<LinearPoint>(0.5, 0.2)));
+	safety_controller.add("separation constraint", separation_constraint);
+	separation_constraint->setPointCloud(cloud);
+	separation_constraint->compute();
+	assert_msg("Step #7", *separation_constraint->getSeparationDistance() == cloud->closestDistance(Vector3d::Zero()));
+
+	return 0;
+}
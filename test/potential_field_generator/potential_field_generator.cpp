@@ -83,5 +83,61 @@ int main(int argc, char const *argv[]) {
 	safety_controller.compute();
 	assert_msg("Step #9", robot->controlPointVelocity()->translation().dot(tgt_pos->translation()) > 0.);
 
+	// Step #10 : many obstacles, only the close ones must contribute
+	potential_field_generator->removeAll();
+	std::vector<PotentialFieldObjectPtr> obstacles;
+	std::vector<PosePtr> obstacle_positions;
+	for (size_t i = 0; i < 1000; ++i) {
+		auto pos = make_shared<Pose>();
+		obstacle_positions.push_back(pos);
+		pos->translation() << 0.05 * (i % 10) - 0.187, 0.05 * ((i / 10) % 10) - 0.193, 0.05 * (i / 100) - 0.179;
+		obstacles.push_back(make_shared<PotentialFieldObject>(
+			PotentialFieldType::Repulsive,
+			make_shared<double>(1.),
+			make_shared<double>(i % 2 ? 0.1 : 0.15),
+			pos));
+		potential_field_generator->add("obstacle" + std::to_string(i), obstacles.back());
+	}
+
+	auto brute_force = [&obstacles]() {
+		Vector3d force = Vector3d::Zero();
+		for(const auto& obs: obstacles) {
+			Vector3d vec = obs->object_position->translation();
+			double distance = vec.norm();
+			if(distance > 1e-3 and distance < *obs->threshold_distance) {
+				force += *obs->gain * (1./ *obs->threshold_distance - 1./distance) * vec / distance;
+			}
+		}
+		return force;
+	};
+
+	// The first cycles use a linear pass, the following ones the grid built once the obstacles are static
+	Vector6d force;
+	for (size_t i = 0; i < 4; ++i) {
+		force = potential_field_generator->compute();
+		assert_msg("Step #10", (force.segment<3>(0) - brute_force()).norm() < 1e-9 and not force.segment<3>(0).isZero());
+	}
+
+	// Step #11 : moved obstacle
+	obstacle_positions[0]->translation() << 0.02, 0.01, 0.;
+	for (size_t i = 0; i < 4; ++i) {
+		force = potential_field_generator->compute();
+		assert_msg("Step #11", (force.segment<3>(0) - brute_force()).norm() < 1e-9);
+	}
+
+	// Step #12 : obstacles with a zero threshold distance are ignored
+	potential_field_generator->removeAll();
+	obs_pos->translation() << 0.1, 0., 0.;
+	potential_field_generator->add("obstacle", obstacle);
+	Vector6d single_obstacle_force = potential_field_generator->compute();
+	auto zero_threshold_obstacle = make_shared<PotentialFieldObject>(
+		PotentialFieldType::Repulsive,
+		make_shared<double>(10.),
+		make_shared<double>(0.),
+		make_shared<Pose>(Vector3d(0.05, 0., 0.), Eigen::Quaterniond::Identity()));
+	potential_field_generator->add("zero threshold obstacle", zero_threshold_obstacle);
+	force = potential_field_generator->compute();
+	assert_msg("Step #12", force.allFinite() and force.isApprox(single_obstacle_force));
+
 	return 0;
 }
@@ -0,0 +1,104 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+#include <iostream>
+#include <random>
+
+using namespace phri;
+using namespace std;
+
+double segmentDistance(const Vector3d& a, const Vector3d& b, double radius, const Vector3d& p) {
+	Vector3d ab = b - a;
+	double t = ab.squaredNorm() > 0. ? std::max(0., std::min(1., (p - a).dot(ab) / ab.squaredNorm())) : 0.;
+	return std::max(0., (a + t * ab - p).norm() - radius);
+}
+
+int main(int argc, char const *argv[]) {
+
+	auto robot = make_shared<Robot>(
+		"rob",  // Robot's name
+		7);     // Robot's joint count
+
+	auto safety_controller = SafetyController(robot);
+
+	auto link_positions = make_shared<Matrix3Xd>(3, 4);
+	*link_positions <<
+	    0., 0., 0.3, 0.6,
+	    0., 0., 0.,  0.,
+	    0., 0.4, 0.4, 0.4;
+
+	auto geometry = make_shared<RobotGeometry>(link_positions);
+
+	// Step #1 : invalid link
+	try {
+		geometry->addCapsule(0, 4, 0.1);
+		assert_msg("Step #1", false);
+	}
+	catch(std::out_of_range& err) {
+		std::cerr << "Expected exception: " << err.what() << std::endl;
+	}
+
+	geometry->addCapsule(0, 1, 0.1);
+	geometry->addCapsule(1, 2, 0.08);
+	geometry->addCapsule(2, 3, 0.05);
+	geometry->addSphere(3, 0.07);
+
+	// Step #2 : no points
+	assert_msg("Step #2", geometry->size() == 4 and std::isinf(geometry->distance(Matrix3Xd(3, 0))));
+
+	// Step #3 : random points, compared to a point by point computation
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<double> coordinate(-1., 1.);
+	for (size_t step = 0; step < 10; ++step) {
+		Matrix3Xd points(3, 100);
+		for (Eigen::Index i = 0; i < points.cols(); ++i) {
+			points.col(i) << coordinate(generator), coordinate(generator), coordinate(generator) + 1.;
+		}
+
+		double expected = std::numeric_limits<double>::infinity();
+		for (Eigen::Index i = 0; i < points.cols(); ++i) {
+			expected = std::min(expected, segmentDistance(link_positions->col(0), link_positions->col(1), 0.1, points.col(i)));
+			expected = std::min(expected, segmentDistance(link_positions->col(1), link_positions->col(2), 0.08, points.col(i)));
+			expected = std::min(expected, segmentDistance(link_positions->col(2), link_positions->col(3), 0.05, points.col(i)));
+			expected = std::min(expected, segmentDistance(link_positions->col(3), link_positions->col(3), 0.07, points.col(i)));
+		}
+		assert_msg("Step #3", std::abs(geometry->distance(points) - expected) < 1e-12);
+	}
+
+	// Step #4 : the bound is returned if no point is closer
+	Matrix3Xd far_point(3, 1);
+	far_point << 5., 5., 5.;
+	assert_msg("Step #4", geometry->distance(far_point, 0.5) == 0.5);
+
+	// Step #5 : point inside a capsule
+	Matrix3Xd inside_point(3, 1);
+	inside_point << 0.02, 0.01, 0.2;
+	assert_msg("Step #5", geometry->distance(inside_point) == 0. and geometry->closestCapsule() == 0);
+
+	// Step #6 : separation distance constraint using the geometry
+	auto constant_vel = make_shared<double>(0.1);
+	auto separation_constraint = make_shared<SeparationDistanceConstraint>(
+		make_shared<VelocityConstraint>(constant_vel),
+		make_shared<LinearInterpolator>(make_shared<LinearPoint>(0.1, 0.), make_shared<LinearPoint>(0.5, 0.2)));
+	safety_controller.add("separation constraint", separation_constraint);
+
+	auto obstacle = make_shared<Pose>();
+	obstacle->translation() << 0.45, 0., 0.7;
+	separation_constraint->add("obstacle", obstacle);
+	separation_constraint->compute();
+	assert_msg("Step #6", std::abs(*separation_constraint->getSeparationDistance() - obstacle->translation().norm()) < 1e-12);
+
+	separation_constraint->setRobotGeometry(geometry);
+	separation_constraint->compute();
+	assert_msg("Step #6", std::abs(*separation_constraint->getSeparationDistance() - 0.25) < 1e-12);
+
+	// Step #7 : moving links
+	link_positions->col(3) << 0.6, 0., 0.6;
+	separation_constraint->compute();
+	double expected = std::min(
+		segmentDistance(link_positions->col(2), link_positions->col(3), 0.05, obstacle->translation()),
+		segmentDistance(link_positions->col(3), link_positions->col(3), 0.07, obstacle->translation()));
+	assert_msg("Step #7", std::abs(*separation_constraint->getSeparationDistance() - expected) < 1e-12 and geometry->closestCapsule() == 3);
+
+	return 0;
+}
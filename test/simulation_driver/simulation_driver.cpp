@@ -0,0 +1,68 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+#include <OpenPHRI/drivers/simulation_driver.h>
+
+#include <chrono>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+
+	auto robot = make_shared<Robot>(
+		"rob",  // Robot's name
+		3);     // Robot's joint count
+
+	constexpr double sample_time = 0.001;
+
+	SimulationDriver driver(robot, sample_time, nullptr, true);
+
+	auto safety_controller = SafetyController(robot);
+	safety_controller.setVerbose(true);
+
+	auto constant_vel = make_shared<VectorXd>(3);
+	*constant_vel << 1., -1., 0.5;
+	safety_controller.add("vel proxy", make_shared<JointVelocityProxy>(constant_vel));
+
+	Vector6d contact_wrench;
+	contact_wrench << 0., 0., 10., 0., 0., 0.;
+	driver.addContact(0.5, 1., contact_wrench);
+
+	auto run = [&](size_t cycles) {
+				   for (size_t i = 0; i < cycles; ++i) {
+					   driver.read();
+					   safety_controller.compute();
+					   driver.send();
+				   }
+			   };
+
+	assert_msg("Step #1", driver.start());
+	assert_msg("Step #1", driver.init());
+
+	// Step #2 : the joint velocities are integrated
+	run(100);
+	assert_msg("Step #2", std::abs(*driver.getTime() - 0.1) < 1e-9);
+	assert_msg("Step #2", robot->jointCurrentPosition()->isApprox(*constant_vel * 0.1));
+
+	// Step #3 : scripted contact only active inside its time window
+	assert_msg("Step #3", robot->controlPointExternalForce()->isZero());
+	run(500);
+	assert_msg("Step #3", robot->controlPointExternalForce()->isApprox(contact_wrench));
+	run(500);
+	assert_msg("Step #3", robot->controlPointExternalForce()->isZero());
+
+	// Step #4 : wall pushing back the control point
+	driver.addWall(Vector3d::Zero(), Vector3d::UnitZ(), 1000.);
+	robot->controlPointCurrentPose()->translation() << 0., 0., -0.01;
+	driver.read();
+	assert_msg("Step #4", robot->controlPointExternalForce()->isApprox((Vector6d() << 0., 0., 10., 0., 0., 0.).finished()));
+
+	// Step #5 : free run mode much faster than real time
+	auto t_start = chrono::steady_clock::now();
+	run(100000);
+	auto t_end = chrono::steady_clock::now();
+	assert_msg("Step #5", chrono::duration<double>(t_end - t_start).count() < 100000 * sample_time);
+
+	return 0;
+}
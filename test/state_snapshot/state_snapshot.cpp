@@ -0,0 +1,184 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+
+#include <cstdio>
+#include <fstream>
+
+using namespace phri;
+using namespace std;
+
+struct Setup {
+	Setup() :
+		robot(make_shared<Robot>("rob", 7)),
+		controller(robot),
+		velocity(make_shared<Twist>()),
+		force_target(make_shared<Vector6d>(Vector6d::Zero())),
+		gain(make_shared<Vector6d>(Vector6d::Ones() * 0.01))
+	{
+		auto stop_constraint = make_shared<EmergencyStopConstraint>(
+			make_shared<double>(25.),
+			make_shared<double>(5.));
+		auto selection = make_shared<Vector6d>(Vector6d::Zero());
+		selection->x() = 1.;
+		auto force_control = make_shared<ForceControl>(force_target, 1e-3, gain, gain, selection);
+		force_control->configureFilter(1e-3, 0.1);
+
+		controller.add("stop constraint", stop_constraint);
+		controller.add("vel proxy", make_shared<VelocityProxy>(velocity));
+		controller.add("force control", force_control);
+		controller.add("force proxy", make_shared<ForceProxy>(robot->controlPointExternalForce()));
+	}
+
+	Vector6d step(double force) {
+		(*robot->controlPointExternalForce())(0) = force;
+		controller.compute();
+		return *robot->controlPointVelocity();
+	}
+
+	RobotPtr robot;
+	SafetyController controller;
+	TwistPtr velocity;
+	Vector6dPtr force_target;
+	Vector6dPtr gain;
+};
+
+double force(int i) {
+	// Goes above the activation threshold then back in the hysteresis band
+	return i < 50 ? i : 100 - i;
+}
+
+int main(int argc, char const *argv[]) {
+
+	Setup setup;
+	setup.velocity->translation().x() = 0.1;
+	*setup.force_target << 10, 0, 0, 0, 0, 0;
+
+	for (int i = 0; i < 40; ++i) {
+		setup.step(force(i));
+	}
+
+	// Step #1 : restoring a snapshot gives the same outputs
+	StateSnapshot snapshot;
+	{
+		auto writer = snapshot.writer();
+		setup.controller.saveState(writer);
+	}
+
+	std::vector<Vector6d> reference;
+	for (int i = 40; i < 80; ++i) {
+		reference.push_back(setup.step(force(i)));
+	}
+
+	{
+		auto reader = snapshot.reader();
+		setup.controller.restoreState(reader);
+		assert_msg("Step #1", reader.remaining() == 0);
+	}
+	for (int i = 40; i < 80; ++i) {
+		assert_msg("Step #1", setup.step(force(i)) == reference[i-40]);
+	}
+
+	// Step #2 : a snapshot can be restored in another controller with the same configuration
+	Setup other;
+	other.velocity->translation().x() = 0.1;
+	*other.force_target << 10, 0, 0, 0, 0, 0;
+	{
+		auto reader = snapshot.reader();
+		other.controller.restoreState(reader);
+	}
+	for (int i = 40; i < 80; ++i) {
+		assert_msg("Step #2", other.step(force(i)) == reference[i-40]);
+	}
+
+	// Step #3 : file round trip
+	const std::string file = "state_snapshot_test.bin";
+	assert_msg("Step #3", snapshot.save(file));
+	StateSnapshot loaded;
+	assert_msg("Step #3", loaded.load(file));
+	assert_msg("Step #3", loaded.data() == snapshot.data());
+
+	// Step #4 : corrupted and truncated files are rejected
+	{
+		std::fstream stream(file, std::ios::binary | std::ios::in | std::ios::out);
+		stream.seekp(-1, std::ios::end);
+		stream.put(0x55);
+	}
+	assert_msg("Step #4", not loaded.load(file));
+	{
+		std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+		stream.write(snapshot.data().data(), 10);
+	}
+	assert_msg("Step #4", not loaded.load(file));
+	std::remove(file.c_str());
+
+	// Step #5 : restoring in a controller with different items or robot throws
+	{
+		auto robot = make_shared<Robot>("rob", 7);
+		auto controller = SafetyController(robot);
+		controller.add("vel proxy", make_shared<VelocityProxy>(make_shared<Twist>()));
+		bool thrown = false;
+		try {
+			auto reader = snapshot.reader();
+			controller.restoreState(reader);
+		}
+		catch(std::exception&) {
+			thrown = true;
+		}
+		assert_msg("Step #5", thrown);
+	}
+	{
+		auto robot = make_shared<Robot>("rob", 6);
+		bool thrown = false;
+		try {
+			auto reader = snapshot.reader();
+			robot->restoreState(reader);
+		}
+		catch(std::length_error&) {
+			thrown = true;
+		}
+		assert_msg("Step #5", thrown);
+	}
+
+	// Step #6 : trajectory generators resume from the restored progress
+	auto start = TrajectoryPoint<double>(0., 0., 0.);
+	auto end = TrajectoryPoint<double>(1., 0., 0.);
+	auto trajectory = TrajectoryGenerator<double>(start, 1e-3);
+	trajectory.addPathTo(end, 1., 1.);
+	trajectory.computeTimings();
+	for (int i = 0; i < 500; ++i) {
+		trajectory.compute();
+	}
+	{
+		auto writer = snapshot.writer();
+		trajectory.saveState(writer);
+	}
+	std::vector<double> positions;
+	for (int i = 0; i < 500; ++i) {
+		trajectory.compute();
+		positions.push_back(*trajectory.getPositionOutput());
+	}
+	{
+		auto reader = snapshot.reader();
+		trajectory.restoreState(reader);
+	}
+	for (int i = 0; i < 500; ++i) {
+		trajectory.compute();
+		assert_msg("Step #6", *trajectory.getPositionOutput() == positions[i]);
+	}
+
+	// Step #7 : truncated data throws
+	{
+		StateReader reader(snapshot.data().data(), snapshot.data().size() / 2);
+		bool thrown = false;
+		try {
+			trajectory.restoreState(reader);
+		}
+		catch(std::out_of_range&) {
+			thrown = true;
+		}
+		assert_msg("Step #7", thrown);
+	}
+
+	return 0;
+}
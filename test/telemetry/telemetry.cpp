@@ -0,0 +1,139 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+
+#include <atomic>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+
+	auto time = make_shared<double>(0.);
+	Vector6d velocity = Vector6d::Zero();
+	VectorXd positions = VectorXd::Zero(50);
+
+	TelemetryPublisher publisher("/openphri_telemetry_test", time);
+	publisher.publishExternalData("velocity", velocity.data(), 6);
+	publisher.publishExternalData("positions", positions.data(), positions.size());
+
+	// Step #1 : the segment is created on the first publication
+	publisher.publish();
+	assert_msg("Step #1", publisher.signals().size() == 2);
+
+	TelemetryReader reader("openphri_telemetry_test");
+	assert_msg("Step #1", reader.signals().size() == 2);
+	assert_msg("Step #1", reader.rowSize() == 1 + 6 + 50);
+	assert_msg("Step #1", reader.signalIndex("positions") == 1);
+	assert_msg("Step #1", reader.signalIndex("unknown") == -1);
+
+	// Step #2 : the reader gets the last published values
+	*time = 2.;
+	velocity.setConstant(2.);
+	positions.setConstant(2.);
+	publisher.publish();
+
+	vector<double> row;
+	assert_msg("Step #2", reader.read(row) == 2);
+	assert_msg("Step #2", row[0] == 2.);
+	assert_msg("Step #2", reader.signal(row, 0).isApprox(Vector6d::Constant(2.)));
+	assert_msg("Step #2", reader.signal(row, 1).isApprox(VectorXd::Constant(50, 2.)));
+
+	// Step #3 : concurrent reads always get consistent snapshots
+	atomic<bool> stop(false);
+	size_t inconsistent_reads = 0;
+	atomic<size_t> reads(0);
+	thread monitor(
+		[&]() {
+			vector<double> snapshot;
+			while(not stop) {
+				reader.read(snapshot);
+				for(auto value: snapshot) {
+					if(value != snapshot[0]) {
+						++inconsistent_reads;
+						break;
+					}
+				}
+				++reads;
+			}
+		});
+
+	// Keep publishing until the monitor has started reading, whatever the scheduling
+	size_t cycle = 0;
+	for (; cycle < 100000 or reads == 0; ++cycle) {
+		*time = cycle;
+		velocity.setConstant(cycle);
+		positions.setConstant(cycle);
+		publisher.publish();
+	}
+	stop = true;
+	monitor.join();
+	assert_msg("Step #3", inconsistent_reads == 0);
+	assert_msg("Step #3", publisher.publishCount() == cycle + 2);
+
+	// Step #4 : no data can be added once the segment exists
+	bool thrown = false;
+	try {
+		publisher.publishExternalData("late", velocity.data(), 6);
+	}
+	catch(std::runtime_error&) {
+		thrown = true;
+	}
+	assert_msg("Step #4", thrown);
+
+	// Step #5 : reads don't wait forever for a publisher that stopped while writing
+	int fd = shm_open("/openphri_telemetry_test", O_RDWR, 0);
+	assert_msg("Step #5", fd >= 0);
+	auto header = static_cast<TelemetryHeader*>(mmap(nullptr, sizeof(TelemetryHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+	close(fd);
+	assert_msg("Step #5", header != MAP_FAILED);
+	header->sequence.fetch_add(1);
+	thrown = false;
+	try {
+		reader.read(row, 0.01);
+	}
+	catch(std::runtime_error&) {
+		thrown = true;
+	}
+	assert_msg("Step #5", thrown);
+	header->sequence.fetch_sub(1);
+	munmap(header, sizeof(TelemetryHeader));
+	assert_msg("Step #5", reader.read(row) == publisher.publishCount());
+
+	// Step #6 : an item removed and added back under the same name is published from its new storage
+	auto robot = make_shared<Robot>("rob", 7);
+	SafetyController controller(robot);
+	auto first_velocity = make_shared<Twist>();
+	first_velocity->translation().x() = 0.1;
+	auto second_velocity = make_shared<Twist>();
+	second_velocity->translation().x() = 0.2;
+	controller.add("vel proxy", make_shared<VelocityProxy>(first_velocity));
+
+	TelemetryPublisher controller_publisher("/openphri_telemetry_controller_test", time);
+	controller_publisher.publishSafetyControllerData(&controller);
+	controller.compute();
+	controller_publisher.publish();
+	TelemetryReader controller_reader("openphri_telemetry_controller_test");
+	int signal = controller_reader.signalIndex("vel proxy");
+	assert_msg("Step #6", signal >= 0);
+	controller_reader.read(row);
+	assert_msg("Step #6", controller_reader.signal(row, signal)(0) == 0.1);
+
+	// The item count is the same before and after
+	controller.removeVelocityGenerator("vel proxy");
+	controller.add("other proxy", make_shared<VelocityProxy>(first_velocity));
+	controller.add("vel proxy", make_shared<VelocityProxy>(second_velocity));
+	controller.removeVelocityGenerator("other proxy");
+	controller.compute();
+	controller_publisher.publish();
+	assert_msg("Step #6", not controller_reader.isReplaced());
+	controller_reader.read(row);
+	assert_msg("Step #6", controller_reader.signal(row, signal)(0) == 0.2);
+
+	return 0;
+}
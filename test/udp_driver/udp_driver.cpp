@@ -0,0 +1,77 @@
+#undef NDEBUG
+
+#include <OpenPHRI/OpenPHRI.h>
+#include <OpenPHRI/drivers/udp_driver.h>
+#include <OpenPHRI/drivers/udp_robot_server.h>
+
+using namespace phri;
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+
+	constexpr double sample_time = 0.001;
+	constexpr int port = 47891;
+
+	UDPRobotServer server(3, sample_time, port);
+	VectorXd init_position(3);
+	init_position << 0.1, 0.2, 0.3;
+	server.setJointPosition(init_position);
+	Vector6d external_force;
+	external_force << 1., 2., 3., 4., 5., 6.;
+	server.setExternalForce(external_force);
+	server.start();
+
+	auto robot = make_shared<Robot>(
+		"rob",  // Robot's name
+		3);     // Robot's joint count
+
+	UDPDriver driver(robot, sample_time, "127.0.0.1", port);
+
+	auto safety_controller = SafetyController(robot);
+	safety_controller.setVerbose(true);
+
+	auto constant_vel = make_shared<VectorXd>(3);
+	*constant_vel << 1., -1., 0.5;
+	safety_controller.add("vel proxy", make_shared<JointVelocityProxy>(constant_vel));
+
+	// Step #1 : connection and initial state
+	assert_msg("Step #1", driver.start());
+	assert_msg("Step #1", driver.init(1.));
+	assert_msg("Step #1", robot->jointCurrentPosition()->isApprox(init_position));
+	assert_msg("Step #1", robot->controlPointExternalForce()->isApprox(external_force));
+
+	auto run = [&](size_t cycles) {
+				   size_t failed_reads = 0;
+				   for (size_t i = 0; i < cycles; ++i) {
+					   if(not driver.read()) {
+						   ++failed_reads;
+					   }
+					   safety_controller.compute();
+					   driver.send();
+				   }
+				   return failed_reads;
+			   };
+
+	// Step #2 : the commands reach the server and are integrated
+	run(200);
+	assert_msg("Step #2", server.receivedCommands() > 100);
+	VectorXd motion = *robot->jointCurrentPosition() - init_position;
+	assert_msg("Step #2", (motion.array() * constant_vel->array()).minCoeff() > 0.);
+	assert_msg("Step #2", driver.statistics().round_trip_time > 0.);
+
+	// Step #3 : packet losses are detected and don't make read() fail with the default timeout
+	auto lost_packets = driver.statistics().lost_packets;
+	server.setStateDropPeriod(5);
+	assert_msg("Step #3", run(200) == 0);
+	assert_msg("Step #3", driver.statistics().lost_packets > lost_packets);
+	server.setStateDropPeriod(0);
+
+	// Step #4 : timeouts when the server stops
+	server.stop();
+	auto timeouts = driver.statistics().timeouts;
+	assert_msg("Step #4", run(3) == 3);
+	assert_msg("Step #4", driver.statistics().timeouts > timeouts);
+	assert_msg("Step #4", driver.statistics().invalid_packets == 0);
+
+	return 0;
+}